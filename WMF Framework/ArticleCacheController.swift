@@ -1,16 +1,77 @@
 import Foundation
+import CocoaLumberjackSwift
+import WMFComponents
+import WMFData
 
 public final class ArticleCacheController: CacheController {
     
-    init(moc: NSManagedObjectContext, imageCacheController: ImageCacheController, session: Session, configuration: Configuration, preferredLanguageDelegate: WMFPreferredLanguageInfoProvider) {
+    /// Full-text index of every article whose mobile-html is cached, so saved articles can be searched offline. Nil if the index file couldn't be opened.
+    public let offlineSearchIndex: WMFOfflineSearchIndex?
+    
+    // Stripping and indexing a large article takes a while, so it happens off the file writer's callbacks. Serial, so a removal can't overtake the add it follows.
+    let offlineSearchIndexingQueue = DispatchQueue(label: "org.wikimedia.wikipedia.articleCacheController.offlineSearchIndexing", qos: .utility)
+    
+    private let moc: NSManagedObjectContext
+    private let userDefaultsStore: WMFKeyValueStore?
+    
+    /// The index is built from saved articles rather than cached responses, so it lives outside the Permanent Cache directory. Clearing cached data leaves saved articles alone, and the index isn't counted in the cache size offered for clearing.
+    static let offlineSearchIndexURL: URL = {
+        var directoryURL = FileManager.default.wmf_containerURL().appendingPathComponent("Offline Search", isDirectory: true)
+        do {
+            try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+            var values = URLResourceValues()
+            values.isExcludedFromBackup = true
+            try directoryURL.setResourceValues(values)
+        } catch let error {
+            DDLogError("Error creating offline search index directory: \(error)")
+        }
+        return directoryURL.appendingPathComponent("OfflineSearch.sqlite", isDirectory: false)
+    }()
+    
+    static let offlineSearchBackfillDelay: DispatchTimeInterval = .seconds(30)
+    private static let offlineSearchBackfillBatchInterval: DispatchTimeInterval = .seconds(1)
+    private static let offlineSearchBackfillBatchSize = 10
+    
+    init(moc: NSManagedObjectContext, imageCacheController: ImageCacheController, session: Session, configuration: Configuration, preferredLanguageDelegate: WMFPreferredLanguageInfoProvider, offlineSearchIndexURL: URL = ArticleCacheController.offlineSearchIndexURL, userDefaultsStore: WMFKeyValueStore? = WMFDataEnvironment.current.userDefaultsStore) {
         let articleFetcher = ArticleFetcher(session: session, configuration: configuration)
         let imageInfoFetcher = MWKImageInfoFetcher(session: session, configuration: configuration)
         imageInfoFetcher.preferredLanguageDelegate = preferredLanguageDelegate
         let cacheFileWriter = CacheFileWriter(fetcher: articleFetcher)
         
+        let isNewOfflineSearchIndex = !FileManager.default.fileExists(atPath: offlineSearchIndexURL.path)
+        do {
+            offlineSearchIndex = try WMFOfflineSearchIndex(fileURL: offlineSearchIndexURL)
+        } catch let error {
+            DDLogError("Error opening offline search index: \(error)")
+            offlineSearchIndex = nil
+        }
+        
+        // A new index file is empty, whatever an earlier one had in it
+        if isNewOfflineSearchIndex && offlineSearchIndex != nil {
+            try? userDefaultsStore?.save(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue, value: false)
+        }
+        
+        self.moc = moc
+        self.userDefaultsStore = userDefaultsStore
         let articleDBWriter = ArticleCacheDBWriter(articleFetcher: articleFetcher, cacheBackgroundContext: moc, imageController: imageCacheController, imageInfoFetcher: imageInfoFetcher)
         super.init(dbWriter: articleDBWriter, fileWriter: cacheFileWriter)
     }
+    
+    override func finishFileSave(data: Data, mimeType: String?, uniqueKey: CacheController.UniqueKey, url: URL, groupKey: GroupKey) {
+        guard url.pathComponents.contains(ArticleFetcher.EndpointType.mobileHTML.rawValue) else {
+            return
+        }
+        
+        addToOfflineSearchIndex(mobileHTMLData: data, groupKey: groupKey)
+    }
+    
+    public override func remove(groupKey: GroupKey, individualCompletion: @escaping IndividualCompletionBlock, groupCompletion: @escaping GroupCompletionBlock) {
+        super.remove(groupKey: groupKey, individualCompletion: individualCompletion) { [weak self] (result) in
+            // Removed even if some files failed to delete, as callers treat the article as no longer available offline either way
+            self?.removeFromOfflineSearchIndex(groupKey: groupKey)
+            groupCompletion(result)
+        }
+    }
 
     enum ArticleCacheControllerError: Error {
         case invalidDBWriterType
@@ -46,7 +107,11 @@ public final class ArticleCacheController: CacheController {
                     
                     self.fileWriter.add(groupKey: groupKey, urlRequest: urlRequest) { (fileWriterResult) in
                         switch fileWriterResult {
-                        case .success(let response, _):
+                        case .success(let response, let data):
+                            
+                            if let url = urlRequest.url {
+                                self.finishFileSave(data: data, mimeType: response.mimeType, uniqueKey: uniqueKey, url: url, groupKey: groupKey)
+                            }
                             
                             self.dbWriter.markDownloaded(urlRequest: urlRequest, response: response) { (dbWriterResult) in
                             
@@ -124,4 +189,126 @@ public final class ArticleCacheController: CacheController {
             }
         }
     }
+    
+    // MARK: - Offline Search
+    
+    /// Articles are indexed as their mobile-html is cached, so articles saved before the index existed are missing from it. This indexes them from the files already on disk.
+    /// Runs once per index file, after a delay so it stays out of the way of launch, and a few articles at a time so it doesn't hold up articles being saved in the meantime. If the app quits first, it starts over on the next launch.
+    /// Completion is called on a background queue once every article has been indexed, or straight away if there's nothing to do.
+    func backfillOfflineSearchIndexIfNeeded(after delay: DispatchTimeInterval = ArticleCacheController.offlineSearchBackfillDelay, completion: (() -> Void)? = nil) {
+        let didBackfill: Bool = (try? userDefaultsStore?.load(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue)) ?? false
+        guard offlineSearchIndex != nil, !didBackfill else {
+            completion?()
+            return
+        }
+        
+        moc.perform {
+            let request = CacheItem.fetchRequest()
+            request.predicate = NSPredicate(format: "isDownloaded == YES && key CONTAINS %@", "/\(ArticleFetcher.EndpointType.mobileHTML.rawValue)/")
+            request.relationshipKeyPathsForPrefetching = ["cacheGroups"]
+            
+            let items: [CacheItem]
+            do {
+                items = try self.moc.fetch(request)
+            } catch let error {
+                DDLogError("Error fetching cached articles to backfill offline search index: \(error)")
+                completion?()
+                return
+            }
+            
+            var files: [(groupKey: GroupKey, fileName: String)] = []
+            for item in items {
+                guard let itemKey = item.key,
+                      let fileName = self.fileWriter.uniqueFileNameForItemKey(itemKey, variant: item.variant) else {
+                    continue
+                }
+                
+                for case let group as CacheGroup in item.cacheGroups ?? [] {
+                    if let groupKey = group.key {
+                        files.append((groupKey, fileName))
+                    }
+                }
+            }
+            
+            self.backfillOfflineSearchIndex(files: files[...], after: delay, completion: completion)
+        }
+    }
+    
+    private func backfillOfflineSearchIndex(files: ArraySlice<(groupKey: GroupKey, fileName: String)>, after delay: DispatchTimeInterval, completion: (() -> Void)?) {
+        offlineSearchIndexingQueue.asyncAfter(deadline: .now() + delay) { [weak self] in
+            guard let self else {
+                completion?()
+                return
+            }
+            
+            guard !files.isEmpty else {
+                try? self.userDefaultsStore?.save(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue, value: true)
+                completion?()
+                return
+            }
+            
+            for file in files.prefix(Self.offlineSearchBackfillBatchSize) {
+                // A missing file means the article was removed after the fetch above. Otherwise, a removal still to come is queued behind this batch and undoes the add.
+                guard let data = try? Data(contentsOf: CacheFileWriterHelper.fileURL(for: file.fileName)) else {
+                    continue
+                }
+                self.indexMobileHTML(data: data, groupKey: file.groupKey)
+            }
+            
+            self.backfillOfflineSearchIndex(files: files.dropFirst(Self.offlineSearchBackfillBatchSize), after: Self.offlineSearchBackfillBatchInterval, completion: completion)
+        }
+    }
+    
+    private func addToOfflineSearchIndex(mobileHTMLData: Data, groupKey: GroupKey) {
+        offlineSearchIndexingQueue.async {
+            self.indexMobileHTML(data: mobileHTMLData, groupKey: groupKey)
+        }
+    }
+    
+    // groupKey is the article's key, its desktop URL. Called on offlineSearchIndexingQueue.
+    private func indexMobileHTML(data: Data, groupKey: GroupKey) {
+        guard let offlineSearchIndex,
+              let articleURL = URL(string: groupKey),
+              let title = articleURL.wmf_title,
+              let languageCode = articleURL.wmf_languageCode,
+              let html = String(data: data, encoding: .utf8) else {
+            return
+        }
+        
+        let document = WMFOfflineSearchIndex.Document(key: groupKey, languageCode: languageCode, title: title, text: Self.searchableText(fromMobileHTML: html))
+        do {
+            try offlineSearchIndex.add(document)
+        } catch let error {
+            DDLogError("Error adding \(groupKey) to offline search index: \(error)")
+        }
+    }
+    
+    private func removeFromOfflineSearchIndex(groupKey: GroupKey) {
+        guard let offlineSearchIndex else {
+            return
+        }
+        
+        offlineSearchIndexingQueue.async {
+            do {
+                try offlineSearchIndex.remove(key: groupKey)
+            } catch let error {
+                DDLogError("Error removing \(groupKey) from offline search index: \(error)")
+            }
+        }
+    }
+    
+    /// Plain text of the article body, with whitespace collapsed so snippets read as prose. The head is skipped so page metadata doesn't match searches.
+    static func searchableText(fromMobileHTML html: String) -> String {
+        var body = html[...]
+        if let bodyStart = html.range(of: "<body"),
+           let bodyEnd = html.range(of: "</body>", options: .backwards, range: bodyStart.upperBound..<html.endIndex) {
+            body = html[bodyStart.lowerBound..<bodyEnd.upperBound]
+        }
+        
+        guard let text = try? HtmlUtils.stringFromHTML(String(body)) else {
+            return ""
+        }
+        
+        return text.split(whereSeparator: \.isWhitespace).joined(separator: " ")
+    }
 }
@@ -137,4 +137,9 @@ class ArticleSummaryContentURLs: NSObject, Codable {
 class ArticleSummaryCoordinates: NSObject, Codable {
     @objc let lat: Double
     @objc let lon: Double
+    
+    internal init(lat: Double, lon: Double) {
+        self.lat = lat
+        self.lon = lon
+    }
 }
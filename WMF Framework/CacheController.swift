@@ -252,7 +252,7 @@ public class CacheController {
                             self.gatekeeper.runAndRemoveIndividualCompletions(uniqueKey: uniqueKey, individualResult: individualResult)
                         }
 
-                        self.finishFileSave(data: data, mimeType: response.mimeType, uniqueKey: uniqueKey, url: url)
+                        self.finishFileSave(data: data, mimeType: response.mimeType, uniqueKey: uniqueKey, url: url, groupKey: groupKey)
 
                     case .failure(let error):
 
@@ -283,7 +283,7 @@ public class CacheController {
         }
     }
     
-    func finishFileSave(data: Data, mimeType: String?, uniqueKey: CacheController.UniqueKey, url: URL) {
+    func finishFileSave(data: Data, mimeType: String?, uniqueKey: CacheController.UniqueKey, url: URL, groupKey: GroupKey) {
         // hook to allow subclasses to do any additional work with data
     }
     
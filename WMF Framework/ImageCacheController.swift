@@ -54,7 +54,7 @@ public final class ImageCacheController: CacheController {
     private var dataCompletionManager = ImageControllerCompletionManager<ImageControllerDataCompletion>()
     
     // called when saving an image to persistent cache has completed. Hook here to allow additional saving into memoryCache.
-    override func finishFileSave(data: Data, mimeType: String?, uniqueKey: CacheController.UniqueKey, url: URL) {
+    override func finishFileSave(data: Data, mimeType: String?, uniqueKey: CacheController.UniqueKey, url: URL, groupKey: GroupKey) {
         
         guard let image = self.createImage(data: data, mimeType: mimeType) else {
             return
@@ -18,6 +18,7 @@ public final class PermanentCacheController: NSObject {
         managedObjectContext = moc
         super.init()
         session.permanentCache = self
+        articleCache.backfillOfflineSearchIndexIfNeeded()
     }
     
     /// Performs any necessary migrations on the CacheController's internal storage
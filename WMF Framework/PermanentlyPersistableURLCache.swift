@@ -133,6 +133,12 @@ extension PermanentlyPersistableURLCache {
         
         return CacheDBWriterHelper.isCached(itemKey: itemKey, variant: variant, in: moc, completion: completion)
     }
+    
+    // Returns the response persisted for exactly this request's url and type, if any. Unlike cachedResponse(for:), this skips URLCache.shared and fallback variants, so a hit means the item was saved for offline reading.
+    // Reads from disk, so avoid calling on the main thread.
+    func persistedResponse(for urlRequest: URLRequest) -> CachedURLResponse? {
+        return persistedResponseWithURLRequest(urlRequest)
+    }
 }
 
 // MARK: Private - URLRequest header creation
@@ -1,10 +1,13 @@
 import Foundation
+import CryptoKit
+import CocoaLumberjackSwift
 
 @objc public class SharedContainerCacheCommonNames: NSObject {
     @objc public static let pushNotificationsCache = "Push Notifications Cache"
     @objc public static let talkPageCache = "Talk Page Cache"
     public static let widgetCache = "Widget Cache"
     @objc public static let didYouKnowCache = "Did You Know Cache"
+    @objc public static let diffCache = "Diff Cache"
 }
 
 public final class SharedContainerCache: SharedContainerCacheHousekeepingProtocol {
@@ -51,33 +54,437 @@ public final class SharedContainerCache: SharedContainerCacheHousekeepingProtoco
 
         }
 
-        try? encodedCache.write(to: cacheDataFileURL)
+        // Atomic, so a widget or extension reading at the same time never sees a partially written file
+        guard (try? encodedCache.write(to: cacheDataFileURL, options: .atomic)) != nil else {
+            return
+        }
+
+        if let subdirectoryURL = subdirectoryURL() {
+            SharedContainerCacheRecencyLog(directoryURL: subdirectoryURL).recordSave(ofFileNamed: cacheDataFileURL.lastPathComponent)
+        }
     }
     
     public func removeCache() throws {
         try FileManager.default.removeItem(at: cacheDataFileURL)
     }
 
+    private static let cleanupQueue = DispatchQueue(label: "org.wikimedia.wikipedia.sharedContainerCacheCleanup", qos: .utility)
+    static let cleanupTimeBudget: TimeInterval = 0.5
+    static let cleanupBatchSize = 50
+
     /// Persist only the last 50 visited talk pages
+    /// Runs in the background. Stale files are found from the subdirectory's recency log rather than by listing and sorting the directory, and are deleted in batches until `cleanupTimeBudget` runs out. Files left over are deleted by the next cleanup.
     @objc public static func deleteStaleCachedItems(in subdirectoryPathComponent: String, cleanupLevel: WMFCleanupLevel) {
-        let folderURL = cacheDirectoryContainerURL.appendingPathComponent(subdirectoryPathComponent)
-
-        if let urlArray = try? FileManager.default.contentsOfDirectory(at: folderURL,
-                                                                       includingPropertiesForKeys: [.contentModificationDateKey],
-                                                                       options: .skipsHiddenFiles) {
-            let maxCacheSize = cleanupLevel == .high ? 0 : 50
-            if urlArray.count > maxCacheSize {
-                let sortedArray =  urlArray.map { url in
-                    (url, (try? url.resourceValues(forKeys: [.contentModificationDateKey]))?.contentModificationDate ?? Date.distantPast)
-                }.sorted(by: {$0.1 > $1.1 })
-                    .map { $0.0 }
-
-                let itemsToDelete = Array(sortedArray.suffix(from: maxCacheSize))
-                for urlItem in itemsToDelete {
-                    try? FileManager.default.removeItem(at: urlItem)
+        let folderURL = cacheDirectoryContainerURL.appendingPathComponent(subdirectoryPathComponent, isDirectory: true)
+        let maxCacheSize = cleanupLevel == .high ? 0 : 50
+
+        cleanupQueue.async {
+            let startDate = Date()
+
+            guard maxCacheSize > 0 else {
+                try? FileManager.default.removeItem(at: folderURL)
+                DDLogDebug("Cleared \(subdirectoryPathComponent) in \(String(format: "%.3f", Date().timeIntervalSince(startDate)))s")
+                return
+            }
+
+            let log = SharedContainerCacheRecencyLog(directoryURL: folderURL)
+            let staleFileNames = log.removeStaleFileNames(keepingMostRecent: maxCacheSize)
+            var deletedCount = 0
+            var remainingFileNames: [String] = []
+
+            for (index, fileName) in staleFileNames.enumerated() {
+                // The budget is checked between batches rather than per file
+                if index % cleanupBatchSize == 0 && Date().timeIntervalSince(startDate) > cleanupTimeBudget {
+                    remainingFileNames = Array(staleFileNames[index...])
+                    break
+                }
+
+                let fileURL = folderURL.appendingPathComponent(fileName)
+                // A file saved again since the log was read is no longer stale
+                if let modificationDate = (try? fileURL.resourceValues(forKeys: [.contentModificationDateKey]))?.contentModificationDate, modificationDate >= startDate {
+                    continue
+                }
+                if (try? FileManager.default.removeItem(at: fileURL)) != nil {
+                    deletedCount += 1
+                }
+            }
+
+            if !remainingFileNames.isEmpty {
+                log.restoreStaleFileNames(remainingFileNames)
+            }
+
+            DDLogDebug("Deleted \(deletedCount) of \(staleFileNames.count) stale items from \(subdirectoryPathComponent) in \(String(format: "%.3f", Date().timeIntervalSince(startDate)))s, \(remainingFileNames.count) left for the next cleanup")
+        }
+    }
+}
+
+/// Recency index for a `SharedContainerCache` subdirectory: a hidden log of the names of saved files, one per line, oldest first.
+/// A name's last line is its most recent save, so cleanup finds stale files by reading the log instead of listing the directory and reading every file's modification date. Saves append a line, and the log is compacted to one line per file whenever cleanup runs or it grows past `maxUncompactedLength`.
+/// All access is coordinated with `NSFileCoordinator`, as the app and its extensions save to the same subdirectories.
+struct SharedContainerCacheRecencyLog {
+
+    static let fileName = ".recency"
+    static let maxUncompactedLength = 256 * 1024
+
+    private let directoryURL: URL
+    private let url: URL
+
+    init(directoryURL: URL) {
+        self.directoryURL = directoryURL
+        self.url = directoryURL.appendingPathComponent(Self.fileName)
+    }
+
+    func recordSave(ofFileNamed fileName: String) {
+        guard !fileName.contains("\n") else {
+            return
+        }
+
+        coordinateWriting { url in
+            guard let fileHandle = try? FileHandle(forWritingTo: url) else {
+                // First save since the log was added or the directory was cleared
+                write(fileNamesFromDirectory(), to: url)
+                return
+            }
+            defer {
+                try? fileHandle.close()
+            }
+            do {
+                let length = try fileHandle.seekToEnd()
+                try fileHandle.write(contentsOf: Data((fileName + "\n").utf8))
+                if length > Self.maxUncompactedLength {
+                    write(uniqueFileNames(from: readFileNames(at: url) ?? []), to: url)
+                }
+            } catch let error {
+                DDLogError("Error appending to shared container cache recency log: \(error)")
+            }
+        }
+    }
+
+    /// Drops all but the `count` most recently saved names from the log and returns the dropped names, oldest first
+    func removeStaleFileNames(keepingMostRecent count: Int) -> [String] {
+        var staleFileNames: [String] = []
+        coordinateWriting { url in
+            let fileNames = uniqueFileNames(from: readFileNames(at: url) ?? fileNamesFromDirectory())
+            guard fileNames.count > count else {
+                if !fileNames.isEmpty {
+                    write(fileNames, to: url)
                 }
+                return
+            }
+            let staleCount = fileNames.count - count
+            staleFileNames = Array(fileNames.prefix(staleCount))
+            write(Array(fileNames.suffix(count)), to: url)
+        }
+        return staleFileNames
+    }
+
+    /// Puts names cleanup didn't get to back at the start of the log, as the least recently saved
+    func restoreStaleFileNames(_ staleFileNames: [String]) {
+        coordinateWriting { url in
+            write(uniqueFileNames(from: staleFileNames + (readFileNames(at: url) ?? [])), to: url)
+        }
+    }
+
+    // MARK: - Private
+
+    private func coordinateWriting(_ accessor: (URL) -> Void) {
+        var coordinationError: NSError?
+        NSFileCoordinator(filePresenter: nil).coordinate(writingItemAt: url, options: [], error: &coordinationError, byAccessor: accessor)
+        if let coordinationError = coordinationError {
+            DDLogError("Error coordinating shared container cache recency log: \(coordinationError)")
+        }
+    }
+
+    /// Mapped rather than read, so a long log isn't copied into memory before it is split
+    private func readFileNames(at url: URL) -> [String]? {
+        guard let data = try? Data(contentsOf: url, options: .alwaysMapped) else {
+            return nil
+        }
+        return data.split(separator: UInt8(ascii: "\n")).compactMap { String(bytes: $0, encoding: .utf8) }
+    }
+
+    /// Keeps only the last occurrence of each name, preserving order
+    private func uniqueFileNames(from fileNames: [String]) -> [String] {
+        var seenFileNames = Set<String>()
+        var uniqueFileNamesNewestFirst: [String] = []
+        uniqueFileNamesNewestFirst.reserveCapacity(fileNames.count)
+        for fileName in fileNames.reversed() where seenFileNames.insert(fileName).inserted {
+            uniqueFileNamesNewestFirst.append(fileName)
+        }
+        return uniqueFileNamesNewestFirst.reversed()
+    }
+
+    /// Seeds a missing log from the directory, ordered by modification date
+    private func fileNamesFromDirectory() -> [String] {
+        guard let fileURLs = try? FileManager.default.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: [.contentModificationDateKey], options: .skipsHiddenFiles) else {
+            return []
+        }
+        return fileURLs
+            .map { ($0.lastPathComponent, (try? $0.resourceValues(forKeys: [.contentModificationDateKey]))?.contentModificationDate ?? Date.distantPast) }
+            .sorted { $0.1 < $1.1 }
+            .map { $0.0 }
+            .filter { !$0.contains("\n") }
+    }
+
+    private func write(_ fileNames: [String], to url: URL) {
+        let data = Data(fileNames.map { $0 + "\n" }.joined().utf8)
+        do {
+            try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+            try data.write(to: url, options: .atomic)
+        } catch let error {
+            DDLogError("Error writing shared container cache recency log: \(error)")
+        }
+    }
+}
+
+/// A key-value variant of `SharedContainerCache` for caches that are read and written a piece at a time.
+/// Each value is stored in its own binary property list record, so loading or saving one key doesn't decode or rewrite the others. A small index beside the records holds each key's last access date for LRU trimming.
+/// Records are written atomically and the index is only changed under `NSFileCoordinator`, so the app and its extensions can share a cache.
+public final class SharedContainerShardedCache {
+
+    private struct Record<Value: Codable>: Codable {
+        let key: String
+        let value: Value
+    }
+
+    /// Decodes only the key of a record, for rebuilding a missing index
+    private struct RecordHeader: Decodable {
+        let key: String
+    }
+
+    private struct IndexEntry: Codable {
+        let fileName: String
+        var lastAccessDate: Date
+    }
+
+    private static let indexFileName = "index.plist"
+    private static let recordPathExtension = "record"
+
+    /// Reads only update the index when a key's last recorded access is older than this, so frequent reads like widget timeline reloads rarely write
+    static let accessDateGranularity: TimeInterval = 60 * 60
+
+    private let directoryURL: URL
+    private let maxEntryCount: Int?
+
+    private let lock = NSLock()
+    private var lastAccessDates: [String: Date] = [:]
+
+    /// - Parameters:
+    ///   - name: Name of the cache's directory in the shared container
+    ///   - maxEntryCount: If set, the least recently used records are trimmed after each save to stay within this count
+    public convenience init(name: String, maxEntryCount: Int? = nil) {
+        self.init(directoryURL: FileManager.default.wmf_containerURL().appendingPathComponent(name, isDirectory: true), maxEntryCount: maxEntryCount)
+    }
+
+    init(directoryURL: URL, maxEntryCount: Int? = nil) {
+        self.directoryURL = directoryURL
+        self.maxEntryCount = maxEntryCount
+    }
+
+    private var indexURL: URL {
+        return directoryURL.appendingPathComponent(Self.indexFileName)
+    }
+
+    private static func recordFileName(forKey key: String) -> String {
+        // Hashed so any key makes a valid, fixed length file name, and so reads can find a record without the index
+        let digest = SHA256.hash(data: Data(key.utf8))
+        return digest.map { String(format: "%02x", $0) }.joined() + "." + recordPathExtension
+    }
+
+    // MARK: - Values
+
+    public func value<T: Codable>(forKey key: String) -> T? {
+        let recordURL = directoryURL.appendingPathComponent(Self.recordFileName(forKey: key))
+        guard let data = try? Data(contentsOf: recordURL),
+              let record = try? PropertyListDecoder().decode(Record<T>.self, from: data),
+              record.key == key else {
+            return nil
+        }
+        recordAccess(forKey: key)
+        return record.value
+    }
+
+    public func setValue<T: Codable>(_ value: T, forKey key: String) {
+        let encoder = PropertyListEncoder()
+        encoder.outputFormat = .binary
+        let fileName = Self.recordFileName(forKey: key)
+        do {
+            let data = try encoder.encode(Record(key: key, value: value))
+            try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+            try data.write(to: directoryURL.appendingPathComponent(fileName), options: .atomic)
+        } catch let error {
+            DDLogError("Error saving shared container cache record for \(key): \(error)")
+            return
+        }
+
+        let now = Date()
+        lock.lock()
+        lastAccessDates[key] = now
+        lock.unlock()
+
+        updateIndex { index in
+            index[key] = IndexEntry(fileName: fileName, lastAccessDate: now)
+            if let maxEntryCount = maxEntryCount {
+                trim(&index, toCount: maxEntryCount)
+            }
+            return true
+        }
+    }
+
+    public func removeValue(forKey key: String) {
+        updateIndex { index in
+            try? FileManager.default.removeItem(at: directoryURL.appendingPathComponent(Self.recordFileName(forKey: key)))
+            return index.removeValue(forKey: key) != nil
+        }
+    }
+
+    public func removeAll() {
+        var coordinationError: NSError?
+        NSFileCoordinator(filePresenter: nil).coordinate(writingItemAt: directoryURL, options: .forDeleting, error: &coordinationError) { url in
+            try? FileManager.default.removeItem(at: url)
+        }
+        if let coordinationError = coordinationError {
+            DDLogError("Error coordinating removal of shared container cache: \(coordinationError)")
+        }
+    }
+
+    /// Keys with a saved value, most recently used first
+    public var keys: [String] {
+        var keys: [String] = []
+        var coordinationError: NSError?
+        NSFileCoordinator(filePresenter: nil).coordinate(readingItemAt: indexURL, options: [], error: &coordinationError) { url in
+            keys = loadIndex(at: url)
+                .sorted { $0.value.lastAccessDate > $1.value.lastAccessDate }
+                .map { $0.key }
+        }
+        return keys
+    }
+
+    /// Removes the least recently used records until at most `count` remain
+    public func trim(toCount count: Int) {
+        updateIndex { index in
+            trim(&index, toCount: count)
+        }
+    }
+
+    // MARK: - Index
+
+    private func recordAccess(forKey key: String) {
+        let now = Date()
+        lock.lock()
+        let lastAccessDate = lastAccessDates[key]
+        let isStale = lastAccessDate.map { now.timeIntervalSince($0) > Self.accessDateGranularity } ?? true
+        if isStale {
+            lastAccessDates[key] = now
+        }
+        lock.unlock()
+
+        guard isStale else {
+            return
+        }
+
+        // Another process may have recorded a recent access already. Check under a coordinated read first, so the common case doesn't take a write.
+        var isIndexStale = true
+        var coordinationError: NSError?
+        NSFileCoordinator(filePresenter: nil).coordinate(readingItemAt: indexURL, options: [], error: &coordinationError) { url in
+            isIndexStale = !hasRecentAccess(forKey: key, in: loadIndex(at: url), asOf: now)
+        }
+        guard isIndexStale else {
+            return
+        }
+
+        let fileName = Self.recordFileName(forKey: key)
+        updateIndex { index in
+            // Checked again, as the index may have changed between the read and the write
+            guard !hasRecentAccess(forKey: key, in: index, asOf: now) else {
+                return false
+            }
+            index[key] = IndexEntry(fileName: fileName, lastAccessDate: now)
+            return true
+        }
+    }
+
+    private func hasRecentAccess(forKey key: String, in index: [String: IndexEntry], asOf date: Date) -> Bool {
+        guard let entry = index[key] else {
+            return false
+        }
+        return date.timeIntervalSince(entry.lastAccessDate) <= Self.accessDateGranularity
+    }
+
+    /// Returns whether anything was removed
+    @discardableResult
+    private func trim(_ index: inout [String: IndexEntry], toCount count: Int) -> Bool {
+        guard index.count > count else {
+            return false
+        }
+        let keysToRemove = index
+            .sorted { $0.value.lastAccessDate > $1.value.lastAccessDate }
+            .suffix(from: max(0, count))
+            .map { $0.key }
+        for key in keysToRemove {
+            guard let entry = index.removeValue(forKey: key) else {
+                continue
+            }
+            try? FileManager.default.removeItem(at: directoryURL.appendingPathComponent(entry.fileName))
+        }
+        return true
+    }
+
+    /// Reads, changes and atomically rewrites the index while holding a coordinated write on it, so concurrent updates from other processes aren't lost
+    /// `update` returns whether it changed the index. The index is only rewritten if it did, or if it had to be rebuilt from the records.
+    private func updateIndex(_ update: (inout [String: IndexEntry]) -> Bool) {
+        var coordinationError: NSError?
+        NSFileCoordinator(filePresenter: nil).coordinate(writingItemAt: indexURL, options: .forReplacing, error: &coordinationError) { url in
+            let storedIndex = storedIndex(at: url)
+            var index = storedIndex ?? rebuiltIndex()
+            let wasRebuilt = storedIndex == nil && !index.isEmpty
+            guard update(&index) || wasRebuilt else {
+                return
+            }
+
+            let encoder = PropertyListEncoder()
+            encoder.outputFormat = .binary
+            do {
+                let data = try encoder.encode(index)
+                try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+                try data.write(to: url, options: .atomic)
+            } catch let error {
+                DDLogError("Error saving shared container cache index: \(error)")
+            }
+        }
+        if let coordinationError = coordinationError {
+            DDLogError("Error coordinating shared container cache index update: \(coordinationError)")
+        }
+    }
+
+    private func loadIndex(at url: URL) -> [String: IndexEntry] {
+        return storedIndex(at: url) ?? rebuiltIndex()
+    }
+
+    /// The index as saved, or nil if it is missing or unreadable
+    private func storedIndex(at url: URL) -> [String: IndexEntry]? {
+        guard let data = try? Data(contentsOf: url) else {
+            return nil
+        }
+        return try? PropertyListDecoder().decode([String: IndexEntry].self, from: data)
+    }
+
+    /// Recreates the index from the records on disk if it is missing or unreadable, using file modification dates for recency
+    private func rebuiltIndex() -> [String: IndexEntry] {
+        guard let recordURLs = try? FileManager.default.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: [.contentModificationDateKey], options: .skipsHiddenFiles) else {
+            return [:]
+        }
+        var index: [String: IndexEntry] = [:]
+        for recordURL in recordURLs where recordURL.pathExtension == Self.recordPathExtension {
+            guard let data = try? Data(contentsOf: recordURL),
+                  let header = try? PropertyListDecoder().decode(RecordHeader.self, from: data) else {
+                try? FileManager.default.removeItem(at: recordURL)
+                continue
             }
+            let modificationDate = (try? recordURL.resourceValues(forKeys: [.contentModificationDateKey]))?.contentModificationDate ?? Date.distantPast
+            index[header.key] = IndexEntry(fileName: recordURL.lastPathComponent, lastAccessDate: modificationDate)
         }
+        return index
     }
 }
 
@@ -87,9 +494,6 @@ public final class SharedContainerCache: SharedContainerCacheHousekeepingProtoco
 
 @objc public class SharedContainerCacheClearFeaturedArticleWrapper: NSObject {
     @objc public static func clearOutFeaturedArticleWidgetCache() {
-        let sharedCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
-        var updatedCache = sharedCache.loadCache() ?? WidgetCache(settings: .default, featuredContent: nil)
-        updatedCache.featuredContent = nil
-        sharedCache.saveCache(updatedCache)
+        WidgetCache.saveFeaturedContent(nil)
     }
 }
@@ -63,6 +63,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)updateWithSearchResult:(nullable MWKSearchResult *)searchResult;
 
+- (void)updateWithFeedPreview:(nullable WMFFeedArticlePreview *)feedPreview pageViews:(nullable NSDictionary<NSDate *, NSNumber *> *)pageViews isFeatured:(BOOL)isFeatured;
+
 @end
 
 @interface NSManagedObjectContext (WMFArticle)
@@ -86,6 +88,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable WMFArticle *)fetchOrCreateArticleWithURL:(nullable NSURL *)articleURL updatedWithFeedPreview:(nullable WMFFeedArticlePreview *)feedPreview pageViews:(nullable NSDictionary<NSDate *, NSNumber *> *)pageViews isFeatured:(BOOL)isFeatured;
 
+// Upserts the articles for a batch of feed previews, such as everything in a feed day, with one fetch instead of one per preview.
+// Each article is updated from its preview with its entry in pageViews, and featuredPreview is updated as a featured article. Previews without an article URL are skipped.
+- (NSDictionary<WMFInMemoryURLKey *, WMFArticle *> *)fetchOrCreateArticlesWithFeedPreviews:(NSArray<WMFFeedArticlePreview *> *)feedPreviews pageViews:(nullable NSDictionary<NSURL *, NSDictionary<NSDate *, NSNumber *> *> *)pageViews featuredPreview:(nullable WMFFeedArticlePreview *)featuredPreview;
+
 - (nullable WMFArticle *)fetchArticleWithWikidataID:(nullable NSString *)wikidataID;
 
 @end
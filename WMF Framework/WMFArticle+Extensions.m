@@ -1,5 +1,6 @@
 #import <WMF/WMFArticle+Extensions.h>
 #import <WMF/NSURL+WMFLinkParsing.h>
+#import <WMF/WMFLogging.h>
 #import <WMF/WMF-Swift.h>
 
 @import WMFData;
@@ -151,6 +152,48 @@
     }
 }
 
+- (void)updateWithFeedPreview:(nullable WMFFeedArticlePreview *)feedPreview pageViews:(nullable NSDictionary<NSDate *, NSNumber *> *)pageViews isFeatured:(BOOL)isFeatured {
+    if (isFeatured) {
+        WMFFeedArticlePreview *oldFeedPreview = [self feedArticlePreview];
+        if (![oldFeedPreview isEqual:feedPreview]) {
+            [SharedContainerCacheClearFeaturedArticleWrapper clearOutFeaturedArticleWidgetCache];
+        }
+    }
+    
+    if ([feedPreview.displayTitleHTML length] > 0) {
+        self.displayTitleHTML = feedPreview.displayTitleHTML;
+    } else if ([feedPreview.displayTitle length] > 0) {
+        self.displayTitleHTML = feedPreview.displayTitle;
+    }
+    
+    if ([feedPreview.wikidataDescription length] > 0) {
+        self.wikidataDescription = feedPreview.wikidataDescription;
+    }
+    if ([feedPreview.snippet length] > 0) {
+        self.snippet = feedPreview.snippet;
+    }
+    if (feedPreview.thumbnailURL != nil) {
+
+        self.thumbnailURL = feedPreview.thumbnailURL;
+    }
+    if (pageViews != nil) {
+        if (self.pageViews == nil) {
+            self.pageViews = pageViews;
+        } else {
+            self.pageViews = [self.pageViews mtl_dictionaryByAddingEntriesFromDictionary:pageViews];
+        }
+    }
+    if (feedPreview.imageURLString != nil) {
+        self.imageURLString = feedPreview.imageURLString;
+    }
+    if (feedPreview.imageWidth != nil) {
+        self.imageWidth = feedPreview.imageWidth;
+    }
+    if (feedPreview.imageHeight != nil) {
+        self.imageHeight = feedPreview.imageHeight;
+    }
+}
+
 @end
 
 #pragma mark - NSManagedObjectContext Extensions
@@ -257,48 +300,60 @@
     }
 
     WMFArticle *article = [self fetchOrCreateArticleWithURL:articleURL];
-    
-    if (isFeatured) {
-        WMFFeedArticlePreview *oldFeedPreview = [article feedArticlePreview];
-        if (![oldFeedPreview isEqual:feedPreview]) {
-            [SharedContainerCacheClearFeaturedArticleWrapper clearOutFeaturedArticleWidgetCache];
+    [article updateWithFeedPreview:feedPreview pageViews:pageViews isFeatured:isFeatured];
+    return article;
+}
+
+- (NSDictionary<WMFInMemoryURLKey *, WMFArticle *> *)fetchOrCreateArticlesWithFeedPreviews:(NSArray<WMFFeedArticlePreview *> *)feedPreviews pageViews:(nullable NSDictionary<NSURL *, NSDictionary<NSDate *, NSNumber *> *> *)pageViews featuredPreview:(nullable WMFFeedArticlePreview *)featuredPreview {
+    NSMutableArray<NSURL *> *articleURLs = [NSMutableArray arrayWithCapacity:feedPreviews.count];
+    NSMutableArray<WMFInMemoryURLKey *> *inMemoryKeys = [NSMutableArray arrayWithCapacity:feedPreviews.count];
+    NSMutableArray<WMFFeedArticlePreview *> *keyedPreviews = [NSMutableArray arrayWithCapacity:feedPreviews.count];
+    NSMutableOrderedSet<WMFInMemoryURLKey *> *uniqueInMemoryKeys = [NSMutableOrderedSet orderedSetWithCapacity:feedPreviews.count];
+    for (WMFFeedArticlePreview *feedPreview in feedPreviews) {
+        NSURL *articleURL = [feedPreview articleURL];
+        WMFInMemoryURLKey *inMemoryKey = articleURL.wmf_inMemoryKey;
+        if (!inMemoryKey) {
+            continue;
         }
+        [articleURLs addObject:articleURL];
+        [inMemoryKeys addObject:inMemoryKey];
+        [keyedPreviews addObject:feedPreview];
+        [uniqueInMemoryKeys addObject:inMemoryKey];
     }
-    
-    if ([feedPreview.displayTitleHTML length] > 0) {
-        article.displayTitleHTML = feedPreview.displayTitleHTML;
-    } else if ([feedPreview.displayTitle length] > 0) {
-        article.displayTitleHTML = feedPreview.displayTitle;
-    }
-    
-    if ([feedPreview.wikidataDescription length] > 0) {
-        article.wikidataDescription = feedPreview.wikidataDescription;
-    }
-    if ([feedPreview.snippet length] > 0) {
-        article.snippet = feedPreview.snippet;
+
+    NSMutableDictionary<WMFInMemoryURLKey *, WMFArticle *> *articlesByKey = [NSMutableDictionary dictionaryWithCapacity:uniqueInMemoryKeys.count];
+    if (uniqueInMemoryKeys.count == 0) {
+        return articlesByKey;
     }
-    if (feedPreview.thumbnailURL != nil) {
 
-        article.thumbnailURL = feedPreview.thumbnailURL;
+    // One fetch for every preview, matching on key and variant like the single article lookups
+    NSError *fetchError = nil;
+    NSArray<WMFArticle *> *existingArticles = [self fetchArticlesWithInMemoryURLKeys:uniqueInMemoryKeys.array error:&fetchError];
+    if (!existingArticles) {
+        DDLogError(@"Error fetching articles for feed previews: %@", fetchError);
     }
-    if (pageViews != nil) {
-        if (article.pageViews == nil) {
-            article.pageViews = pageViews;
-        } else {
-            article.pageViews = [article.pageViews mtl_dictionaryByAddingEntriesFromDictionary:pageViews];
+    for (WMFArticle *article in existingArticles) {
+        if (!article.key) {
+            continue;
+        }
+        WMFInMemoryURLKey *inMemoryKey = [[WMFInMemoryURLKey alloc] initWithDatabaseKey:article.key languageVariantCode:article.variant];
+        if (!articlesByKey[inMemoryKey]) {
+            articlesByKey[inMemoryKey] = article;
         }
     }
-    if (feedPreview.imageURLString != nil) {
-        article.imageURLString = feedPreview.imageURLString;
-    }
-    if (feedPreview.imageWidth != nil) {
-        article.imageWidth = feedPreview.imageWidth;
-    }
-    if (feedPreview.imageHeight != nil) {
-        article.imageHeight = feedPreview.imageHeight;
-    }
-    
-    return article;
+
+    // Previews are applied in order so an article that appears in more than one section ends up as it would with one upsert per preview
+    [inMemoryKeys enumerateObjectsUsingBlock:^(WMFInMemoryURLKey *_Nonnull inMemoryKey, NSUInteger idx, BOOL *_Nonnull stop) {
+        WMFArticle *article = articlesByKey[inMemoryKey];
+        if (!article) {
+            article = [self createArticleWithKey:inMemoryKey.databaseKey variant:inMemoryKey.languageVariantCode];
+            articlesByKey[inMemoryKey] = article;
+        }
+        WMFFeedArticlePreview *feedPreview = keyedPreviews[idx];
+        [article updateWithFeedPreview:feedPreview pageViews:pageViews[articleURLs[idx]] isFeatured:feedPreview == featuredPreview];
+    }];
+
+    return articlesByKey;
 }
 
 @end
@@ -7,6 +7,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface WMFContent : NSManagedObject
 
+// The full content, read from compactData when it's set and from the legacy object attribute otherwise. Setting it writes compactData, falling back to object for graphs that can't be securely archived.
+// Arrays read from compactData decode each element the first time it's accessed, so reading the count or the first few elements doesn't decode the rest. Bridging to a typed Swift array decodes every element, and elements that fail to decode read as NSNull.
+@property (nullable, nonatomic, strong) id<NSCoding> contentObject;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -1,5 +1,242 @@
 #import "WMFContent+CoreDataClass.h"
+#import <WMF/WMFContentGroup+Extensions.h>
+#import <WMF/WMFLogging.h>
+#import <WMF/WMF-Swift.h>
+
+/* compactData layout, version 1:
+
+    4 bytes   magic "WMFC"
+    1 byte    format version
+    1 byte    kind: 0 for a single object, 1 for an array
+    2 bytes   reserved
+    rest      LZFSE compressed body
+
+    The body is a little-endian uint32 element count, then a uint32 end offset for each element, then each element's secure keyed archive back to back. Archiving elements separately lets an array decode only the elements that are read, while compressing the body as a whole keeps the class names and keys the archives repeat from costing space per element.
+ */
+
+static const char WMFContentCompactDataMagic[4] = {'W', 'M', 'F', 'C'};
+static const uint8_t WMFContentCompactDataVersion = 1;
+#define WMFContentCompactDataHeaderLength 8
+
+typedef NS_ENUM(uint8_t, WMFContentCompactDataKind) {
+    WMFContentCompactDataKindObject = 0,
+    WMFContentCompactDataKindArray = 1
+};
+
+static NSSet<Class> *WMFContentAllowedClasses(void) {
+    static NSSet<Class> *allowedClasses;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        allowedClasses = [NSSet setWithArray:[WMFSecureUnarchiveFromDataTransformer allowedTopLevelClasses]];
+    });
+    return allowedClasses;
+}
+
+#pragma mark - Lazily Decoded Array
+
+@interface WMFContentLazyArray : NSArray {
+    NSData *_body;
+    NSUInteger _count;
+    NSString *_languageVariantCode;
+    NSMutableArray *_decodedElements; // NSNull until decoded
+}
+
+- (nullable instancetype)initWithBody:(NSData *)body languageVariantCode:(nullable NSString *)languageVariantCode;
+
+@end
+
+@implementation WMFContentLazyArray
+
+- (nullable instancetype)initWithBody:(NSData *)body languageVariantCode:(nullable NSString *)languageVariantCode {
+    if (body.length < sizeof(uint32_t)) {
+        return nil;
+    }
+    uint32_t count = 0;
+    [body getBytes:&count length:sizeof(uint32_t)];
+    count = CFSwapInt32LittleToHost(count);
+    NSUInteger elementsStart = sizeof(uint32_t) * (1 + (NSUInteger)count);
+    if (body.length < elementsStart) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _body = body;
+        _count = count;
+        _languageVariantCode = [languageVariantCode copy];
+        _decodedElements = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; i++) {
+            [_decodedElements addObject:[NSNull null]];
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    @synchronized (self) {
+        id element = _decodedElements[index];
+        if (element != [NSNull null]) {
+            return element;
+        }
+        element = [self decodeElementAtIndex:index] ?: [NSNull null];
+        _decodedElements[index] = element;
+        return element;
+    }
+}
+
+- (nullable id)decodeElementAtIndex:(NSUInteger)index {
+    NSUInteger elementsStart = sizeof(uint32_t) * (1 + _count);
+    const uint32_t *endOffsets = (const uint32_t *)((const uint8_t *)_body.bytes + sizeof(uint32_t));
+    NSUInteger start = index == 0 ? 0 : CFSwapInt32LittleToHost(endOffsets[index - 1]);
+    NSUInteger end = CFSwapInt32LittleToHost(endOffsets[index]);
+    if (end < start || elementsStart + end > _body.length) {
+        DDLogError(@"Invalid compact content offsets for element %lu", (unsigned long)index);
+        return nil;
+    }
+    NSData *archive = [_body subdataWithRange:NSMakeRange(elementsStart + start, end - start)];
+    NSError *error = nil;
+    id element = [NSKeyedUnarchiver unarchivedObjectOfClasses:WMFContentAllowedClasses() fromData:archive error:&error];
+    if (!element) {
+        DDLogError(@"Error decoding compact content element %lu: %@", (unsigned long)index, error);
+        return nil;
+    }
+    // Elements are decoded after awakeFromFetch, so the language variant is propagated here instead
+    [WMFContentGroup propagateLanguageVariant:_languageVariantCode toPropertyValue:element];
+    return element;
+}
+
+@end
+
+#pragma mark - WMFContent
+
+@interface WMFContent () {
+    id<NSCoding> _Nullable _contentObject;
+}
+@end
 
 @implementation WMFContent
 
+- (nullable id<NSCoding>)contentObject {
+    @synchronized (self) {
+        if (_contentObject != nil) {
+            return _contentObject;
+        }
+        NSData *compactData = self.compactData;
+        if (!compactData) {
+            return self.object;
+        }
+        _contentObject = [WMFContent contentObjectWithCompactData:compactData languageVariantCode:self.contentGroup.variant];
+        return _contentObject;
+    }
+}
+
+- (void)setContentObject:(nullable id<NSCoding>)contentObject {
+    NSData *compactData = contentObject ? [WMFContent compactDataWithContentObject:contentObject] : nil;
+    @synchronized (self) {
+        _contentObject = compactData ? contentObject : nil;
+    }
+    if (contentObject && !compactData) {
+        self.compactData = nil;
+        self.object = contentObject;
+        return;
+    }
+    self.compactData = compactData;
+    self.object = nil;
+}
+
+- (void)didTurnIntoFault {
+    [super didTurnIntoFault];
+    @synchronized (self) {
+        _contentObject = nil;
+    }
+}
+
+#pragma mark - Compact Data
+
++ (nullable NSData *)compactDataWithContentObject:(id<NSCoding>)contentObject {
+    BOOL isArray = [(NSObject *)contentObject isKindOfClass:[NSArray class]];
+    NSArray *elements = isArray ? (NSArray *)contentObject : @[contentObject];
+
+    NSMutableData *endOffsets = [NSMutableData dataWithCapacity:sizeof(uint32_t) * elements.count];
+    NSMutableData *archives = [NSMutableData data];
+    for (id element in elements) {
+        NSError *error = nil;
+        NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:element requiringSecureCoding:YES error:&error];
+        if (!archive) {
+            DDLogError(@"Error archiving compact content element: %@", error);
+            return nil;
+        }
+        [archives appendData:archive];
+        if (archives.length > UINT32_MAX) {
+            return nil;
+        }
+        uint32_t endOffset = CFSwapInt32HostToLittle((uint32_t)archives.length);
+        [endOffsets appendBytes:&endOffset length:sizeof(uint32_t)];
+    }
+
+    uint32_t count = CFSwapInt32HostToLittle((uint32_t)elements.count);
+    NSMutableData *body = [NSMutableData dataWithCapacity:sizeof(uint32_t) + endOffsets.length + archives.length];
+    [body appendBytes:&count length:sizeof(uint32_t)];
+    [body appendData:endOffsets];
+    [body appendData:archives];
+
+    NSError *compressionError = nil;
+    NSData *compressedBody = [body compressedDataUsingAlgorithm:NSDataCompressionAlgorithmLZFSE error:&compressionError];
+    if (!compressedBody) {
+        DDLogError(@"Error compressing compact content: %@", compressionError);
+        return nil;
+    }
+
+    uint8_t header[WMFContentCompactDataHeaderLength] = {0};
+    memcpy(header, WMFContentCompactDataMagic, sizeof(WMFContentCompactDataMagic));
+    header[4] = WMFContentCompactDataVersion;
+    header[5] = isArray ? WMFContentCompactDataKindArray : WMFContentCompactDataKindObject;
+
+    NSMutableData *compactData = [NSMutableData dataWithCapacity:WMFContentCompactDataHeaderLength + compressedBody.length];
+    [compactData appendBytes:header length:WMFContentCompactDataHeaderLength];
+    [compactData appendData:compressedBody];
+    return compactData;
+}
+
++ (nullable id<NSCoding>)contentObjectWithCompactData:(NSData *)compactData languageVariantCode:(nullable NSString *)languageVariantCode {
+    if (compactData.length < WMFContentCompactDataHeaderLength) {
+        return nil;
+    }
+    const uint8_t *header = compactData.bytes;
+    if (memcmp(header, WMFContentCompactDataMagic, sizeof(WMFContentCompactDataMagic)) != 0) {
+        return nil;
+    }
+    if (header[4] != WMFContentCompactDataVersion) {
+        DDLogError(@"Unsupported compact content version: %u", header[4]);
+        return nil;
+    }
+    WMFContentCompactDataKind kind = header[5];
+
+    NSData *compressedBody = [compactData subdataWithRange:NSMakeRange(WMFContentCompactDataHeaderLength, compactData.length - WMFContentCompactDataHeaderLength)];
+    NSError *error = nil;
+    NSData *body = [compressedBody decompressedDataUsingAlgorithm:NSDataCompressionAlgorithmLZFSE error:&error];
+    if (!body) {
+        DDLogError(@"Error decompressing compact content: %@", error);
+        return nil;
+    }
+
+    WMFContentLazyArray *elements = [[WMFContentLazyArray alloc] initWithBody:body languageVariantCode:languageVariantCode];
+    switch (kind) {
+        case WMFContentCompactDataKindArray:
+            return elements;
+        case WMFContentCompactDataKindObject: {
+            id object = elements.firstObject;
+            return object == [NSNull null] ? nil : object;
+        }
+        default:
+            return nil;
+    }
+}
+
 @end
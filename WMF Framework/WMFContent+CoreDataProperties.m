@@ -7,6 +7,7 @@
 }
 
 @dynamic object;
+@dynamic compactData;
 @dynamic contentGroup;
 
 @end
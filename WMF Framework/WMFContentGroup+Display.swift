@@ -67,19 +67,16 @@ extension WMFContentGroup {
     }
     
     public var contentURLs: [URL]? {
+        guard let fullContent else {
+            return nil
+        }
         switch contentType {
         case .topReadPreview:
-            guard let previews = fullContent?.object as? [WMFFeedTopReadArticlePreview] else {
-                return nil
-            }
-            return previews.compactMap { $0.articleURL }
+            return fullContent.contentElements(of: WMFFeedTopReadArticlePreview.self).map { $0.articleURL }
         case .story:
-            guard let stories = fullContent?.object as? [WMFFeedNewsStory] else {
-                return nil
-            }
-            return stories.compactMap { $0.featuredArticlePreview?.articleURL ?? $0.articlePreviews?.first?.articleURL }
+            return fullContent.contentElements(of: WMFFeedNewsStory.self).compactMap { $0.featuredArticlePreview?.articleURL ?? $0.articlePreviews?.first?.articleURL }
         case .URL:
-            return fullContent?.object as? [URL]
+            return Array(fullContent.contentElements(of: URL.self))
         default:
             return nil
         }
@@ -157,3 +154,17 @@ extension WMFContentGroup {
         return articleKeys
     }
 }
+
+extension WMFContent {
+    /// The elements of an array `contentObject`, decoded one at a time as they are read. Casting `contentObject` to a Swift array instead decodes every element up front.
+    /// Elements that failed to decode, or aren't a `T`, are skipped.
+    public func contentElements<T>(of type: T.Type) -> some Sequence<T> {
+        let elements = contentObject as? NSArray
+        return (0..<(elements?.count ?? 0)).lazy.compactMap { index -> T? in
+            guard let element = elements?.object(at: index), !(element is NSNull) else {
+                return nil
+            }
+            return element as? T
+        }
+    }
+}
@@ -142,4 +142,10 @@ typedef NS_ENUM(int16_t, WMFContentGroupUndoType) {
 
 @end
 
+@interface WMFContentGroup (LanguageVariantPropagation)
+
++ (void)propagateLanguageVariant:(nullable NSString *)variant toPropertyValue:(NSObject<NSCoding> *)inObject;
+
+@end
+
 NS_ASSUME_NONNULL_END
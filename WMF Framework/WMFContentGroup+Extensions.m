@@ -291,7 +291,7 @@
         fullContent = (WMFContent *)[NSEntityDescription insertNewObjectForEntityForName:@"WMFContent" inManagedObjectContext:moc];
         self.fullContent = fullContent;
     }
-    fullContent.object = fullContentObject;
+    fullContent.contentObject = fullContentObject;
 }
 
 - (NSInteger)featuredContentIndex {
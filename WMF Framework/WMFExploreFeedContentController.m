@@ -9,12 +9,17 @@
 #import <WMF/WMFSuggestedEditsContentSource.h>
 #import <WMF/WMFAssertions.h>
 #import <WMF/WMF-Swift.h>
+#import <os/log.h>
+#import <os/signpost.h>
 @import WMFData;
 
 NSString *const WMFExploreFeedContentControllerBusyStateDidChange = @"WMFExploreFeedContentControllerBusyStateDidChange";
 const NSInteger WMFExploreFeedMaximumNumberOfDays = 30;
 static const NSTimeInterval WMFFeedRefreshTimeoutInterval = 60;
 static NSTimeInterval WMFFeedRefreshBackgroundTimeout = 30;
+static const NSInteger WMFFeedRefreshMaxConcurrentSourceLoads = 6;
+// A source that hasn't called back by then gives up its slot on sourceLoadQueue, so one stuck request can't hold back the rest of this refresh or the next one
+static const NSTimeInterval WMFFeedSourceLoadTimeoutInterval = 20;
 static const NSString *kvo_WMFExploreFeedContentController_operationQueue_operationCount = @"kvo_WMFExploreFeedContentController_operationQueue_operationCount";
 
 // Explore feed preferences dictionary keys
@@ -29,6 +34,7 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
 
 @property (nonatomic, strong) NSArray<id<WMFContentSource>> *contentSources;
 @property (nonatomic, strong) NSOperationQueue *operationQueue;
+@property (nonatomic, strong) NSOperationQueue *sourceLoadQueue;
 @property (nonatomic, weak) MWKDataStore *dataStore;
 @property (nonatomic, strong) NSDictionary *exploreFeedPreferences;
 @property (nonatomic, copy, readonly) NSArray<NSURL *> *preferredSiteURLs;
@@ -38,6 +44,16 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
 
 @end
 
+// Source load intervals are signposted so they show up in Instruments, and the refresh summary goes to the unified log, in release builds as well as debug
+static os_log_t WMFFeedRefreshLog(void) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("org.wikimedia.wikipedia", "FeedRefresh");
+    });
+    return log;
+}
+
 @implementation WMFExploreFeedContentController
 
 @synthesize exploreFeedPreferences = _exploreFeedPreferences;
@@ -47,6 +63,10 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
     if (self) {
         self.operationQueue = [[NSOperationQueue alloc] init];
         self.operationQueue.maxConcurrentOperationCount = 1;
+        // Caps how many content sources load at once during a refresh. With several languages there are dozens of sources, and starting them all together makes them compete for the network and the import context.
+        self.sourceLoadQueue = [[NSOperationQueue alloc] init];
+        self.sourceLoadQueue.maxConcurrentOperationCount = WMFFeedRefreshMaxConcurrentSourceLoads;
+        self.sourceLoadQueue.qualityOfService = NSQualityOfServiceUserInitiated;
         self.dataStore = dataStore;
     }
     return self;
@@ -206,9 +226,12 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
         dispatch_async(dispatch_get_main_queue(), ^{
             NSManagedObjectContext *moc = self.dataStore.feedImportContext;
             WMFTaskGroup *group = [WMFTaskGroup new];
+            NSDate *refreshStartDate = [NSDate date];
+            NSMutableDictionary<NSString *, NSNumber *> *sourceLoadDurations = [NSMutableDictionary dictionaryWithCapacity:self.contentSources.count];
 #if DEBUG
             NSMutableArray *entered = [NSMutableArray arrayWithCapacity:self.contentSources.count];
 #endif
+            NSMutableArray<NSOperation *> *sourceLoadOperations = [NSMutableArray arrayWithCapacity:self.contentSources.count];
             [self.contentSources enumerateObjectsUsingBlock:^(id<WMFContentSource> _Nonnull obj, NSUInteger idx, BOOL *_Nonnull stop) {
                 [group enter];
 #if DEBUG
@@ -217,7 +240,55 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
                     [entered addObject:classString];
                 }
 #endif
-                dispatch_block_t contentSourceCompletion = ^{
+                NSString *timingKey = [self timingKeyForContentSource:obj];
+                WMFAsyncBlockOperation *sourceLoadOperation = [[WMFAsyncBlockOperation alloc] initWithAsyncBlock:^(WMFAsyncBlockOperation *_Nonnull sourceLoadOperation) {
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        NSDate *sourceStartDate = [NSDate date];
+                        os_log_t log = WMFFeedRefreshLog();
+                        os_signpost_id_t signpostID = os_signpost_id_generate(log);
+                        os_signpost_interval_begin(log, signpostID, "Content Source Load", "%{public}@", timingKey);
+                        __block BOOL didFinishSourceLoad = NO;
+                        // Called by the source's completion or by the timeout, whichever comes first. The operation is only finished once.
+                        void (^finishSourceLoad)(BOOL) = ^(BOOL timedOut) {
+                            @synchronized(sourceLoadOperation) {
+                                if (didFinishSourceLoad) {
+                                    return;
+                                }
+                                didFinishSourceLoad = YES;
+                            }
+                            os_signpost_interval_end(log, signpostID, "Content Source Load", "%{public}@ timed out: %d", timingKey, timedOut);
+                            if (timedOut) {
+                                DDLogWarn(@"Feed content source %@ didn't finish within %.0fs", timingKey, WMFFeedSourceLoadTimeoutInterval);
+                            } else {
+                                @synchronized(sourceLoadDurations) {
+                                    sourceLoadDurations[timingKey] = @([[NSDate date] timeIntervalSinceDate:sourceStartDate]);
+                                }
+                            }
+                            [sourceLoadOperation finish];
+                        };
+                        dispatch_block_t contentSourceCompletion = ^{
+                            finishSourceLoad(NO);
+                        };
+                        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(WMFFeedSourceLoadTimeoutInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                            finishSourceLoad(YES);
+                        });
+
+                        if ([obj conformsToProtocol:@protocol(WMFOptionalNewContentSource)]) {
+                            NSDate *optionalDate = date ? date : [NSDate date];
+                            id<WMFOptionalNewContentSource> optional = (id<WMFOptionalNewContentSource>)obj;
+                            [optional loadContentForDate:optionalDate inManagedObjectContext:moc force:NO addNewContent:wasUserInitiated completion:contentSourceCompletion];
+                        } else if (date && [obj conformsToProtocol:@protocol(WMFDateBasedContentSource)]) {
+                            id<WMFDateBasedContentSource> dateBased = (id<WMFDateBasedContentSource>)obj;
+                            [dateBased loadContentForDate:date inManagedObjectContext:moc force:NO completion:contentSourceCompletion];
+                        } else if (!date) {
+                            [obj loadNewContentInManagedObjectContext:moc force:NO completion:contentSourceCompletion];
+                        } else {
+                            contentSourceCompletion();
+                        }
+                    });
+                }];
+                // Runs whether the load finished or was cancelled before it started, so the group always balances
+                sourceLoadOperation.completionBlock = ^{
 #if DEBUG
                     @synchronized(self) {
                         NSInteger index = [entered indexOfObject:classString];
@@ -227,23 +298,21 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
 #endif
                     [group leave];
                 };
-
-                if ([obj conformsToProtocol:@protocol(WMFOptionalNewContentSource)]) {
-                    NSDate *optionalDate = date ? date : [NSDate date];
-                    id<WMFOptionalNewContentSource> optional = (id<WMFOptionalNewContentSource>)obj;
-                    [optional loadContentForDate:optionalDate inManagedObjectContext:moc force:NO addNewContent:wasUserInitiated completion:contentSourceCompletion];
-                } else if (date && [obj conformsToProtocol:@protocol(WMFDateBasedContentSource)]) {
-                    id<WMFDateBasedContentSource> dateBased = (id<WMFDateBasedContentSource>)obj;
-                    [dateBased loadContentForDate:date inManagedObjectContext:moc force:NO completion:contentSourceCompletion];
-                } else if (!date) {
-                    [obj loadNewContentInManagedObjectContext:moc force:NO completion:contentSourceCompletion];
-                } else {
-                    contentSourceCompletion();
-                }
+                [sourceLoadOperations addObject:sourceLoadOperation];
             }];
+            [self.sourceLoadQueue addOperations:sourceLoadOperations waitUntilFinished:NO];
 
             [group waitInBackgroundWithTimeout:WMFFeedRefreshTimeoutInterval
                                     completion:^{
+                                        // Sources still waiting for a slot when the refresh times out are skipped rather than writing to a torn down import context
+                                        for (NSOperation *sourceLoadOperation in sourceLoadOperations) {
+                                            if (!sourceLoadOperation.isExecuting) {
+                                                [sourceLoadOperation cancel];
+                                            }
+                                        }
+                                        @synchronized(sourceLoadDurations) {
+                                            [self logSourceLoadDurations:sourceLoadDurations refreshDuration:[[NSDate date] timeIntervalSinceDate:refreshStartDate]];
+                                        }
                                         [moc performBlock:^{
                                             NSError *saveError = nil;
                                             if ([moc hasChanges]) {
@@ -275,6 +344,41 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
     [self.operationQueue addOperation:op];
 }
 
+- (NSString *)timingKeyForContentSource:(id<WMFContentSource>)contentSource {
+    NSString *className = NSStringFromClass([contentSource class]);
+    if (![contentSource respondsToSelector:@selector(siteURL)]) {
+        return className;
+    }
+    NSString *languageCode = [[(id)contentSource siteURL] wmf_contentLanguageCode];
+    return languageCode ? [NSString stringWithFormat:@"%@ (%@)", className, languageCode] : className;
+}
+
+// Logs the slowest sources and the total time per source class, to show which card types dominate refresh latency. Sources that timed out are missing.
+- (void)logSourceLoadDurations:(NSDictionary<NSString *, NSNumber *> *)sourceLoadDurations refreshDuration:(NSTimeInterval)refreshDuration {
+    NSMutableDictionary<NSString *, NSNumber *> *durationsByClass = [NSMutableDictionary dictionary];
+    [sourceLoadDurations enumerateKeysAndObjectsUsingBlock:^(NSString *_Nonnull timingKey, NSNumber *_Nonnull duration, BOOL *_Nonnull stop) {
+        NSString *className = [[timingKey componentsSeparatedByString:@" "] firstObject];
+        durationsByClass[className] = @(durationsByClass[className].doubleValue + duration.doubleValue);
+    }];
+
+    NSArray<NSString *> *slowestSources = [sourceLoadDurations keysSortedByValueUsingComparator:^NSComparisonResult(NSNumber *_Nonnull lhs, NSNumber *_Nonnull rhs) {
+        return [rhs compare:lhs];
+    }];
+    NSMutableArray<NSString *> *slowestSourceDescriptions = [NSMutableArray arrayWithCapacity:5];
+    for (NSString *timingKey in [slowestSources subarrayWithRange:NSMakeRange(0, MIN(5, slowestSources.count))]) {
+        [slowestSourceDescriptions addObject:[NSString stringWithFormat:@"%@: %.2fs", timingKey, sourceLoadDurations[timingKey].doubleValue]];
+    }
+
+    NSMutableArray<NSString *> *classDescriptions = [NSMutableArray arrayWithCapacity:durationsByClass.count];
+    for (NSString *className in [durationsByClass keysSortedByValueUsingComparator:^NSComparisonResult(NSNumber *_Nonnull lhs, NSNumber *_Nonnull rhs) {
+             return [rhs compare:lhs];
+         }]) {
+        [classDescriptions addObject:[NSString stringWithFormat:@"%@: %.2fs", className, durationsByClass[className].doubleValue]];
+    }
+
+    os_log_info(WMFFeedRefreshLog(), "Feed refresh loaded %lu of %lu sources in %.2fs. Slowest: %{public}@. Total by source: %{public}@", (unsigned long)sourceLoadDurations.count, (unsigned long)self.contentSources.count, refreshDuration, [slowestSourceDescriptions componentsJoinedByString:@", "], [classDescriptions componentsJoinedByString:@", "]);
+}
+
 - (void)updateContentSource:(Class)class force:(BOOL)force completion:(nullable dispatch_block_t)completion {
     WMFAssertMainThread(@"updateContentSource: must be called on the main thread");
     NSManagedObjectContext *moc = self.dataStore.feedImportContext;
@@ -624,7 +728,7 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
             dispatch_async(dispatch_get_main_queue(), ^{
                 NSManagedObjectContext *moc = self.dataStore.feedImportContext;
                 [moc performBlock:^{
-                    [self applyExploreFeedPreferencesToAllObjectsInManagedObjectContext:moc];
+                    [self applyExploreFeedPreferencesIncrementallyInManagedObjectContext:moc];
                     [self save:moc];
                     dispatch_async(dispatch_get_main_queue(), ^{
                         [op finish];
@@ -773,7 +877,10 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
     }
     
     // Do a second pass over objects and shuffle ordering around
-    
+    [self updateDailySortPriorityOrderingOfVisibleObjects:objects];
+}
+
+- (void)updateDailySortPriorityOrderingOfVisibleObjects:(NSArray<WMFContentGroup *> *)objects {
     NSArray *nonSuggestedEditsGroups = [[objects filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"contentGroupKindInteger != %d && isVisible == true", WMFContentGroupKindSuggestedEdits]] sortedArrayUsingDescriptors:self.exploreFeedSortDescriptors];
     
     WMFContentGroup *suggestedEditsGroup = [objects filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"contentGroupKindInteger == %d && isVisible == true", WMFContentGroupKindSuggestedEdits]].firstObject;
@@ -791,6 +898,141 @@ NSString *const WMFNewExploreFeedPreferencesWereRejectedNotification = @"WMFNewE
     }
 }
 
+// Applies the visibility preferences with batch updates, one pair per site for the customizable cards and one pair for the global cards, each scoped to the groups whose visibility actually changes. Only the days that gained visible groups are re-sorted.
+// Unlike applyExploreFeedPreferencesToAllObjectsInManagedObjectContext:, this doesn't fault in every content group. It only sees saved groups though, so feed imports with unsaved groups still use the full pass.
+- (void)applyExploreFeedPreferencesIncrementallyInManagedObjectContext:(NSManagedObjectContext *)moc {
+    // Batch updates work on the store, so anything pending in the context needs to be saved first
+    [self save:moc];
+
+    NSDictionary *exploreFeedPreferences = [self exploreFeedPreferencesInManagedObjectContext:moc];
+    NSPredicate *notCollapsedPredicate = [NSPredicate predicateWithFormat:@"undoTypeInteger == nil || undoTypeInteger == 0"];
+    NSMutableArray<NSManagedObjectID *> *updatedObjectIDs = [NSMutableArray array];
+    NSMutableArray<NSManagedObjectID *> *shownObjectIDs = [NSMutableArray array];
+
+    NSDictionary<NSNumber *, NSNumber *> *globalCardPreferences = [exploreFeedPreferences objectForKey:WMFExploreFeedPreferencesGlobalCardsKey];
+    NSSet<NSNumber *> *globalKinds = [WMFExploreFeedContentController globalContentGroupKindNumbers];
+    NSSet<NSNumber *> *visibleGlobalKinds = [globalKinds objectsPassingTest:^BOOL(NSNumber *_Nonnull kind, BOOL *_Nonnull stop) {
+        return [[globalCardPreferences objectForKey:kind] boolValue];
+    }];
+    [self batchUpdateVisibilityOfContentGroupsMatchingPredicate:notCollapsedPredicate kinds:globalKinds visibleKinds:visibleGlobalKinds inManagedObjectContext:moc updatedObjectIDs:updatedObjectIDs shownObjectIDs:shownObjectIDs];
+
+    NSSet<NSNumber *> *customizableKinds = [WMFExploreFeedContentController customizableContentGroupKindNumbers];
+    NSFetchRequest *sitesRequest = [WMFContentGroup fetchRequest];
+    sitesRequest.resultType = NSDictionaryResultType;
+    sitesRequest.propertiesToFetch = @[@"siteURLString", @"variant"];
+    sitesRequest.returnsDistinctResults = YES;
+    sitesRequest.predicate = [NSPredicate predicateWithFormat:@"contentGroupKindInteger IN %@", customizableKinds];
+    NSError *sitesError = nil;
+    NSArray<NSDictionary *> *sites = [moc executeFetchRequest:sitesRequest error:&sitesError];
+    if (!sites) {
+        DDLogError(@"Error fetching WMFContentGroup sites: %@", sitesError);
+    }
+    for (NSDictionary *site in sites) {
+        // Dictionary results leave out nil values
+        NSString *siteURLString = site[@"siteURLString"];
+        NSString *variant = site[@"variant"];
+        NSURL *siteURL = siteURLString ? [NSURL URLWithString:siteURLString] : nil;
+        siteURL.wmf_languageVariantCode = variant;
+        NSString *contentLanguageCode = siteURL.wmf_contentLanguageCode;
+        NSSet<NSNumber *> *visibleKinds = contentLanguageCode ? [exploreFeedPreferences objectForKey:contentLanguageCode] : nil;
+        if (![visibleKinds isKindOfClass:[NSSet class]]) {
+            visibleKinds = [NSSet set];
+        }
+        NSPredicate *sitePredicate = [NSPredicate predicateWithFormat:@"siteURLString == %@ && variant == %@", siteURLString, variant];
+        NSPredicate *predicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[sitePredicate, notCollapsedPredicate]];
+        [self batchUpdateVisibilityOfContentGroupsMatchingPredicate:predicate kinds:customizableKinds visibleKinds:visibleKinds inManagedObjectContext:moc updatedObjectIDs:updatedObjectIDs shownObjectIDs:shownObjectIDs];
+    }
+
+    if (updatedObjectIDs.count == 0) {
+        return;
+    }
+
+    // Batch updates skip the contexts, so refresh just the updated groups wherever they're registered
+    NSMutableArray<NSManagedObjectContext *> *contexts = [NSMutableArray arrayWithObject:moc];
+    NSManagedObjectContext *viewContext = self.dataStore.viewContext;
+    if (viewContext && viewContext != moc) {
+        [contexts addObject:viewContext];
+    }
+    [NSManagedObjectContext mergeChangesFromRemoteContextSave:@{NSUpdatedObjectsKey: updatedObjectIDs} intoContexts:contexts];
+
+    [self updateDailySortPrioritiesForDaysOfContentGroupsWithObjectIDs:shownObjectIDs inManagedObjectContext:moc];
+}
+
+- (void)batchUpdateVisibilityOfContentGroupsMatchingPredicate:(NSPredicate *)predicate kinds:(NSSet<NSNumber *> *)kinds visibleKinds:(NSSet<NSNumber *> *)visibleKinds inManagedObjectContext:(NSManagedObjectContext *)moc updatedObjectIDs:(NSMutableArray<NSManagedObjectID *> *)updatedObjectIDs shownObjectIDs:(NSMutableArray<NSManagedObjectID *> *)shownObjectIDs {
+    NSMutableSet<NSNumber *> *hiddenKinds = [kinds mutableCopy];
+    [hiddenKinds minusSet:visibleKinds];
+    NSMutableSet<NSNumber *> *shownKinds = [kinds mutableCopy];
+    [shownKinds intersectSet:visibleKinds];
+
+    NSPredicate *hidePredicate = [NSPredicate predicateWithFormat:@"isVisible == YES && (contentGroupKindInteger IN %@ || (contentGroupKindInteger IN %@ && wasDismissed == YES))", hiddenKinds, shownKinds];
+    NSArray<NSManagedObjectID *> *hiddenObjectIDs = [self batchUpdateContentGroupsMatchingPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:@[predicate, hidePredicate]] isVisible:NO inManagedObjectContext:moc];
+    [updatedObjectIDs addObjectsFromArray:hiddenObjectIDs];
+
+    if (shownKinds.count == 0) {
+        return;
+    }
+    NSPredicate *showPredicate = [NSPredicate predicateWithFormat:@"isVisible == NO && contentGroupKindInteger IN %@ && (wasDismissed == nil || wasDismissed == NO)", shownKinds];
+    NSArray<NSManagedObjectID *> *newlyShownObjectIDs = [self batchUpdateContentGroupsMatchingPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:@[predicate, showPredicate]] isVisible:YES inManagedObjectContext:moc];
+    [updatedObjectIDs addObjectsFromArray:newlyShownObjectIDs];
+    [shownObjectIDs addObjectsFromArray:newlyShownObjectIDs];
+}
+
+- (NSArray<NSManagedObjectID *> *)batchUpdateContentGroupsMatchingPredicate:(NSPredicate *)predicate isVisible:(BOOL)isVisible inManagedObjectContext:(NSManagedObjectContext *)moc {
+    NSBatchUpdateRequest *request = [[NSBatchUpdateRequest alloc] initWithEntityName:@"WMFContentGroup"];
+    request.predicate = predicate;
+    request.propertiesToUpdate = @{@"isVisible": @(isVisible)};
+    request.resultType = NSUpdatedObjectIDsResultType;
+    NSError *error = nil;
+    NSBatchUpdateResult *result = (NSBatchUpdateResult *)[moc executeRequest:request error:&error];
+    if (!result) {
+        DDLogError(@"Error updating WMFContentGroup visibility: %@", error);
+        return @[];
+    }
+    return (NSArray<NSManagedObjectID *> *)result.result ?: @[];
+}
+
+// Hidden groups don't need re-sorting since the groups around them keep their relative order. Newly shown groups are sorted in with the other visible groups from their day, which is all the feed's midnightUTCDate-first sort depends on.
+- (void)updateDailySortPrioritiesForDaysOfContentGroupsWithObjectIDs:(NSArray<NSManagedObjectID *> *)objectIDs inManagedObjectContext:(NSManagedObjectContext *)moc {
+    if (objectIDs.count == 0) {
+        return;
+    }
+
+    NSFetchRequest *daysRequest = [WMFContentGroup fetchRequest];
+    daysRequest.resultType = NSDictionaryResultType;
+    daysRequest.propertiesToFetch = @[@"midnightUTCDate"];
+    daysRequest.returnsDistinctResults = YES;
+    daysRequest.predicate = [NSPredicate predicateWithFormat:@"self IN %@", objectIDs];
+    NSError *error = nil;
+    NSArray<NSDictionary *> *days = [moc executeFetchRequest:daysRequest error:&error];
+    if (!days) {
+        DDLogError(@"Error fetching WMFContentGroup days: %@", error);
+        return;
+    }
+    NSArray<NSDate *> *midnightUTCDates = [days valueForKey:@"midnightUTCDate"];
+
+    NSFetchRequest *groupsRequest = [WMFContentGroup fetchRequest];
+    groupsRequest.predicate = [NSPredicate predicateWithFormat:@"isVisible == YES && midnightUTCDate IN %@", midnightUTCDates];
+    NSArray<WMFContentGroup *> *contentGroups = [moc executeFetchRequest:groupsRequest error:&error];
+    if (!contentGroups) {
+        DDLogError(@"Error fetching WMFContentGroup: %@", error);
+        return;
+    }
+
+    NSMutableDictionary<NSDate *, NSMutableArray<WMFContentGroup *> *> *contentGroupsByDay = [NSMutableDictionary dictionaryWithCapacity:midnightUTCDates.count];
+    for (WMFContentGroup *contentGroup in contentGroups) {
+        [contentGroup updateDailySortPriorityWithSortOrderByContentLanguageCode:self.sortOrderByContentLanguageCode];
+        NSMutableArray<WMFContentGroup *> *dayContentGroups = contentGroupsByDay[contentGroup.midnightUTCDate];
+        if (!dayContentGroups) {
+            dayContentGroups = [NSMutableArray array];
+            contentGroupsByDay[contentGroup.midnightUTCDate] = dayContentGroups;
+        }
+        [dayContentGroups addObject:contentGroup];
+    }
+    for (NSArray<WMFContentGroup *> *dayContentGroups in contentGroupsByDay.allValues) {
+        [self updateDailySortPriorityOrderingOfVisibleObjects:dayContentGroups];
+    }
+}
+
 - (void)save:(NSManagedObjectContext *)moc {
     NSError *error = nil;
     if (moc.hasChanges && ![moc save:&error]) {
@@ -15,3 +15,71 @@ public struct WidgetCache: Codable {
 	}
 
 }
+
+// MARK: - Storage
+
+/// Settings and featured content are stored as separate records, so reads that only need settings, like the search widgets' timelines, don't decode the featured content and its image data.
+public extension WidgetCache {
+
+	private enum RecordKey {
+		static let settings = "settings"
+		static let featuredContent = "featuredContent"
+	}
+
+	private static let shardedCache = SharedContainerShardedCache(name: SharedContainerCacheCommonNames.widgetCache)
+
+	static func load() -> WidgetCache {
+		migrateLegacyCacheIfNeeded()
+		return WidgetCache(settings: storedSettings(), featuredContent: storedFeaturedContent())
+	}
+
+	static func loadSettings() -> WidgetSettings {
+		migrateLegacyCacheIfNeeded()
+		return storedSettings()
+	}
+
+	static func loadFeaturedContent() -> WidgetFeaturedContent? {
+		migrateLegacyCacheIfNeeded()
+		return storedFeaturedContent()
+	}
+
+	static func saveSettings(_ settings: WidgetSettings) {
+		migrateLegacyCacheIfNeeded()
+		shardedCache.setValue(settings, forKey: RecordKey.settings)
+	}
+
+	static func saveFeaturedContent(_ featuredContent: WidgetFeaturedContent?) {
+		migrateLegacyCacheIfNeeded()
+		guard let featuredContent else {
+			shardedCache.removeValue(forKey: RecordKey.featuredContent)
+			return
+		}
+		shardedCache.setValue(featuredContent, forKey: RecordKey.featuredContent)
+	}
+
+	private static func storedSettings() -> WidgetSettings {
+		return shardedCache.value(forKey: RecordKey.settings) ?? .default
+	}
+
+	private static func storedFeaturedContent() -> WidgetFeaturedContent? {
+		return shardedCache.value(forKey: RecordKey.featuredContent)
+	}
+
+	/// Moves a cache saved by earlier versions as a single JSON file into separate records. Runs before every load and save, so a save can't be overwritten by a later migration; once the legacy file is gone this is a single failed file read.
+	/// A record that already exists is newer than the legacy file and is kept.
+	private static func migrateLegacyCacheIfNeeded() {
+		let legacyCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
+		guard let cache: WidgetCache = legacyCache.loadCache() else {
+			return
+		}
+		let existingKeys = Set(shardedCache.keys)
+		if !existingKeys.contains(RecordKey.settings) {
+			shardedCache.setValue(cache.settings, forKey: RecordKey.settings)
+		}
+		if !existingKeys.contains(RecordKey.featuredContent), let featuredContent = cache.featuredContent {
+			shardedCache.setValue(featuredContent, forKey: RecordKey.featuredContent)
+		}
+		try? legacyCache.removeCache()
+	}
+
+}
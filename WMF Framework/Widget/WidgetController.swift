@@ -25,10 +25,9 @@ public final class WidgetController: NSObject {
     // MARK: Properties
 
     @objc public static let shared = WidgetController()
-    private let sharedCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
-    
+
     var widgetCache: WidgetCache {
-        return sharedCache.loadCache() ?? WidgetCache(settings: .default, featuredContent: nil)
+        return WidgetCache.load()
     }
 
     // MARK: Public
@@ -216,7 +215,7 @@ public extension WidgetController {
     // MARK: - Computed Properties
 
     var featuredContentSiteURL: URL {
-        return widgetCache.settings.siteURL
+        return WidgetCache.loadSettings().siteURL
     }
 
     static var potdSmallImageWidth: Int { ImageUtils.ImageWidth.w500.rawValue }
@@ -227,15 +226,11 @@ public extension WidgetController {
 
     /// This is currently unused. It will be useful when we update the main app to also update the widget's cache when it performs any updates to the featured content in the explore feed.
     func updateCacheWith(featuredContent: WidgetFeaturedContent) {
-        var updatedCache = widgetCache
-        updatedCache.featuredContent = featuredContent
-        sharedCache.saveCache(updatedCache)
+        WidgetCache.saveFeaturedContent(featuredContent)
     }
 
     func updateCacheWith(settings: WidgetSettings) {
-        var updatedCache = widgetCache
-        updatedCache.settings = settings
-        sharedCache.saveCache(updatedCache)
+        WidgetCache.saveSettings(settings)
     }
 
     /// Returns cached content if it's available for the current date in the current app selected language
@@ -258,21 +253,19 @@ public extension WidgetController {
         }
 
         let fetcher = WidgetContentFetcher.shared
-        var widgetCache = widgetCache
 
         if useCacheIfAvailable, let cachedContent = cachedContentIfAvailable() {
             performCompletion(result: .success(cachedContent))
             return
         }
 
-        fetcher.fetchFeaturedContent(forDate: Date(), siteURL: widgetCache.settings.siteURL, languageCode: widgetCache.settings.languageCode, languageVariantCode: widgetCache.settings.languageVariantCode) { result in
+        let settings = WidgetCache.loadSettings()
+        fetcher.fetchFeaturedContent(forDate: Date(), siteURL: settings.siteURL, languageCode: settings.languageCode, languageVariantCode: settings.languageVariantCode) { result in
             switch result {
             case .success(let featuredContent):
-                widgetCache.featuredContent = featuredContent
-                self.sharedCache.saveCache(widgetCache)
+                WidgetCache.saveFeaturedContent(featuredContent)
                 performCompletion(result: .success(featuredContent))
             case .failure(let error):
-                self.sharedCache.saveCache(widgetCache)
                 performCompletion(result: .failure(error))
             }
         }
@@ -288,7 +281,7 @@ public extension WidgetController {
         }
 
         let fetcher = WidgetContentFetcher.shared
-        var widgetCache = widgetCache
+        let widgetCache = widgetCache
 
         guard !isSnapshot else {
             let previewSnapshot = widgetCache.featuredContent ?? WidgetFeaturedContent.previewContent() ?? WidgetFeaturedContent()
@@ -326,8 +319,7 @@ public extension WidgetController {
 
                     group.notify(queue: .main) {
                         featuredContent.topRead = topRead
-                        widgetCache.featuredContent = featuredContent
-                        self.sharedCache.saveCache(widgetCache)
+                        WidgetCache.saveFeaturedContent(featuredContent)
                         if let featuredTopReadContent = featuredContent.topRead {
                             performCompletion(result: .success(featuredTopReadContent))
                         } else {
@@ -335,8 +327,7 @@ public extension WidgetController {
                         }
                     }
                 } else {
-                    widgetCache.featuredContent = nil
-                    self.sharedCache.saveCache(widgetCache)
+                    WidgetCache.saveFeaturedContent(nil)
                     performCompletion(result: .failure(.contentFailure))
                 }
             case .failure(let error):
@@ -355,7 +346,7 @@ public extension WidgetController {
         }
 
         let fetcher = WidgetContentFetcher.shared
-        var widgetCache = widgetCache
+        let widgetCache = widgetCache
 
         guard !isSnapshot else {
             let previewSnapshot = widgetCache.featuredContent ?? WidgetFeaturedContent.previewContent() ?? WidgetFeaturedContent()
@@ -378,8 +369,7 @@ public extension WidgetController {
                 if let featuredArticleThumbnailImageSource = featuredContent.featuredArticle?.thumbnailImageSource {
                     fetcher.fetchImageDataFrom(imageSource: featuredArticleThumbnailImageSource) { imageResult in
                         featuredContent.featuredArticle?.thumbnailImageSource?.data = try? imageResult.get()
-                        widgetCache.featuredContent = featuredContent
-                        self.sharedCache.saveCache(widgetCache)
+                        WidgetCache.saveFeaturedContent(featuredContent)
                         if let featureArticle = featuredContent.featuredArticle {
                             performCompletion(result: .success(featureArticle))
                         } else {
@@ -388,12 +378,10 @@ public extension WidgetController {
                     }
                 } else {
                     if let featureArticle = featuredContent.featuredArticle {
-                        widgetCache.featuredContent = featuredContent
-                        self.sharedCache.saveCache(widgetCache)
+                        WidgetCache.saveFeaturedContent(featuredContent)
                         performCompletion(result: .success(featureArticle))
                     } else {
-                        widgetCache.featuredContent = nil
-                        self.sharedCache.saveCache(widgetCache)
+                        WidgetCache.saveFeaturedContent(nil)
                         performCompletion(result: .failure(.contentFailure))
                     }
                 }
@@ -413,7 +401,7 @@ public extension WidgetController {
         }
 
         let fetcher = WidgetContentFetcher.shared
-        var widgetCache = widgetCache
+        let widgetCache = widgetCache
 
         guard !isSnapshot else {
             let previewSnapshot = widgetCache.featuredContent ?? WidgetFeaturedContent.previewContent() ?? WidgetFeaturedContent()
@@ -456,8 +444,7 @@ public extension WidgetController {
                         // but a single day sees many provider invocations (instances x families
                         // x snapshot/timeline), only the first needs the network.
                         featuredContent.pictureOfTheDay?.originalImageSource?.source = imageSource.source
-                        widgetCache.featuredContent = featuredContent
-                        self.sharedCache.saveCache(widgetCache)
+                        WidgetCache.saveFeaturedContent(featuredContent)
 
                         if let pictureOftheDay = featuredContent.pictureOfTheDay {
                             performCompletion(result: .success(pictureOftheDay))
@@ -466,8 +453,7 @@ public extension WidgetController {
                         }
                     }
                 } else {
-                    widgetCache.featuredContent = nil
-                    self.sharedCache.saveCache(widgetCache)
+                    WidgetCache.saveFeaturedContent(nil)
                     performCompletion(result: .failure(.contentFailure))
                 }
             case .failure(let error):
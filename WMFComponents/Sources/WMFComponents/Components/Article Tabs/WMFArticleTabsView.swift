@@ -283,7 +283,8 @@ fileprivate struct WMFArticleTabsViewContent: View {
         .modifier(AspectRatioModifier(shouldLockAspectRatio: viewModel.shouldLockAspectRatio()))
         .onTapGesture {
             viewModel.didTapTab(tab.data)
-            viewModel.loggingDelegate?.logArticleTabsArticleClick(wmfProject: tab.data.articles.first?.project)
+            // The overview loads tab summaries, so the only article is the tab's current one, the article the user is opening
+            viewModel.loggingDelegate?.logArticleTabsArticleClick(wmfProject: tab.data.articles.last?.project)
         }
         .frame(maxWidth: .infinity, maxHeight: .infinity, alignment: .topLeading)
     }
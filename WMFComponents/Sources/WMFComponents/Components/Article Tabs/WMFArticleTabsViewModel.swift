@@ -148,7 +148,7 @@ public class WMFArticleTabsViewModel: NSObject, ObservableObject {
     
     private func loadTabs() async {
         do {
-            let tabs = try await dataController.fetchAllArticleTabs()
+            let tabs = try await dataController.fetchArticleTabSummaries()
             articleTabs = tabs.map { tab in
                 ArticleTab(
                     title: tab.articles.last?.title.underscoresToSpaces ?? "",
@@ -383,11 +383,14 @@ public final class WMFForYouArticleCardViewModel: ObservableObject, Identifiable
             // Ask for a bigger rendering than the summary's thumbnail, which is far too small for
             // a full screen card. Falls back to the thumbnail if the larger one is unavailable:
             let data: Data
+            let imageURL: URL
             if let largeURL = Self.upsizedThumbnailURL(from: thumbnailURL),
                let largeData = try? await WMFImageDataController.shared.fetchImageData(url: largeURL) {
                 data = largeData
+                imageURL = largeURL
             } else if let originalData = try? await WMFImageDataController.shared.fetchImageData(url: thumbnailURL) {
                 data = originalData
+                imageURL = thumbnailURL
             } else {
                 self.imageAvailability = .unavailable
                 self.loadState = .loaded
@@ -395,8 +398,9 @@ public final class WMFForYouArticleCardViewModel: ObservableObject, Identifiable
             }
 
             // Sample before showing anything, off the main actor: the pixel work is far too
-            // expensive to run while the user is swiping.
-            let color = await WMFImageColorSampler.shared.sampledColor(from: data)
+            // expensive to run while the user is swiping. Keyed by URL, so a card shown again
+            // reuses its colour.
+            let color = await WMFImageColorSampler.shared.sampledColor(from: data, cacheKey: imageURL)
 
             // The photograph, its colour and the loaded flag land in one update, so the card
             // appears complete. Showing the image first put it on screen against a black gradient
@@ -2,11 +2,15 @@ import Foundation
 import SwiftUI
 import UIKit
 
-public struct HtmlUtils {
+/// Pure string processing, so `nonisolated` and safe to call off the main thread, e.g. by `HtmlRenderCache` when prerendering.
+///
+/// The public entry points never throw now that nothing compiles a regular expression, but stay `throws` because the module's callers across the app handle errors from them with `try?` or `do`/`catch`. Dropping it would turn those into warnings and dead catch blocks in every caller.
+public nonisolated struct HtmlUtils {
     
     // MARK: - Shared - Nested Types
     
-    public struct Styles {
+    /// Hashable so rendered strings can be cached by the styles they were rendered with, and Sendable so they can be rendered off the main thread
+    public nonisolated struct Styles: Hashable, Sendable {
         let font: UIFont
         let boldFont: UIFont
         let italicsFont: UIFont
@@ -39,10 +43,17 @@ public struct HtmlUtils {
         case unordered
     }
     
+    private struct StyleRange {
+        let nsRange: NSRange
+        
+        // The same range in the source html, tags included. Bold and italic nesting is decided on these, so tags that leave no text between them don't make unrelated ranges look nested.
+        let sourceNSRange: NSRange
+        let targetAttributeValue: String?
+    }
+    
     private struct StyleData {
-        var openNSRanges: [NSRange] = []
-        var completeNSRanges: [NSRange] = []
-        var targetAttributeValues: [String] = []
+        var openRanges: [(location: Int, sourceLocation: Int, targetAttributeValue: String?)] = []
+        var completeRanges: [StyleRange] = []
     }
     
     private struct AllStyleData {
@@ -56,23 +67,10 @@ public struct HtmlUtils {
         let strong: StyleData
     }
     
-    private struct ListInsertData {
+    private struct RenderedHtml {
         let text: String
-        let index: Int
-        let stringIndex: String.Index
-    }
-    
-    private struct TagRemoveData {
-        let range: NSRange
-    }
-    
-    private struct TagAndContentRemoveData {
-        let range: NSRange
-    }
-    
-    private struct ElementReplaceData {
-        let range: NSRange
-        let replaceText: String
+        let listMarkerNSRanges: [NSRange]
+        let allStyleData: AllStyleData
     }
     
     // MARK: - Shared - Properties
@@ -82,7 +80,8 @@ public struct HtmlUtils {
     // MARK: - NSAttributedString - Public
     
     public static func nsAttributedStringFromHtml(_ html: String, styles: Styles) throws -> NSAttributedString {
-        let attributedString = NSMutableAttributedString(string: html)
+        let renderedHtml = render(html, listIndent: styles.listIndent, rendersMarkup: true)
+        
         let paragraphStyle = NSMutableParagraphStyle()
         paragraphStyle.lineSpacing = styles.lineSpacing
         paragraphStyle.lineBreakMode = styles.lineBreakMode
@@ -91,236 +90,162 @@ public struct HtmlUtils {
             .foregroundColor: styles.color,
             .paragraphStyle: paragraphStyle
         ]
-        attributedString.setAttributes(attributes, range: html.fullNSRange)
-
-        let listInsertData = try listInsertData(html: html, styles: styles)
-        insertListData(into: attributedString, listInsertData: listInsertData, styles: styles)
-        
-        let allStyleData = try allStyleData(html: attributedString.string)
-        addStyling(to: attributedString, allStyleData: allStyleData, styles: styles)
-        
-        let tagAndContentRemoveData = try tagAndContentRemoveData(html: attributedString.string)
-        removeHtmlTagAndContent(from: attributedString, tagAndContentRemoveData: tagAndContentRemoveData)
-        
-        let lineBreakReplaceData = try lineBreakReplaceData(html: attributedString.string)
-        replaceLineBreaks(from: attributedString, lineBreakReplaceData: lineBreakReplaceData)
+        let attributedString = NSMutableAttributedString(string: renderedHtml.text, attributes: attributes)
         
-        let tagRemoveData = try tagRemoveData(html: attributedString.string)
-        removeHtmlTags(from: attributedString, tagRemoveData: tagRemoveData)
+        for listMarkerRange in renderedHtml.listMarkerNSRanges {
+            attributedString.setAttributes([
+                .foregroundColor: styles.color,
+                .font: styles.font
+            ], range: listMarkerRange)
+        }
         
-        let entityReplaceData = try entityReplaceData(html: attributedString.string)
-        replaceEntities(from: attributedString, entityReplaceData: entityReplaceData)
+        addStyling(to: attributedString, allStyleData: renderedHtml.allStyleData, styles: styles)
         
         return attributedString
     }
     
     // MARK: - NSAttributedString - Private
     
-    private static func insertListData(into nsAttributedString: NSMutableAttributedString, listInsertData: [ListInsertData], styles: Styles) {
-        for insertData in listInsertData.reversed() {
-            let insertAttString = NSAttributedString(string: insertData.text, attributes: [
-                .foregroundColor: styles.color,
-                .font: styles.font
-            ])
-            nsAttributedString.insert(insertAttString, at: insertData.index)
-        }
-    }
-    
     private static func addStyling(to nsAttributedString: NSMutableAttributedString, allStyleData: AllStyleData, styles: Styles) {
 
         // Style Bold
-        for boldRange in allStyleData.bold.completeNSRanges {
-            nsAttributedString.addAttribute(.font, value: styles.boldFont, range: boldRange)
+        for boldRange in allStyleData.bold.completeRanges {
+            nsAttributedString.addAttribute(.font, value: styles.boldFont, range: boldRange.nsRange)
         }
         
         // Style Italic
-        for italicRange in allStyleData.italics.completeNSRanges {
-            nsAttributedString.addAttribute(.font, value: styles.italicsFont, range: italicRange)
+        for italicRange in allStyleData.italics.completeRanges {
+            nsAttributedString.addAttribute(.font, value: styles.italicsFont, range: italicRange.nsRange)
         }
         
         // Style Bold and Italic, needs extra nested looping handling
         
-        for italicRange in allStyleData.italics.completeNSRanges {
+        for italicRange in allStyleData.italics.completeRanges {
             
-            for boldRange in allStyleData.bold.completeNSRanges {
-                if NSIntersectionRange(boldRange, italicRange) == boldRange {
-                    nsAttributedString.addAttribute(.font, value: styles.boldItalicsFont, range: boldRange)
+            for boldRange in allStyleData.bold.completeRanges {
+                if NSIntersectionRange(boldRange.sourceNSRange, italicRange.sourceNSRange) == boldRange.sourceNSRange {
+                    nsAttributedString.addAttribute(.font, value: styles.boldItalicsFont, range: boldRange.nsRange)
                 }
             }
         }
         
-        for boldRange in allStyleData.bold.completeNSRanges {
+        for boldRange in allStyleData.bold.completeRanges {
             
-            for italicRange in allStyleData.italics.completeNSRanges {
-                if NSIntersectionRange(italicRange, boldRange) == italicRange {
-                    nsAttributedString.addAttribute(.font, value: styles.boldItalicsFont, range: italicRange)
+            for italicRange in allStyleData.italics.completeRanges {
+                if NSIntersectionRange(italicRange.sourceNSRange, boldRange.sourceNSRange) == italicRange.sourceNSRange {
+                    nsAttributedString.addAttribute(.font, value: styles.boldItalicsFont, range: italicRange.nsRange)
                 }
             }
         }
         
         // Style Link
         if let linkColor = styles.linkColor {
-            for (linkRange, linkHref) in zip(allStyleData.link.completeNSRanges, allStyleData.link.targetAttributeValues) {
+            for linkRange in allStyleData.link.completeRanges {
                 
                 // Here the linkHref might contain special characters, making linkHref invalid and crash when tapped. Turning it into a URL first automatically handles encoding.
                 // For example:
                 // https://en.wikipedia.org/wiki/Stephen_of_La_Ferté
-                guard let url = URL(string: linkHref) else { continue }
+                guard let linkHref = linkRange.targetAttributeValue,
+                      let url = URL(string: linkHref) else { continue }
                 
-                nsAttributedString.addAttribute(.foregroundColor, value: linkColor, range: linkRange)
-                nsAttributedString.addAttribute(.link, value: url, range: linkRange)
+                nsAttributedString.addAttribute(.foregroundColor, value: linkColor, range: linkRange.nsRange)
+                nsAttributedString.addAttribute(.link, value: url, range: linkRange.nsRange)
                 if let linkFont = styles.linkFont {
-                    nsAttributedString.addAttribute(.font, value: linkFont, range: linkRange)
+                    nsAttributedString.addAttribute(.font, value: linkFont, range: linkRange.nsRange)
                 }
             }
         }
         
         // Style Subscript
-        for subRange in allStyleData.subscript.completeNSRanges {
-            nsAttributedString.addAttribute(.font, value: UIFont.systemFont(ofSize: subscriptPointSize(styles: styles)), range: subRange)
-            nsAttributedString.addAttribute(.baselineOffset, value: subscriptOffset(styles: styles), range: subRange)
+        for subRange in allStyleData.subscript.completeRanges {
+            nsAttributedString.addAttribute(.font, value: UIFont.systemFont(ofSize: subscriptPointSize(styles: styles)), range: subRange.nsRange)
+            nsAttributedString.addAttribute(.baselineOffset, value: subscriptOffset(styles: styles), range: subRange.nsRange)
         }
         
         // Style Superscript
-        for supRange in allStyleData.superscript.completeNSRanges {
-            nsAttributedString.addAttribute(.font, value: UIFont.systemFont(ofSize: superscriptPointSize(styles: styles)), range: supRange)
-            nsAttributedString.addAttribute(.baselineOffset, value: superscriptOffset(styles: styles), range: supRange)
+        for supRange in allStyleData.superscript.completeRanges {
+            nsAttributedString.addAttribute(.font, value: UIFont.systemFont(ofSize: superscriptPointSize(styles: styles)), range: supRange.nsRange)
+            nsAttributedString.addAttribute(.baselineOffset, value: superscriptOffset(styles: styles), range: supRange.nsRange)
         }
         
         // Style Strikethrough
-        for strikethroughRange in allStyleData.strikethrough.completeNSRanges {
-            nsAttributedString.addAttribute(.strikethroughStyle, value: NSUnderlineStyle.single.rawValue, range: strikethroughRange)
+        for strikethroughRange in allStyleData.strikethrough.completeRanges {
+            nsAttributedString.addAttribute(.strikethroughStyle, value: NSUnderlineStyle.single.rawValue, range: strikethroughRange.nsRange)
         }
         
         // Style Underline
-        for underlineRange in allStyleData.underline.completeNSRanges {
-            nsAttributedString.addAttribute(.underlineStyle, value: NSUnderlineStyle.single.rawValue, range: underlineRange)
+        for underlineRange in allStyleData.underline.completeRanges {
+            nsAttributedString.addAttribute(.underlineStyle, value: NSUnderlineStyle.single.rawValue, range: underlineRange.nsRange)
         }
         
         // Style Strong
         if let strongColor = styles.strongColor {
-            for strongRange in allStyleData.strong.completeNSRanges {
-                nsAttributedString.addAttribute(.foregroundColor, value: strongColor, range: strongRange)
+            for strongRange in allStyleData.strong.completeRanges {
+                nsAttributedString.addAttribute(.foregroundColor, value: strongColor, range: strongRange.nsRange)
             }
         }
     }
-    
-    private static func removeHtmlTagAndContent(from nsAttributedString: NSMutableAttributedString, tagAndContentRemoveData: [TagAndContentRemoveData]) {
-        for removeData in tagAndContentRemoveData.reversed() {
-            nsAttributedString.replaceCharacters(in: removeData.range, with: "")
-        }
-    }
-    
-    private static func removeHtmlTags(from nsAttributedString: NSMutableAttributedString, tagRemoveData: [TagRemoveData]) {
-        for removeData in tagRemoveData.reversed() {
-            nsAttributedString.replaceCharacters(in: removeData.range, with: "")
-        }
-    }
-    
-    private static func replaceLineBreaks(from nsAttributedString: NSMutableAttributedString, lineBreakReplaceData: [ElementReplaceData]) {
-        for data in lineBreakReplaceData.reversed() {
-            nsAttributedString.replaceCharacters(in: data.range, with: data.replaceText)
-        }
-    }
-    
-    private static func replaceEntities(from nsAttributedString: NSMutableAttributedString, entityReplaceData: [ElementReplaceData]) {
-        for data in entityReplaceData.reversed() {
-            nsAttributedString.replaceCharacters(in: data.range, with: data.replaceText)
-        }
-    }
 
     // MARK: - AttributedString - Public
     
     public static func attributedStringFromHtml(_ html: String, styles: Styles) throws -> AttributedString {
-        var attributedString = AttributedString(html)
+        let renderedHtml = render(html, listIndent: styles.listIndent, rendersMarkup: true)
+        
+        var attributedString = AttributedString(renderedHtml.text)
         attributedString.font = styles.font
         attributedString.foregroundColor = styles.color
         
-        let listInsertData = try listInsertData(html: html, styles: styles)
-        insertListData(into: &attributedString, listInsertData: listInsertData, styles: styles)
-        
-        let allStyleData = try allStyleData(html: String(attributedString.characters))
-        addStyling(to: &attributedString, allStyleData: allStyleData, styles: styles)
-
-        let tagAndContentRemoveData = try tagAndContentRemoveData(html: String(attributedString.characters))
-        removeHtmlTagAndContent(from: &attributedString, tagAndContentRemoveData: tagAndContentRemoveData)
-        
-        let lineBreakReplaceData = try lineBreakReplaceData(html: String(attributedString.characters))
-        replaceLineBreaks(from: &attributedString, lineBreakReplaceData: lineBreakReplaceData)
-        
-        let tagRemoveData = try tagRemoveData(html: String(attributedString.characters))
-        removeHtmlTags(from: &attributedString, tagRemoveData: tagRemoveData)
-        
-        let entityReplaceData = try entityReplaceData(html: String(attributedString.characters))
-        replaceEntities(from: &attributedString, entityReplaceData: entityReplaceData)
+        addStyling(to: &attributedString, allStyleData: renderedHtml.allStyleData, styles: styles)
         
         return attributedString
     }
     
     // MARK: - AttributedString - Private
     
-    private static func insertListData(into attributedString: inout AttributedString, listInsertData: [ListInsertData], styles: Styles) {
-        for insertData in listInsertData.reversed() {
-            
-            if let attStringIndex = AttributedString.Index(insertData.stringIndex, within: attributedString) {
-                var insertAttString = AttributedString(insertData.text)
-                insertAttString.foregroundColor = styles.color
-                insertAttString.font = styles.font
-                attributedString.insert(insertAttString, at: attStringIndex)
-            }
-        }
-    }
-    
     private static func addStyling(to attributedString: inout AttributedString, allStyleData: AllStyleData, styles: Styles) {
         
         // Style Bold
-        for boldNSRange in allStyleData.bold.completeNSRanges {
-            if let boldRange = Range(boldNSRange, in: attributedString) {
+        for boldStyleRange in allStyleData.bold.completeRanges {
+            if let boldRange = Range(boldStyleRange.nsRange, in: attributedString) {
                 attributedString[boldRange].font = styles.boldFont
             }
         }
         
         // Style Italic
-        for italicNSRange in allStyleData.italics.completeNSRanges {
-            if let italicRange = Range(italicNSRange, in: attributedString) {
+        for italicStyleRange in allStyleData.italics.completeRanges {
+            if let italicRange = Range(italicStyleRange.nsRange, in: attributedString) {
                 attributedString[italicRange].font = styles.italicsFont
             }
         }
         
         // Style Bold and Italic, needs extra nested looping handling
-        for italicNSRange in allStyleData.italics.completeNSRanges {
+        for italicStyleRange in allStyleData.italics.completeRanges {
             
-            for boldNSRange in allStyleData.bold.completeNSRanges {
+            for boldStyleRange in allStyleData.bold.completeRanges {
                 
-                if let boldRange = Range(boldNSRange, in: attributedString),
-                   let italicRange = Range(italicNSRange, in: attributedString) {
-                    
-                    if boldRange.clamped(to: italicRange) == boldRange {
-                        attributedString[boldRange].font = styles.boldItalicsFont
-                    }
+                if NSIntersectionRange(boldStyleRange.sourceNSRange, italicStyleRange.sourceNSRange) == boldStyleRange.sourceNSRange,
+                   let boldRange = Range(boldStyleRange.nsRange, in: attributedString) {
+                    attributedString[boldRange].font = styles.boldItalicsFont
                 }
             }
         }
         
-        for boldNSRange in allStyleData.bold.completeNSRanges {
+        for boldStyleRange in allStyleData.bold.completeRanges {
             
-            for italicNSRange in allStyleData.italics.completeNSRanges {
+            for italicStyleRange in allStyleData.italics.completeRanges {
                 
-                if let boldRange = Range(boldNSRange, in: attributedString),
-                   let italicRange = Range(italicNSRange, in: attributedString) {
-                    
-                    if italicRange.clamped(to: boldRange) == italicRange {
-                        attributedString[italicRange].font = styles.boldItalicsFont
-                    }
-                    
+                if NSIntersectionRange(italicStyleRange.sourceNSRange, boldStyleRange.sourceNSRange) == italicStyleRange.sourceNSRange,
+                   let italicRange = Range(italicStyleRange.nsRange, in: attributedString) {
+                    attributedString[italicRange].font = styles.boldItalicsFont
                 }
             }
         }
         
         // Style Link
         if let linkColor = styles.linkColor {
-            for (linkNSRange, hrefString) in zip(allStyleData.link.completeNSRanges, allStyleData.link.targetAttributeValues) {
-                if let linkRange = Range(linkNSRange, in: attributedString) {
+            for linkStyleRange in allStyleData.link.completeRanges {
+                if let hrefString = linkStyleRange.targetAttributeValue,
+                   let linkRange = Range(linkStyleRange.nsRange, in: attributedString) {
                     attributedString[linkRange].foregroundColor = linkColor
                     attributedString[linkRange].link = URL(string:hrefString)
                     if let linkFont = styles.linkFont {
@@ -331,118 +256,51 @@ public struct HtmlUtils {
         }
         
         // Style Subscript
-        for subNSRange in allStyleData.subscript.completeNSRanges {
-            if let subRange = Range(subNSRange, in: attributedString) {
+        for subStyleRange in allStyleData.subscript.completeRanges {
+            if let subRange = Range(subStyleRange.nsRange, in: attributedString) {
                 attributedString[subRange].font = UIFont.systemFont(ofSize: subscriptPointSize(styles: styles))
                 attributedString[subRange].baselineOffset = subscriptOffset(styles: styles)
             }
         }
         
         // Style Superscript
-        for supNSRange in allStyleData.superscript.completeNSRanges {
-            if let supRange = Range(supNSRange, in: attributedString) {
+        for supStyleRange in allStyleData.superscript.completeRanges {
+            if let supRange = Range(supStyleRange.nsRange, in: attributedString) {
                 attributedString[supRange].font = UIFont.systemFont(ofSize: superscriptPointSize(styles: styles))
                 attributedString[supRange].baselineOffset = superscriptOffset(styles: styles)
             }
         }
         
         // Style Strikethrough
-        for strikethroughNSRange in allStyleData.strikethrough.completeNSRanges {
-            if let strikethroughRange = Range(strikethroughNSRange, in: attributedString) {
+        for strikethroughStyleRange in allStyleData.strikethrough.completeRanges {
+            if let strikethroughRange = Range(strikethroughStyleRange.nsRange, in: attributedString) {
                 attributedString[strikethroughRange].strikethroughStyle = .single
             }
         }
         
         // Style Underline
-        for underlineNSRange in allStyleData.underline.completeNSRanges {
-            if let underlineRange = Range(underlineNSRange, in: attributedString) {
+        for underlineStyleRange in allStyleData.underline.completeRanges {
+            if let underlineRange = Range(underlineStyleRange.nsRange, in: attributedString) {
                 attributedString[underlineRange].underlineStyle = .single
             }
         }
 
         // Style Strong
         if let strongColor = styles.strongColor {
-            for strongNSRange in allStyleData.strong.completeNSRanges {
-                if let strongRange  = Range(strongNSRange, in: attributedString) {
+            for strongStyleRange in allStyleData.strong.completeRanges {
+                if let strongRange  = Range(strongStyleRange.nsRange, in: attributedString) {
                     attributedString[strongRange].foregroundColor = strongColor
                 }
             }
         }
     }
-    
-    private static func removeHtmlTagAndContent(from attributedString: inout AttributedString, tagAndContentRemoveData: [TagAndContentRemoveData]) {
-        
-        for removeData in tagAndContentRemoveData.reversed() {
-            
-            guard let tagRange = Range(removeData.range, in: attributedString) else {
-                continue
-            }
-            
-            attributedString.removeSubrange(tagRange)
-        }
-    }
-    
-    private static func removeHtmlTags(from attributedString: inout AttributedString, tagRemoveData: [TagRemoveData]) {
-        
-        for removeData in tagRemoveData.reversed() {
-            
-            guard let tagRange = Range(removeData.range, in: attributedString) else {
-                continue
-            }
-            
-            attributedString.removeSubrange(tagRange)
-        }
-    }
-    
-    private static func replaceLineBreaks(from attributedString: inout AttributedString, lineBreakReplaceData: [ElementReplaceData]) {
-        
-        for data in lineBreakReplaceData.reversed() {
-            
-            guard let range = Range(data.range, in: attributedString) else {
-                continue
-            }
-            
-            attributedString.replaceSubrange(range, with: AttributedString(data.replaceText))
-        }
-    }
-    
-    private static func replaceEntities(from attributedString: inout AttributedString, entityReplaceData: [ElementReplaceData]) {
-        
-        for data in entityReplaceData.reversed() {
-            
-            guard let range = Range(data.range, in: attributedString) else {
-                continue
-            }
-            
-            attributedString.replaceSubrange(range, with: AttributedString(data.replaceText))
-        }
-    }
 
     public static func stringFromHTML(_ string: String) throws -> String {
-        let regex = try htmlTagRegex()
-        let cleanString = regex.stringByReplacingMatches(in: string, options: [], range: string.fullNSRange, withTemplate: "")
-        let entityReplaceData = try entityReplaceData(html: cleanString)
-            let mutableCleanString = NSMutableString(string: cleanString)
-            for data in entityReplaceData.reversed() {
-                mutableCleanString.replaceCharacters(in: data.range, with: data.replaceText)
-            }
-            return mutableCleanString as String
+        return render(string, listIndent: defaultListIndent, rendersMarkup: false).text
     }
 
     // MARK: - Shared - Private
     
-    private static func htmlTagRegex() throws -> NSRegularExpression {
-        try NSRegularExpression(pattern: "(?:<)([\\/a-z0-9]*)(?:\\s?)(?:([^>\"]|\"[^\"]*\")*)(?:>)")
-    }
-    
-    private static func lineBreakRegex() throws -> NSRegularExpression {
-        return try NSRegularExpression(pattern: "<br(?: ?\\/?)?>")
-    }
-    
-    private static func entityRegex() throws -> NSRegularExpression {
-        return try NSRegularExpression(pattern: "&([^\\s;]+);")
-    }
-    
     private static func subscriptPointSize(styles: Styles) -> CGFloat {
         return styles.font.pointSize * 0.75
     }
@@ -459,245 +317,370 @@ public struct HtmlUtils {
         return styles.font.pointSize * 0.35
     }
     
-    private static func listInsertData(html: String, styles: Styles) throws -> [ListInsertData] {
+    // MARK: - Rendering
+    
+    private static let entityReplacements: [String: String] = [
+        "&amp;": "&",
+        "&nbsp;": " ",
+        "&gt;": ">",
+        "&lt;": "<",
+        "&apos;": "'",
+        "&#039;": "'",
+        "&quot;": "\"",
+        "&ndash;": "\u{2013}",
+        "&mdash;": "\u{2014}",
+        "&#8722;": "\u{2212}"
+    ]
+    
+    /// Renders html in a single forward pass over its UTF-16 code units. Tags are dropped as they are read, and their effects are recorded as ranges in the output text:
+    /// - `<ol>`, `<ul>` and `<li>` insert list markers
+    /// - `<b>`, `<i>`, `<a href>`, `<sub>`, `<sup>`, `<s>`, `<u>` and `<strong>` become style ranges, from the open tag to its matching close tag
+    /// - `<script>` and `<style>` elements on a single line are dropped with their content
+    /// - `<br>` becomes a line break
+    /// - Common entities are decoded as the output is written, so an entity split by a tag is still decoded
+    /// Tags are read leniently: a `<`, a lowercase name, then anything up to the first `>` that is not inside double quotes.
+    /// When `rendersMarkup` is false, tags are only removed and entities decoded.
+    private static func render(_ html: String, listIndent: String, rendersMarkup: Bool) -> RenderedHtml {
+        let source = Array(html.utf16)
+        var output: [UInt16] = []
+        output.reserveCapacity(source.count)
+        
+        // Index in output of an `&` that may start an entity
+        var entityStart: Int?
+        
+        func append(_ unit: UInt16) {
+            output.append(unit)
+            guard let start = entityStart else {
+                if unit == UTF16Unit.ampersand {
+                    entityStart = output.count - 1
+                }
+                return
+            }
+            
+            if unit == UTF16Unit.semicolon {
+                entityStart = nil
+                guard output.count - start > 2,
+                      let replacement = entityReplacements[String(decoding: output[start...], as: UTF16.self)] else {
+                    return
+                }
+                output.removeSubrange(start...)
+                output.append(contentsOf: replacement.utf16)
+            } else if isWhitespace(unit) {
+                entityStart = nil
+            }
+        }
+        
+        func append(contentsOf string: String) {
+            for unit in string.utf16 {
+                append(unit)
+            }
+        }
         
-        // First enumerate through all list tags and capture insert data
-        let listTagRegex = try NSRegularExpression(pattern: "(?:<)((?:\\/?)(?:ol|ul|li))(?:\\s?)([^>]*)(?:>)")
-        var types: [ListType] = []
-        var indent: Int = 0
+        var listTypes: [ListType] = []
         var orderedListCounts: [Int] = []
-        var inserts: [ListInsertData] = []
-        listTagRegex.enumerateMatches(in: html, range: html.fullNSRange) { match, flags, stop in
-            
-            guard let tagNSRange = match?.range(at: 0),
-                  let tagRange = Range(tagNSRange, in: html),
-                  let tagNameNSRange = match?.range(at: 1),
-                  let tagNameRange = Range(tagNameNSRange, in: html) else {
+        var listMarkerNSRanges: [NSRange] = []
+        
+        var boldStyleData = StyleData()
+        var italicsStyleData = StyleData()
+        var linkStyleData = StyleData()
+        var subscriptStyleData = StyleData()
+        var superscriptStyleData = StyleData()
+        var strikethroughStyleData = StyleData()
+        var underlineStyleData = StyleData()
+        var strongStyleData = StyleData()
+        
+        func openStyle(_ styleData: inout StyleData, tagStart: Int, targetAttributeValue: String? = nil) {
+            styleData.openRanges.append((location: output.count, sourceLocation: tagStart, targetAttributeValue: targetAttributeValue))
+        }
+        
+        func closeStyle(_ styleData: inout StyleData, tagEnd: Int) {
+            // Unmatched close tags are ignored, which also keeps malformed html from crashing
+            guard let openRange = styleData.openRanges.popLast() else {
                 return
             }
-            
-            let tagNameString = html[tagNameRange]
-            if tagNameString == "ol" {
-                types.append(.ordered)
-                indent = indent + 1
+            let nsRange = NSRange(location: openRange.location, length: output.count - openRange.location)
+            let sourceNSRange = NSRange(location: openRange.sourceLocation, length: tagEnd - openRange.sourceLocation)
+            styleData.completeRanges.append(StyleRange(nsRange: nsRange, sourceNSRange: sourceNSRange, targetAttributeValue: openRange.targetAttributeValue))
+        }
+        
+        func insertListMarkerIfNeeded(listTagName: String, tagStart: Int) {
+            switch listTagName {
+            case "ol":
+                listTypes.append(.ordered)
                 orderedListCounts.append(0)
-            } else if tagNameString == "ul" {
-                types.append(.unordered)
-                indent = indent + 1
-            }
-            
-            if tagNameString == "/ol" {
-                
-                if !types.isEmpty && !orderedListCounts.isEmpty { // Prevent crashes from malformed html
-                    types.removeLast()
-                    indent = indent - 1
+            case "ul":
+                listTypes.append(.unordered)
+            case "/ol":
+                if !listTypes.isEmpty && !orderedListCounts.isEmpty { // Prevent crashes from malformed html
+                    listTypes.removeLast()
                     orderedListCounts.removeLast()
                 }
-            } else if tagNameString == "/ul" {
-                if !types.isEmpty { // Prevent crashes from malformed html
-                    types.removeLast()
-                    indent = indent - 1
+            case "/ul":
+                if !listTypes.isEmpty { // Prevent crashes from malformed html
+                    listTypes.removeLast()
                 }
-            }
-            
-            if tagNameString == "li" {
-                
-                guard let currentListType = types.last else {
+            case "li":
+                guard let currentListType = listTypes.last else {
                     return
                 }
                 
-                if case .ordered = currentListType {
-                    if let lastOrderedListCount = orderedListCounts.popLast() {
-                        orderedListCounts.append(lastOrderedListCount + 1)
-                    }
-                }
-                
-                let spaces = String(repeating: styles.listIndent, count: indent)
-                
-                var lineBreakPrefix = ""
-                if tagRange.lowerBound > html.startIndex {
-                    let previousIndex = html.index(before: tagRange.lowerBound)
-                    if html[previousIndex] != "\n" {
-                        lineBreakPrefix = "\n"
-                    }
-                }
+                // Break the line unless the tag already starts one in the source
+                let startsLine = tagStart > 0 && source[tagStart - 1] == UTF16Unit.lineFeed && !(tagStart > 1 && source[tagStart - 2] == UTF16Unit.carriageReturn)
+                let lineBreakPrefix = tagStart > 0 && !startsLine ? "\n" : ""
+                let spaces = String(repeating: listIndent, count: listTypes.count)
                 
+                let marker: String
                 switch currentListType {
                 case .ordered:
-                    if let count = orderedListCounts.last {
-                        inserts.append(ListInsertData(text: "\(lineBreakPrefix)\(spaces)\(count). ", index: tagNSRange.upperBound, stringIndex: tagRange.upperBound))
+                    guard let count = orderedListCounts.popLast() else {
+                        return
                     }
+                    orderedListCounts.append(count + 1)
+                    marker = "\(lineBreakPrefix)\(spaces)\(count + 1). "
                 case .unordered:
-                    inserts.append(ListInsertData(text: "\(lineBreakPrefix)\(spaces)• ", index: tagNSRange.upperBound, stringIndex: tagRange.upperBound))
+                    marker = "\(lineBreakPrefix)\(spaces)• "
                 }
+                
+                let markerStart = output.count
+                append(contentsOf: marker)
+                listMarkerNSRanges.append(NSRange(location: markerStart, length: output.count - markerStart))
+            default:
+                break
             }
         }
         
-        return inserts
-    }
-    
-    private static func allStyleData(html: String) throws -> AllStyleData {
-        
-        let htmlTagRegex = try htmlTagRegex()
-        
-        var boldStyleData = StyleData()
-        var italicsStyleData = StyleData()
-        var linkStyleData = StyleData()
-        var subscriptStyleData = StyleData()
-        var superscriptStyleData = StyleData()
-        var strikethroughStyleData = StyleData()
-        var underlineStyleData = StyleData()
-        var strongStyleData = StyleData()
-
-        htmlTagRegex.enumerateMatches(in: html, range: html.fullNSRange) { match, flags, stop in
+        var index = 0
+        while index < source.count {
+            let unit = source[index]
+            guard unit == UTF16Unit.lessThan else {
+                append(unit)
+                index += 1
+                continue
+            }
             
-            guard let tagNSRange = match?.range(at: 0),
-                  let tagNameNSRange = match?.range(at: 1) else {
-                return
+            if rendersMarkup,
+               let elementEnd = endOfSingleLineElement(named: "script", in: source, at: index) ?? endOfSingleLineElement(named: "style", in: source, at: index) {
+                index = elementEnd
+                continue
+            }
+            
+            guard let tag = readTag(in: source, at: index) else {
+                append(unit)
+                index += 1
+                continue
+            }
+            
+            defer {
+                index = tag.end
+            }
+            
+            guard rendersMarkup else {
+                continue
             }
             
-            updateStyleData(styleData: &boldStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "b", targetAttributeName: nil)
-            updateStyleData(styleData: &italicsStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "i", targetAttributeName: nil)
-            updateStyleData(styleData: &linkStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "a", targetAttributeName: "href")
-            updateStyleData(styleData: &subscriptStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "sub", targetAttributeName: nil)
-            updateStyleData(styleData: &superscriptStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "sup", targetAttributeName: nil)
-            updateStyleData(styleData: &strikethroughStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "s", targetAttributeName: nil)
-            updateStyleData(styleData: &underlineStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "u", targetAttributeName: nil)
-            updateStyleData(styleData: &strongStyleData, html: html, tagNSRange: tagNSRange, tagNameNSRange: tagNameNSRange, targetTagName: "strong", targetAttributeName: nil)
+            let tagName = String(decoding: source[tag.nameRange], as: UTF16.self)
+            
+            switch tagName {
+            case "b": openStyle(&boldStyleData, tagStart: index)
+            case "/b": closeStyle(&boldStyleData, tagEnd: tag.end)
+            case "i": openStyle(&italicsStyleData, tagStart: index)
+            case "/i": closeStyle(&italicsStyleData, tagEnd: tag.end)
+            case "a": openStyle(&linkStyleData, tagStart: index, targetAttributeValue: attributeValue(named: "href", in: source[index..<tag.end]))
+            case "/a": closeStyle(&linkStyleData, tagEnd: tag.end)
+            case "sub": openStyle(&subscriptStyleData, tagStart: index)
+            case "/sub": closeStyle(&subscriptStyleData, tagEnd: tag.end)
+            case "sup": openStyle(&superscriptStyleData, tagStart: index)
+            case "/sup": closeStyle(&superscriptStyleData, tagEnd: tag.end)
+            case "s": openStyle(&strikethroughStyleData, tagStart: index)
+            case "/s": closeStyle(&strikethroughStyleData, tagEnd: tag.end)
+            case "u": openStyle(&underlineStyleData, tagStart: index)
+            case "/u": closeStyle(&underlineStyleData, tagEnd: tag.end)
+            case "strong": openStyle(&strongStyleData, tagStart: index)
+            case "/strong": closeStyle(&strongStyleData, tagEnd: tag.end)
+            case "br", "br/":
+                // Only bare line breaks, `<br>`, `<br/>`, `<br >` and `<br />`, become line breaks. Others are removed like any tag.
+                switch String(decoding: source[index..<tag.end], as: UTF16.self) {
+                case "<br>", "<br/>", "<br >", "<br />":
+                    append(UTF16Unit.lineFeed)
+                default:
+                    break
+                }
+            default:
+                // List tags are matched on their first letters, so `<link>` counts as `<li>`, as it always has
+                if let listTagName = normalizedListTagName(fromTagName: tagName) {
+                    insertListMarkerIfNeeded(listTagName: listTagName, tagStart: index)
+                }
+            }
         }
         
-        return AllStyleData(bold: boldStyleData, italics: italicsStyleData, link: linkStyleData, subscript: subscriptStyleData, superscript: superscriptStyleData, strikethrough: strikethroughStyleData, underline: underlineStyleData, strong: strongStyleData)
-    }
-    
-    private static func updateStyleData(styleData: inout StyleData, html: String, tagNSRange: NSRange, tagNameNSRange: NSRange, targetTagName: String, targetAttributeName: String?) {
-        
-        guard let tagNameRange = Range(tagNameNSRange, in: html),
-        let tagRange = Range(tagNSRange, in: html) else {
-            return
+        // An entity decoded across a tag can leave a range past the end of the shortened text
+        let length = output.count
+        func clamped(_ styleData: StyleData) -> StyleData {
+            var styleData = styleData
+            styleData.completeRanges = styleData.completeRanges.map {
+                let location = min($0.nsRange.location, length)
+                let nsRange = NSRange(location: location, length: min($0.nsRange.length, length - location))
+                return StyleRange(nsRange: nsRange, sourceNSRange: $0.sourceNSRange, targetAttributeValue: $0.targetAttributeValue)
+            }
+            return styleData
         }
         
-        let tagNameString = html[tagNameRange]
-        let tagString = String(html[tagRange])
+        let allStyleData = AllStyleData(bold: clamped(boldStyleData), italics: clamped(italicsStyleData), link: clamped(linkStyleData), subscript: clamped(subscriptStyleData), superscript: clamped(superscriptStyleData), strikethrough: clamped(strikethroughStyleData), underline: clamped(underlineStyleData), strong: clamped(strongStyleData))
         
-        // Check for open tag, append to open tag ranges
-        if tagNameString == targetTagName {
-            styleData.openNSRanges.append(tagNSRange)
-            
-            // If needed, determine and append target attribute value
-            updateStyleAttributeDataIfNeeded(styleData: &styleData, tagString: tagString, targetAttributeName: targetAttributeName)
-        
-        // Check for close tag, then grab associated open tag range and create completed range with open and close ranges. Append to ranges.
-        } else if tagNameString == "/\(targetTagName)",
-                  let lastOpenNSRange = styleData.openNSRanges.popLast() {
-            let completeNSRange = NSRange(location: lastOpenNSRange.location, length: (tagNSRange.location + tagNSRange.length) - lastOpenNSRange.location)
-            styleData.completeNSRanges.append(completeNSRange)
-        }
+        return RenderedHtml(text: String(decoding: output, as: UTF16.self), listMarkerNSRanges: listMarkerNSRanges, allStyleData: allStyleData)
     }
     
-    private static func updateStyleAttributeDataIfNeeded(styleData: inout StyleData, tagString: String, targetAttributeName: String?) {
-
-        // Match the attribute value as either double-quoted (group 1), single-quoted (group 2), or unquoted (group 3).
-        // Capturing up to the matching quote character (rather than the first quote of any kind) ensures an apostrophe
-        // inside a double-quoted value is preserved instead of truncating the value. For example, Parsoid emits
-        // href="./New_Year's_Eve" with a literal apostrophe; the old pattern stopped at the apostrophe and produced
-        // "./New_Year", sending the user to the wrong page (T308268, T395708).
-        guard let targetAttributeName,
-              let attributeValueRegex = try? NSRegularExpression(pattern: "\(targetAttributeName)[\\s]*=[\\s]*(?:\"([^\"]*)\"|'([^']*)'|([^\\s>]+))") else {
-            return
-        }
-
-        guard let attrMatch = attributeValueRegex.firstMatch(in: tagString, range: tagString.fullNSRange) else {
-            return
+    private enum UTF16Unit {
+        static let lineFeed = UInt16(ascii: "\n")
+        static let carriageReturn = UInt16(ascii: "\r")
+        static let lessThan = UInt16(ascii: "<")
+        static let greaterThan = UInt16(ascii: ">")
+        static let slash = UInt16(ascii: "/")
+        static let quote = UInt16(ascii: "\"")
+        static let apostrophe = UInt16(ascii: "'")
+        static let equals = UInt16(ascii: "=")
+        static let ampersand = UInt16(ascii: "&")
+        static let semicolon = UInt16(ascii: ";")
+    }
+    
+    /// Finds the tag starting at `start`: `<`, a name of lowercase letters, digits and slashes, then anything up to the first `>` outside a pair of double quotes. Returns nil if the tag never closes, or a double quote in it is never closed.
+    private static func readTag(in source: [UInt16], at start: Int) -> (nameRange: Range<Int>, end: Int)? {
+        var index = start + 1
+        while index < source.count, isTagNameUnit(source[index]) {
+            index += 1
         }
-
-        for groupIndex in 1...3 {
-            let groupNSRange = attrMatch.range(at: groupIndex)
-            if groupNSRange.location != NSNotFound,
-               let groupRange = Range(groupNSRange, in: tagString) {
-                styleData.targetAttributeValues.append(String(tagString[groupRange]))
-                return
+        let nameRange = (start + 1)..<index
+        
+        while index < source.count {
+            switch source[index] {
+            case UTF16Unit.greaterThan:
+                return (nameRange, index + 1)
+            case UTF16Unit.quote:
+                guard let closingQuoteIndex = source[(index + 1)...].firstIndex(of: UTF16Unit.quote) else {
+                    return nil
+                }
+                index = closingQuoteIndex + 1
+            default:
+                index += 1
             }
         }
+        
+        return nil
     }
     
-    private static func tagAndContentRemoveData(html: String) throws -> [TagAndContentRemoveData] {
-        let regexScript = try NSRegularExpression(pattern: "<script.*?>.*?<\\/script>")
-        let regexStyle = try NSRegularExpression(pattern: "<style.*?>.*?<\\/style>")
-        
-        var data: [TagAndContentRemoveData] = []
+    /// For a `<script>` or `<style>` element whose open tag, content and close tag are all on one line, returns the index just past its close tag
+    private static func endOfSingleLineElement(named name: String, in source: [UInt16], at start: Int) -> Int? {
+        let openTagPrefix = Array("<\(name)".utf16)
+        let closeTag = Array("</\(name)>".utf16)
+        guard source[start...].starts(with: openTagPrefix) else {
+            return nil
+        }
         
-        let scriptMatches = regexScript.matches(in: html, range: html.fullNSRange)
-        let styleMatches = regexStyle.matches(in: html, range: html.fullNSRange)
-        for match in scriptMatches {
-            data.append(TagAndContentRemoveData(range: match.range(at: 0)))
+        var index = start + openTagPrefix.count
+        while index < source.count, source[index] != UTF16Unit.greaterThan {
+            guard !isLineTerminator(source[index]) else {
+                return nil
+            }
+            index += 1
         }
+        guard index < source.count else {
+            return nil
+        }
+        index += 1
         
-        for match in styleMatches {
-            data.append(TagAndContentRemoveData(range: match.range(at: 0)))
+        while index < source.count {
+            if source[index...].starts(with: closeTag) {
+                return index + closeTag.count
+            }
+            guard !isLineTerminator(source[index]) else {
+                return nil
+            }
+            index += 1
         }
         
-        return data
-    }
-    
-    private static func tagRemoveData(html: String) throws -> [TagRemoveData] {
-         try htmlTagRegex().matches(in: html, range: html.fullNSRange).map {
-            TagRemoveData(range: $0.range(at: 0))
-         }
-    }
-    
-    private static func lineBreakReplaceData(html: String) throws -> [ElementReplaceData] {
-        let lineBreakRegex = try lineBreakRegex()
-        var data: [ElementReplaceData] = []
-        let matches = lineBreakRegex.matches(in: html, range: html.fullNSRange)
-        for match in matches {
-            data.append(ElementReplaceData(range: match.range(at: 0), replaceText: "\n"))
-        }
-        return data
+        return nil
     }
     
-    private static func entityReplaceData(html: String) throws -> [ElementReplaceData] {
-        let entityRegex = try entityRegex()
-        var data: [ElementReplaceData] = []
-        let matches = entityRegex.matches(in: html, range: html.fullNSRange)
-        for match in matches {
+    /// Returns the value of the first `name=` attribute in a tag, double-quoted, single-quoted or unquoted.
+    /// Values are read up to the matching quote character rather than the first quote of any kind, so an apostrophe inside a double-quoted value is kept. For example, Parsoid emits href="./New_Year's_Eve" with a literal apostrophe, and stopping at the apostrophe would send the user to the wrong page (T308268, T395708).
+    private static func attributeValue(named name: String, in tag: ArraySlice<UInt16>) -> String? {
+        let nameUnits = Array(name.utf16)
+        var searchStart = tag.startIndex
+        
+        while let nameStart = tag[searchStart...].firstIndex(of: nameUnits[0]) {
+            searchStart = nameStart + 1
+            guard tag[nameStart...].starts(with: nameUnits) else {
+                continue
+            }
             
-            let range = match.range(at: 0)
-            let text = (html as NSString).substring(with: range)
-            let replaceText: String?
+            var index = nameStart + nameUnits.count
+            while index < tag.endIndex, isWhitespace(tag[index]) {
+                index += 1
+            }
+            guard index < tag.endIndex, tag[index] == UTF16Unit.equals else {
+                continue
+            }
+            index += 1
+            while index < tag.endIndex, isWhitespace(tag[index]) {
+                index += 1
+            }
+            guard index < tag.endIndex else {
+                continue
+            }
             
-            switch text {
-            case "&amp;":
-                replaceText = "&"
-            case "&nbsp;":
-                replaceText = " "
-            case "&gt;":
-                replaceText = ">"
-            case "&lt;":
-                replaceText = "<"
-            case "&apos;", "&#039;":
-                replaceText = "'"
-            case "&quot;":
-                replaceText = "\""
-            case "&ndash;":
-                replaceText = "\u{2013}"
-            case "&mdash;":
-                replaceText = "\u{2014}"
-            case "&#8722;":
-                replaceText = "\u{2212}"
-            default:
-                replaceText = nil
+            let firstUnit = tag[index]
+            if firstUnit == UTF16Unit.quote || firstUnit == UTF16Unit.apostrophe,
+               let closingQuoteIndex = tag[(index + 1)...].firstIndex(of: firstUnit) {
+                return String(decoding: tag[(index + 1)..<closingQuoteIndex], as: UTF16.self)
             }
             
-            if let replaceText {
-                data.append(ElementReplaceData(range: range, replaceText: replaceText))
+            // Unquoted, or a quote that is never closed, which is then read as part of an unquoted value
+            var valueEnd = index
+            while valueEnd < tag.endIndex, !isWhitespace(tag[valueEnd]), tag[valueEnd] != UTF16Unit.greaterThan {
+                valueEnd += 1
+            }
+            if valueEnd > index {
+                return String(decoding: tag[index..<valueEnd], as: UTF16.self)
             }
         }
-        return data
+        
+        return nil
+    }
+    
+    private static func normalizedListTagName(fromTagName tagName: String) -> String? {
+        let isCloseTag = tagName.hasPrefix("/")
+        let listTagName = String(tagName.dropFirst(isCloseTag ? 1 : 0).prefix(2))
+        guard listTagName == "ol" || listTagName == "ul" || listTagName == "li" else {
+            return nil
+        }
+        return isCloseTag ? "/\(listTagName)" : listTagName
     }
-}
-
-private extension String {
-    var fullNSRange: NSRange {
-        return NSRange(location: 0, length: utf16.count)
+    
+    private static func isTagNameUnit(_ unit: UInt16) -> Bool {
+        switch unit {
+        case UInt16(ascii: "a")...UInt16(ascii: "z"), UInt16(ascii: "0")...UInt16(ascii: "9"), UTF16Unit.slash:
+            return true
+        default:
+            return false
+        }
+    }
+    
+    /// Matches the Unicode White_Space property, all of which is in the Basic Multilingual Plane
+    private static func isWhitespace(_ unit: UInt16) -> Bool {
+        switch unit {
+        case 0x0009...0x000D, 0x0020, 0x0085, 0x00A0, 0x1680, 0x2000...0x200A, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000:
+            return true
+        default:
+            return false
+        }
+    }
+    
+    private static func isLineTerminator(_ unit: UInt16) -> Bool {
+        switch unit {
+        case 0x000A...0x000D, 0x0085, 0x2028, 0x2029:
+            return true
+        default:
+            return false
+        }
     }
 }
@@ -0,0 +1,128 @@
+import Foundation
+import UIKit
+
+/// A bounded cache of attributed strings rendered by `HtmlUtils`, keyed by the html and the styles it was rendered with.
+/// Lists that show many html snippets, like talk pages, look strings up here when configuring cells, and call `prerender(_:)` for rows about to be shown so rendering happens off the main thread. Entries are evicted by their approximate size in bytes, and by the system under memory pressure.
+public nonisolated final class HtmlRenderCache: @unchecked Sendable {
+
+    public static let shared = HtmlRenderCache()
+
+    public struct Request: Hashable, Sendable {
+        public let html: String
+        public let styles: HtmlUtils.Styles
+
+        /// Drops any line breaks at the start of the rendered string, e.g. the one a leading list item inserts
+        public let removesInitialNewlines: Bool
+
+        public init(html: String, styles: HtmlUtils.Styles, removesInitialNewlines: Bool = false) {
+            self.html = html
+            self.styles = styles
+            self.removesInitialNewlines = removesInitialNewlines
+        }
+    }
+
+    private final class Key: NSObject {
+        let request: Request
+        let requestHash: Int
+
+        init(_ request: Request) {
+            self.request = request
+            self.requestHash = request.hashValue
+        }
+
+        override var hash: Int {
+            return requestHash
+        }
+
+        override func isEqual(_ object: Any?) -> Bool {
+            guard let other = object as? Key else {
+                return false
+            }
+            return requestHash == other.requestHash && request == other.request
+        }
+    }
+
+    private let cache = NSCache<Key, NSAttributedString>()
+    private let prerenderQueue: OperationQueue
+
+    /// - Parameter totalCostLimit: Approximate bytes of rendered strings to keep
+    public init(totalCostLimit: Int = 8 * 1024 * 1024) {
+        cache.totalCostLimit = totalCostLimit
+        prerenderQueue = OperationQueue()
+        prerenderQueue.name = "org.wikimedia.wikipedia.htmlRenderCache"
+        prerenderQueue.qualityOfService = .userInitiated
+        prerenderQueue.maxConcurrentOperationCount = 2
+    }
+
+    /// Returns the cached string for `request`, rendering and caching it first if needed
+    public func attributedString(for request: Request) -> NSAttributedString {
+        let key = Key(request)
+        if let attributedString = cache.object(forKey: key) {
+            return attributedString
+        }
+
+        let attributedString = Self.render(request)
+        cache.setObject(attributedString, forKey: key, cost: Self.cost(of: attributedString))
+        return attributedString
+    }
+
+    /// Renders and caches strings that aren't cached yet in the background. Requests still waiting from earlier calls are dropped, as they are usually for rows that have since scrolled away.
+    public func prerender(_ requests: [Request]) {
+        prerenderQueue.cancelAllOperations()
+
+        var seenRequests = Set<Request>()
+        for request in requests where seenRequests.insert(request).inserted {
+            let key = Key(request)
+            guard cache.object(forKey: key) == nil else {
+                continue
+            }
+            prerenderQueue.addOperation { [weak self] in
+                guard let self, self.cache.object(forKey: key) == nil else {
+                    return
+                }
+                let attributedString = Self.render(request)
+                self.cache.setObject(attributedString, forKey: key, cost: Self.cost(of: attributedString))
+            }
+        }
+    }
+
+    public func cancelPrerendering() {
+        prerenderQueue.cancelAllOperations()
+    }
+
+    public func removeAll() {
+        prerenderQueue.cancelAllOperations()
+        cache.removeAllObjects()
+    }
+
+    // MARK: - Private
+
+    private static func render(_ request: Request) -> NSAttributedString {
+        guard let attributedString = try? HtmlUtils.nsAttributedStringFromHtml(request.html, styles: request.styles) else {
+            return NSAttributedString(string: request.html)
+        }
+
+        guard request.removesInitialNewlines else {
+            return attributedString
+        }
+
+        let string = attributedString.string as NSString
+        var newlineCount = 0
+        while newlineCount < string.length && string.character(at: newlineCount) == UInt16(ascii: "\n") {
+            newlineCount += 1
+        }
+        guard newlineCount > 0 else {
+            return attributedString
+        }
+        return attributedString.attributedSubstring(from: NSRange(location: newlineCount, length: string.length - newlineCount))
+    }
+
+    /// UTF-16 storage plus a rough allowance for each attribute run
+    private static func cost(of attributedString: NSAttributedString) -> Int {
+        var runCount = 0
+        attributedString.enumerateAttributes(in: NSRange(location: 0, length: attributedString.length), options: .longestEffectiveRangeNotRequired) { _, _, _ in
+            runCount += 1
+        }
+        return attributedString.length * MemoryLayout<UInt16>.size + runCount * 64
+    }
+}
@@ -1,5 +1,6 @@
 import SwiftUI
 import UIKit
+import simd
 
 /// Picks a background colour from a photograph that white text stays readable on.
 actor WMFImageColorSampler {
@@ -14,16 +15,46 @@ actor WMFImageColorSampler {
     /// Ceiling for the brightest channel, so a vivid hue cannot overpower the photograph.
     private static let maxBrightness: CGFloat = 0.55
 
-    /// Read one pixel in every `samplingStride` x `samplingStride` block rather than all of them.
-    private static let samplingStride = 2
+    /// Images are scaled down to at most this many pixels a side before sampling. Drawing does the
+    /// averaging far faster than reading every pixel would, and a card colour needs no more detail.
+    private static let samplingGridSize = 32
+
+    /// How many sampled colours to remember.
+    private static let memoizedColorLimit = 200
+
+    // MARK: - Memoization
+
+    /// `NSCache` needs an object, and a `nil` result is worth remembering too.
+    private final class SampledColorBox {
+        let color: Color?
+
+        init(_ color: Color?) {
+            self.color = color
+        }
+    }
+
+    private let sampledColors: NSCache<NSURL, SampledColorBox> = {
+        let cache = NSCache<NSURL, SampledColorBox>()
+        cache.countLimit = memoizedColorLimit
+        return cache
+    }()
 
     // MARK: - Public
 
     /// Takes image `Data` rather than a `UIImage` because `UIImage` is not `Sendable` and so cannot
     /// be handed to another concurrency domain. The image is decoded here instead.
-    func sampledColor(from imageData: Data) -> Color? {
-        guard let image = UIImage(data: imageData) else { return nil }
-        return Self.sampledColor(from: image)
+    ///
+    /// Pass the URL the data was fetched from as `cacheKey` and the same image is only ever sampled once.
+    func sampledColor(from imageData: Data, cacheKey: URL? = nil) -> Color? {
+        if let cacheKey, let box = sampledColors.object(forKey: cacheKey as NSURL) {
+            return box.color
+        }
+
+        let color = UIImage(data: imageData).flatMap { Self.sampledColor(from: $0) }
+        if let cacheKey {
+            sampledColors.setObject(SampledColorBox(color), forKey: cacheKey as NSURL)
+        }
+        return color
     }
 
     // MARK: - Image sampling algorithm
@@ -70,17 +101,16 @@ actor WMFImageColorSampler {
         var count = 0
     }
 
-    /// Draws the image into a pixel buffer and walks it once.
+    /// Draws the image into a small pixel buffer and walks it once.
     private static func pixelTotals(of cgImage: CGImage) -> PixelTotals? {
-        let width = cgImage.width
-        let height = cgImage.height
-        guard width > 0, height > 0 else { return nil }
+        guard cgImage.width > 0, cgImage.height > 0 else { return nil }
 
-        let bytesPerPixel = 4
-        let bytesPerRow = bytesPerPixel * width
-        var rawData = [UInt8](repeating: 0, count: height * bytesPerRow)
+        // Scale down, never up. Each grid pixel is the average of the block of image pixels it covers.
+        let width = min(cgImage.width, samplingGridSize)
+        let height = min(cgImage.height, samplingGridSize)
+        var pixels = [SIMD4<UInt8>](repeating: .zero, count: width * height)
 
-        return rawData.withUnsafeMutableBytes { buffer -> PixelTotals? in
+        return pixels.withUnsafeMutableBytes { buffer -> PixelTotals? in
             guard let baseAddress = buffer.baseAddress else { return nil }
 
             guard let context = CGContext(
@@ -88,43 +118,45 @@ actor WMFImageColorSampler {
                 width: width,
                 height: height,
                 bitsPerComponent: 8,
-                bytesPerRow: bytesPerRow,
+                bytesPerRow: width * MemoryLayout<SIMD4<UInt8>>.stride,
                 space: CGColorSpaceCreateDeviceRGB(),
                 bitmapInfo: CGImageAlphaInfo.premultipliedLast.rawValue
             ) else { return nil }
 
+            context.interpolationQuality = .medium
             context.draw(cgImage, in: CGRect(x: 0, y: 0, width: width, height: height))
 
             // Colourful pixels count for more than dull ones, so a small vivid area beats a large
-            // flat one. Squaring the saturation sharpens that preference.
-            var totals = PixelTotals()
-            let step = samplingStride * bytesPerPixel
-
-            for y in stride(from: 0, to: height, by: samplingStride) {
-                let rowStart = y * bytesPerRow
-                for i in stride(from: rowStart, to: rowStart + bytesPerRow, by: step) {
-                    let r = CGFloat(buffer[i]) / 255
-                    let g = CGFloat(buffer[i + 1]) / 255
-                    let b = CGFloat(buffer[i + 2]) / 255
-
-                    let maxC = max(r, g, b)
-                    let minC = min(r, g, b)
-                    let saturation = maxC == 0 ? 0 : (maxC - minC) / maxC
-                    let weight = saturation * saturation
-
-                    totals.weightedR += r * weight
-                    totals.weightedG += g * weight
-                    totals.weightedB += b * weight
-                    totals.weight += weight
-
-                    totals.plainR += r
-                    totals.plainG += g
-                    totals.plainB += b
-                    totals.count += 1
-                }
+            // flat one. Squaring the saturation sharpens that preference. Each pixel is one vector,
+            // so the channels are weighted and summed together; the alpha lane is ignored.
+            var weighted = SIMD4<Float>.zero
+            var weight: Float = 0
+            var plain = SIMD4<Float>.zero
+
+            for pixel in buffer.bindMemory(to: SIMD4<UInt8>.self) {
+                var rgb = SIMD4<Float>(pixel) / 255
+                rgb.w = 0
+
+                let maxC = rgb.max()
+                let minC = min(rgb.x, rgb.y, rgb.z)
+                let saturation = maxC == 0 ? 0 : (maxC - minC) / maxC
+                let pixelWeight = saturation * saturation
+
+                weighted += rgb * pixelWeight
+                weight += pixelWeight
+                plain += rgb
             }
 
-            return totals
+            return PixelTotals(
+                weightedR: CGFloat(weighted.x),
+                weightedG: CGFloat(weighted.y),
+                weightedB: CGFloat(weighted.z),
+                weight: CGFloat(weight),
+                plainR: CGFloat(plain.x),
+                plainG: CGFloat(plain.y),
+                plainB: CGFloat(plain.z),
+                count: width * height
+            )
         }
     }
 
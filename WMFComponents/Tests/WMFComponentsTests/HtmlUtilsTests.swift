@@ -111,6 +111,117 @@ final class HtmlUtilsTests: XCTestCase {
         XCTAssertTrue(linkString?.contains("8") ?? false, "Href value was truncated at the apostrophe.")
         XCTAssertFalse(linkString == "./Ocean", "Href value was truncated at the apostrophe, sending the user to the wrong page.")
     }
+
+    func testListsLineBreaksAndEntities() throws {
+        let html = "<ul><li>One</li><li>Two</li></ul>\n<ol>\n<li>A<br/>a</li>\n<li>B &amp; &quot;b&quot;</li></ol><script>var x = 1;</script>"
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml(html, styles: .testStyle)
+        XCTAssertEqual(attributed.string, "\n    • One\n    • Two\n\n    1. A\na\n    2. B & \"b\"")
+    }
+
+    func testNestedBoldAndItalics() throws {
+        let styles = HtmlUtils.Styles.testStyle
+        let html = "<b>bold <i>both</i></b> <i>italic</i>"
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml(html, styles: styles)
+        XCTAssertEqual(attributed.string, "bold both italic")
+        XCTAssertEqual(attributed.attribute(.font, at: 0, effectiveRange: nil) as? UIFont, styles.boldFont)
+        XCTAssertEqual(attributed.attribute(.font, at: 5, effectiveRange: nil) as? UIFont, styles.boldItalicsFont)
+        XCTAssertEqual(attributed.attribute(.font, at: 10, effectiveRange: nil) as? UIFont, styles.italicsFont)
+    }
+
+    func testLinkAfterAnchorWithoutHref() throws {
+        let html = "<a id=\"anchor\">Anchor</a> <a href=\"./Target\">Target</a>"
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml(html, styles: .testStyle)
+        XCTAssertNil(attributed.attribute(.link, at: 0, effectiveRange: nil))
+        XCTAssertEqual((attributed.attribute(.link, at: 7, effectiveRange: nil) as? URL)?.absoluteString, "./Target")
+    }
+
+    // The cases below pin behavior the single pass renderer kept from the regex-based implementation it replaced, including its quirks.
+
+    func testNestedListsAndUnmatchedListTags() throws {
+        let nested = try HtmlUtils.nsAttributedStringFromHtml("<ul><li>One</li><li>Two <b>bold</b></li></ul>\n<ol>\n<li>A</li>\n<li>B<ol><li>C</li></ol></li></ol>", styles: .testStyle)
+        XCTAssertEqual(nested.string, "\n    • One\n    • Two bold\n\n    1. A\n    2. B\n        1. C")
+
+        // List items outside a list get no bullet, and extra closing tags are ignored
+        let unmatched = try HtmlUtils.nsAttributedStringFromHtml("<li>orphan</li><ul><li>x</ul></ul></ol><li>y", styles: .testStyle)
+        XCTAssertEqual(unmatched.string, "orphan\n    • xy")
+    }
+
+    func testLineBreakVariantsAndRemovedElements() throws {
+        XCTAssertEqual(try HtmlUtils.nsAttributedStringFromHtml("Line<br>break<br/>and<br />more<br class=\"x\">end", styles: .testStyle).string, "Line\nbreak\nand\nmoreend")
+        XCTAssertEqual(try HtmlUtils.nsAttributedStringFromHtml("<script>var x = '<b>';</script>kept<style>.a{}</style> done", styles: .testStyle).string, "kept done")
+        XCTAssertEqual(try HtmlUtils.nsAttributedStringFromHtml("<span title=\"a>b\">x</span> y", styles: .testStyle).string, "x y")
+    }
+
+    func testOverlappingBoldAndItalicsUseTheLaterTag() throws {
+        let styles = HtmlUtils.Styles.testStyle
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml("<b>x<i>y</b>z</i>", styles: styles)
+        XCTAssertEqual(attributed.string, "xyz")
+        XCTAssertEqual(attributed.attribute(.font, at: 0, effectiveRange: nil) as? UIFont, styles.boldFont)
+        XCTAssertEqual(attributed.attribute(.font, at: 1, effectiveRange: nil) as? UIFont, styles.italicsFont)
+        XCTAssertEqual(attributed.attribute(.font, at: 2, effectiveRange: nil) as? UIFont, styles.italicsFont)
+    }
+
+    func testSubscriptSuperscriptStrikethroughUnderlineAndStrong() throws {
+        let styles = HtmlUtils.Styles.testStyle.withStrongColor(WMFTheme.light.accent)
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml("<sub>2</sub>H<sup>3</sup><s>st</s><u>un</u><strong>st</strong>", styles: styles)
+        XCTAssertEqual(attributed.string, "2H3stunst")
+
+        XCTAssertNotNil(attributed.attribute(.baselineOffset, at: 0, effectiveRange: nil))
+        XCTAssertNil(attributed.attribute(.baselineOffset, at: 1, effectiveRange: nil))
+        XCTAssertNotNil(attributed.attribute(.baselineOffset, at: 2, effectiveRange: nil))
+        XCTAssertEqual(attributed.attribute(.strikethroughStyle, at: 3, effectiveRange: nil) as? Int, NSUnderlineStyle.single.rawValue)
+        XCTAssertEqual(attributed.attribute(.underlineStyle, at: 5, effectiveRange: nil) as? Int, NSUnderlineStyle.single.rawValue)
+        XCTAssertEqual(attributed.attribute(.foregroundColor, at: 7, effectiveRange: nil) as? UIColor, WMFTheme.light.accent)
+        XCTAssertEqual(attributed.attribute(.foregroundColor, at: 1, effectiveRange: nil) as? UIColor, styles.color)
+    }
+
+    func testSingleQuotedAndUnquotedHrefs() throws {
+        let attributed = try HtmlUtils.nsAttributedStringFromHtml("<a href='single'>s</a> <a href=unq>u</a>", styles: .testStyle)
+        XCTAssertEqual(attributed.string, "s u")
+        XCTAssertEqual((attributed.attribute(.link, at: 0, effectiveRange: nil) as? URL)?.absoluteString, "single")
+        XCTAssertNil(attributed.attribute(.link, at: 1, effectiveRange: nil))
+        XCTAssertEqual((attributed.attribute(.link, at: 2, effectiveRange: nil) as? URL)?.absoluteString, "unq")
+    }
+
+    func testAttributedStringMatchesNSAttributedString() throws {
+        let html = "<p>Hello <a href=\"./New_Year's_Eve\">New Year's</a> and <b>bold <i>both</i></b></p><ul><li>One</li></ul>"
+        let attributedString = try HtmlUtils.attributedStringFromHtml(html, styles: .testStyle)
+        let nsAttributedString = try HtmlUtils.nsAttributedStringFromHtml(html, styles: .testStyle)
+        XCTAssertEqual(String(attributedString.characters), nsAttributedString.string)
+        XCTAssertEqual(attributedString.runs.compactMap { $0.link }, [URL(string: "./New_Year's_Eve")].compactMap { $0 })
+    }
+
+    func testLongTalkPagePerformance() throws {
+        let comment = "<p>Thanks for the <b>quick</b> review, <a rel=\"mw:WikiLink\" href=\"./User:Example\" title=\"User:Example\">Example</a>. I&#039;ve moved the <i>draft</i> to <a href=\"./Draft:New_Year's_Eve\">Draft:New Year&apos;s Eve</a> &mdash; see the notes below:</p><ul><li>Sources &amp; citations<sup>[1]</sup></li><li>Lead section<br>needs work</li></ul><p><s>Struck</s> <span class=\"signature\"><a href=\"./User_talk:Example\">talk</a> 12:00, 1 January 2025 (UTC)</span></p>"
+        let html = String(repeating: comment, count: 500)
+        let styles = HtmlUtils.Styles.testStyle
+        measure {
+            _ = try? HtmlUtils.nsAttributedStringFromHtml(html, styles: styles)
+        }
+    }
+
+    func testRenderCacheReturnsCachedString() {
+        let cache = HtmlRenderCache()
+        let request = HtmlRenderCache.Request(html: "Testing <b>bold</b> text", styles: .testStyle)
+
+        let first = cache.attributedString(for: request)
+        let second = cache.attributedString(for: request)
+        XCTAssertEqual(first.string, "Testing bold text")
+        XCTAssertTrue(first === second, "Expected the second lookup to return the cached string.")
+
+        let otherStylesRequest = HtmlRenderCache.Request(html: request.html, styles: .testStyle.withLineSpacing(4))
+        XCTAssertFalse(first === cache.attributedString(for: otherStylesRequest), "Expected different styles to render separately.")
+    }
+
+    func testRenderCacheRemovesInitialNewlines() {
+        let cache = HtmlRenderCache()
+        let html = "<ul><li>One</li><li>Two</li></ul>"
+
+        let trimmed = cache.attributedString(for: HtmlRenderCache.Request(html: html, styles: .testStyle, removesInitialNewlines: true))
+        let untrimmed = cache.attributedString(for: HtmlRenderCache.Request(html: html, styles: .testStyle))
+        XCTAssertFalse(trimmed.string.hasPrefix("\n"))
+        XCTAssertTrue(untrimmed.string.hasSuffix(trimmed.string))
+    }
 }
 
 fileprivate extension HtmlUtils.Styles {
@@ -126,4 +237,12 @@ fileprivate extension HtmlUtils.Styles {
             lineSpacing: 0
         )
     }
+
+    func withLineSpacing(_ lineSpacing: CGFloat) -> HtmlUtils.Styles {
+        return HtmlUtils.Styles(font: font, boldFont: boldFont, italicsFont: italicsFont, boldItalicsFont: boldItalicsFont, color: color, linkColor: linkColor, lineSpacing: lineSpacing)
+    }
+
+    func withStrongColor(_ strongColor: UIColor) -> HtmlUtils.Styles {
+        return HtmlUtils.Styles(font: font, boldFont: boldFont, italicsFont: italicsFont, boldItalicsFont: boldItalicsFont, color: color, linkColor: linkColor, strongColor: strongColor, lineSpacing: lineSpacing)
+    }
 }
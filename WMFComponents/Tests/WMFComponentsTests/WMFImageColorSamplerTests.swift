@@ -1,4 +1,5 @@
 import Testing
+import XCTest
 import UIKit
 import SwiftUI
 @testable import WMFComponents
@@ -115,4 +116,43 @@ struct WMFImageColorSamplerTests {
 
         #expect(b > r && b > g, "The vivid strip should set the colour, not the dull majority")
     }
+
+    // MARK: - Memoization
+
+    @Test
+    func theSameCacheKeyIsOnlySampledOnce() async throws {
+        let sampler = WMFImageColorSampler()
+        let cacheKey = try #require(URL(string: "https://upload.wikimedia.org/thumb/Example.jpg"))
+        let redData = try #require(image(.red).pngData())
+        let blueData = try #require(image(.blue).pngData())
+
+        let first = try #require(await sampler.sampledColor(from: redData, cacheKey: cacheKey))
+        let second = try #require(await sampler.sampledColor(from: blueData, cacheKey: cacheKey))
+        let (r, g, b) = components(of: second)
+
+        #expect(first == second)
+        #expect(r > g && r > b, "A remembered colour must be returned instead of sampling the new data")
+    }
+}
+
+final class WMFImageColorSamplerPerformanceTests: XCTestCase {
+
+    /// Samples 100 thumbnail sized photographs, each a different gradient so nothing is shared between them.
+    func testSamplingThroughput() {
+        let size = CGSize(width: 320, height: 240)
+        let thumbnails = (0..<100).map { index in
+            UIGraphicsImageRenderer(size: size).image { context in
+                let hue = CGFloat(index) / 100
+                let colors = [UIColor(hue: hue, saturation: 0.8, brightness: 0.9, alpha: 1).cgColor, UIColor.darkGray.cgColor] as CFArray
+                let gradient = CGGradient(colorsSpace: CGColorSpaceCreateDeviceRGB(), colors: colors, locations: nil)!
+                context.cgContext.drawLinearGradient(gradient, start: .zero, end: CGPoint(x: size.width, y: size.height), options: [])
+            }
+        }
+
+        measure {
+            for thumbnail in thumbnails {
+                _ = WMFImageColorSampler.sampledColor(from: thumbnail)
+            }
+        }
+    }
 }
@@ -11,6 +11,7 @@ public protocol WMFArticleTabsDataControlling {
     func setTabAsCurrent(tabIdentifier: UUID) async throws
     func currentTabIdentifier() async throws -> UUID?
     func fetchAllArticleTabs() async throws -> [WMFArticleTabsDataController.WMFArticleTab]
+    func fetchArticleTabSummaries() async throws -> [WMFArticleTabsDataController.WMFArticleTab]
 }
 
 @objc public class WMFArticleTabsDataController: NSObject, WMFArticleTabsDataControlling, @unchecked Sendable {
@@ -124,6 +125,9 @@ public protocol WMFArticleTabsDataControlling {
     private var coreDataStore: WMFCoreDataStore? {
         return _coreDataStore ?? WMFDataEnvironment.current.coreDataStore
     }
+    
+    // Only read and written on the background context's queue.
+    private var hasAssignedItemPositions = false
 
     public var userHasHiddenArticleSuggestionsTabs: Bool {
         get {
@@ -152,6 +156,7 @@ public protocol WMFArticleTabsDataControlling {
         backgroundContext = nil
         assignmentCache = nil
         _coreDataStore = nil
+        hasAssignedItemPositions = false
     }
     
     // MARK: - Experiment
@@ -289,6 +294,7 @@ public protocol WMFArticleTabsDataControlling {
             let newArticleTab = try coreDataStore.create(entityType: CDArticleTab.self, in: moc)
             newArticleTab.timestamp = Date()
             newArticleTab.isCurrent = setAsCurrent
+            newArticleTab.hasItemPositions = true
             let tabIdentifier = UUID()
             newArticleTab.identifier = tabIdentifier
             
@@ -298,6 +304,7 @@ public protocol WMFArticleTabsDataControlling {
                 let articleTabItem = try self.newArticleTabItem(page: page, moc: moc)
                 tabItemIdentifier = articleTabItem.identifier
                 articleTabItem.isCurrent = true
+                articleTabItem.position = 0
                 newArticleTab.items = NSOrderedSet(array: [articleTabItem])
             }
             
@@ -357,55 +364,48 @@ public protocol WMFArticleTabsDataControlling {
                 throw CustomError.missingTab
             }
             
+            try self.assignItemPositionsIfNeeded(moc: moc)
+            
             // Create a new tab item object for article
             let page = try self.pageForArticle(article, moc: moc)
             let newArticleTabItem = try self.newArticleTabItem(page: page, moc: moc)
             
-            // Set tab's existing items' isCurrent values = false. Delete any additional articles after the current article.
-            var newItems: [CDArticleTabItem] = []
-            var foundCurrent: Bool = false
-            if let currentItems = tab.items as? NSMutableOrderedSet {
-                let safeCurrentItems = currentItems.compactMap { $0 as? CDArticleTabItem }
-                for tabItem in safeCurrentItems {
+            // Set tab's existing current item isCurrent = false. Delete any additional articles after the current article.
+            let currentItem = try self.currentItem(in: tab, moc: moc)
+            currentItem?.isCurrent = false
+            
+            let lastItem: CDArticleTabItem?
+            if let currentItem, needsCleanoutOfFutureArticles {
+                let futureItems = try self.items(in: tab, after: currentItem.position, moc: moc)
+                for tabItem in futureItems {
+                    moc.delete(tabItem)
                     
-                    if tabItem.isCurrent {
-                        tabItem.isCurrent = false
-                        newItems.append(tabItem)
-                        foundCurrent = true
-                    } else {
-                        if foundCurrent && needsCleanoutOfFutureArticles {
-                            moc.delete(tabItem)
-                            
-                            // Post notification
-                            if let identifier = tabItem.identifier {
-                                NotificationCenter.default.post(
-                                    name: WMFNSNotification.articleTabItemDeleted,
-                                    object: nil,
-                                    userInfo: [WMFNSNotification.UserInfoKey.articleTabItemIdentifier: identifier]
-                                )
-                            }
-                            
-                            
-                        } else {
-                            newItems.append(tabItem)
-                        }
+                    // Post notification
+                    if let identifier = tabItem.identifier {
+                        NotificationCenter.default.post(
+                            name: WMFNSNotification.articleTabItemDeleted,
+                            object: nil,
+                            userInfo: [WMFNSNotification.UserInfoKey.articleTabItemIdentifier: identifier]
+                        )
                     }
                 }
+                lastItem = currentItem
+            } else {
+                lastItem = try self.lastItem(in: tab, moc: moc)
             }
             
-            if let lastTabItem = newItems.last,
-               lastTabItem.page == newArticleTabItem.page {
+            if let lastItem,
+               lastItem.page == newArticleTabItem.page {
                 // If tab's last item is the same article, set as isCurrent and don't append a duplicate tab item.
-                lastTabItem.isCurrent = true
+                lastItem.isCurrent = true
                 moc.delete(newArticleTabItem)
             } else {
                 // Set new tab item as current, append to tab's items
                 newArticleTabItem.isCurrent = true
-                newItems.append(newArticleTabItem)
+                newArticleTabItem.position = (lastItem?.position ?? -1) + 1
+                tab.addToItems(newArticleTabItem)
             }
             
-            tab.items = NSOrderedSet(array: newItems)
-            
             guard let tabIdentifier = tab.identifier,
                   let tabItemIdentifier = newArticleTabItem.identifier else {
                 throw CustomError.missingIdentifier
@@ -428,39 +428,29 @@ public protocol WMFArticleTabsDataControlling {
             throw WMFDataControllerError.coreDataStoreUnavailable
         }
         
-        let block: @Sendable () throws -> WMFArticle? = {
-            let predicate = NSPredicate(format: "identifier == %@", argumentArray: [tabIdentifier])
-            
-            guard let tab = try coreDataStore.fetch(entityType: CDArticleTab.self, predicate: predicate, fetchLimit: 1, in: moc)?.first else {
-                throw CustomError.missingTab
-            }
+        let block: @Sendable () throws -> WMFArticle? = { [weak self] in
+            guard let self else { throw CustomError.missingSelf }
             
-            guard let items = tab.items as? NSMutableOrderedSet, items.count > 0 else {
-                throw CustomError.missingPage
-            }
+            try self.assignItemPositionsIfNeeded(moc: moc)
             
-            var adjacentArticle: Any?
-            for (index, item) in items.enumerated() {
-                guard let articleItem = item as? CDArticleTabItem else { continue }
+            guard let currentItem = try self.currentItem(tabIdentifier: tabIdentifier, moc: moc),
+                  let tab = currentItem.tab else {
+                // Distinguish a missing tab from one without a current item, without loading its items.
+                let predicate = NSPredicate(format: "identifier == %@", argumentArray: [tabIdentifier])
+                guard let tab = try coreDataStore.fetch(entityType: CDArticleTab.self, predicate: predicate, fetchLimit: 1, in: moc)?.first else {
+                    throw CustomError.missingTab
+                }
                 
-                if articleItem.isCurrent {
-                    if isPrev,
-                       (index - 1) >= 0,
-                       items.count > index - 1 {
-                        adjacentArticle = items[index - 1]
-                        break
-                    } else if
-                        !isPrev,
-                        (index + 1) >= 0,
-                        items.count > index + 1 {
-                        adjacentArticle = items[index + 1]
-                        break
-                    }
+                guard try self.itemCount(in: tab, moc: moc) > 0 else {
+                    throw CustomError.missingPage
                 }
+                
+                return nil
             }
+            
+            let adjacentArticle = try self.item(in: tab, adjacentTo: currentItem.position, isPrev: isPrev, moc: moc)
 
-
-            if let cdArticleItem = adjacentArticle as? CDArticleTabItem,
+            if let cdArticleItem = adjacentArticle,
                let title = cdArticleItem.page?.title,
                let identifier = cdArticleItem.identifier,
                let projectID = cdArticleItem.page?.projectID,
@@ -500,11 +490,17 @@ public protocol WMFArticleTabsDataControlling {
                 throw CustomError.missingTab
             }
             
-            guard let items = tab.items as? NSMutableOrderedSet, items.count > 0 else {
-                throw CustomError.missingPage
+            // Only the outgoing and incoming current items change, so fetch just those rather than every item in the tab.
+            let fetchRequest = NSFetchRequest<CDArticleTabItem>(entityName: "CDArticleTabItem")
+            fetchRequest.predicate = NSPredicate(format: "tab == %@ AND (isCurrent == YES OR identifier == %@)", argumentArray: [tab, tabItemIdentifier])
+            let articleItems = try moc.fetch(fetchRequest)
+            
+            if articleItems.isEmpty {
+                guard try self.itemCount(in: tab, moc: moc) > 0 else {
+                    throw CustomError.missingPage
+                }
             }
             
-            let articleItems = items.compactMap { $0 as? CDArticleTabItem }
             for articleItem in articleItems {
                 if articleItem.identifier == tabItemIdentifier {
                     articleItem.isCurrent = true
@@ -607,6 +603,73 @@ public protocol WMFArticleTabsDataControlling {
         return newArticleTabItem
     }
     
+    /// Gives tabs created before item positions existed positions that match their ordered items. Each tab is only visited once.
+    private func assignItemPositionsIfNeeded(moc: NSManagedObjectContext) throws {
+        
+        guard !hasAssignedItemPositions else {
+            return
+        }
+        
+        guard let coreDataStore else {
+            throw WMFDataControllerError.coreDataStoreUnavailable
+        }
+        
+        let predicate = NSPredicate(format: "hasItemPositions == NO")
+        let tabs = try coreDataStore.fetch(entityType: CDArticleTab.self, predicate: predicate, fetchLimit: nil, in: moc) ?? []
+        for tab in tabs {
+            let items = tab.items?.compactMap { $0 as? CDArticleTabItem } ?? []
+            for (index, item) in items.enumerated() {
+                item.position = Int64(index)
+            }
+            tab.hasItemPositions = true
+        }
+        
+        try coreDataStore.saveIfNeeded(moc: moc)
+        hasAssignedItemPositions = true
+    }
+    
+    private func itemsFetchRequest(predicate: NSPredicate, sortAscending: Bool, fetchLimit: Int?) -> NSFetchRequest<CDArticleTabItem> {
+        let fetchRequest = NSFetchRequest<CDArticleTabItem>(entityName: "CDArticleTabItem")
+        fetchRequest.predicate = predicate
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "position", ascending: sortAscending)]
+        fetchRequest.relationshipKeyPathsForPrefetching = ["page"]
+        if let fetchLimit {
+            fetchRequest.fetchLimit = fetchLimit
+        }
+        return fetchRequest
+    }
+    
+    private func currentItem(tabIdentifier: UUID, moc: NSManagedObjectContext) throws -> CDArticleTabItem? {
+        let predicate = NSPredicate(format: "tab.identifier == %@ AND isCurrent == YES", argumentArray: [tabIdentifier])
+        return try moc.fetch(itemsFetchRequest(predicate: predicate, sortAscending: true, fetchLimit: 1)).first
+    }
+    
+    private func currentItem(in tab: CDArticleTab, moc: NSManagedObjectContext) throws -> CDArticleTabItem? {
+        let predicate = NSPredicate(format: "tab == %@ AND isCurrent == YES", argumentArray: [tab])
+        return try moc.fetch(itemsFetchRequest(predicate: predicate, sortAscending: true, fetchLimit: 1)).first
+    }
+    
+    private func lastItem(in tab: CDArticleTab, moc: NSManagedObjectContext) throws -> CDArticleTabItem? {
+        let predicate = NSPredicate(format: "tab == %@", argumentArray: [tab])
+        return try moc.fetch(itemsFetchRequest(predicate: predicate, sortAscending: false, fetchLimit: 1)).first
+    }
+    
+    private func items(in tab: CDArticleTab, after position: Int64, moc: NSManagedObjectContext) throws -> [CDArticleTabItem] {
+        let predicate = NSPredicate(format: "tab == %@ AND position > %@", argumentArray: [tab, NSNumber(value: position)])
+        return try moc.fetch(itemsFetchRequest(predicate: predicate, sortAscending: true, fetchLimit: nil))
+    }
+    
+    private func item(in tab: CDArticleTab, adjacentTo position: Int64, isPrev: Bool, moc: NSManagedObjectContext) throws -> CDArticleTabItem? {
+        let predicate = NSPredicate(format: isPrev ? "tab == %@ AND position < %@" : "tab == %@ AND position > %@", argumentArray: [tab, NSNumber(value: position)])
+        return try moc.fetch(itemsFetchRequest(predicate: predicate, sortAscending: !isPrev, fetchLimit: 1)).first
+    }
+    
+    private func itemCount(in tab: CDArticleTab, moc: NSManagedObjectContext) throws -> Int {
+        let fetchRequest = NSFetchRequest<CDArticleTabItem>(entityName: "CDArticleTabItem")
+        fetchRequest.predicate = NSPredicate(format: "tab == %@", argumentArray: [tab])
+        return try moc.count(for: fetchRequest)
+    }
+    
     private func tabsCount(moc: NSManagedObjectContext) throws -> Int {
         let fetchRequest = NSFetchRequest<CDArticleTab>(entityName: "CDArticleTab")
         return try moc.count(for: fetchRequest)
@@ -831,6 +894,57 @@ public protocol WMFArticleTabsDataControlling {
         return databaseTabs
     }
     
+    /// Lightweight version of `fetchAllArticleTabs` for the tabs overview. Each tab's `articles` only contains its current article.
+    /// Uses two dictionary fetches (tabs, and current items), so the cost does not grow with the length of each tab's history.
+    public func fetchArticleTabSummaries() async throws -> [WMFArticleTab] {
+        
+        guard let moc = backgroundContext else {
+            throw CustomError.missingContext
+        }
+        
+        return try await moc.perform {
+            let tabsFetchRequest = NSFetchRequest<NSDictionary>(entityName: "CDArticleTab")
+            tabsFetchRequest.resultType = .dictionaryResultType
+            tabsFetchRequest.propertiesToFetch = ["identifier", "timestamp", "isCurrent"]
+            tabsFetchRequest.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: true)]
+            
+            let itemsFetchRequest = NSFetchRequest<NSDictionary>(entityName: "CDArticleTabItem")
+            itemsFetchRequest.resultType = .dictionaryResultType
+            itemsFetchRequest.predicate = NSPredicate(format: "isCurrent == YES AND tab != nil")
+            itemsFetchRequest.propertiesToFetch = ["identifier", "tab.identifier", "page.title", "page.projectID"]
+            
+            var currentArticles: [UUID: WMFArticle] = [:]
+            for item in try moc.fetch(itemsFetchRequest) {
+                guard let tabIdentifier = item["tab.identifier"] as? UUID,
+                      currentArticles[tabIdentifier] == nil,
+                      let identifier = item["identifier"] as? UUID,
+                      let title = item["page.title"] as? String,
+                      let projectID = item["page.projectID"] as? String,
+                      let project = WMFProject(id: projectID) else {
+                    continue
+                }
+                
+                guard let siteURL = project.siteURL,
+                      let articleURL = siteURL.wmfURL(withTitle: title, languageVariantCode: nil) else {
+                    throw CustomError.missingURL
+                }
+                
+                currentArticles[tabIdentifier] = WMFArticle(identifier: identifier, title: title, project: project, articleURL: articleURL)
+            }
+            
+            return try moc.fetch(tabsFetchRequest).compactMap { tab in
+                guard let identifier = tab["identifier"] as? UUID,
+                      let timestamp = tab["timestamp"] as? Date else {
+                    return nil
+                }
+                
+                let isCurrent = (tab["isCurrent"] as? Bool) ?? false
+                let articles = currentArticles[identifier].map { [$0] } ?? []
+                return WMFArticleTab(identifier: identifier, timestamp: timestamp, isCurrent: isCurrent, articles: articles)
+            }
+        }
+    }
+    
     public func saveCurrentStateForLaterRestoration() async throws {
         
         guard let coreDataStore else {
@@ -46,7 +46,8 @@ public final actor WMFFeedDataController: WMFFeedDataControlling {
             return
         }
 
-        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, parameters: [:], acceptType: .json)
+        // Home asks for the same day's feed from several modules, and again on refresh
+        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, parameters: [:], acceptType: .json, coalescing: .inFlightAndMemoized(60))
         basicService.performDecodableGET(request: request) { (result: Result<WMFFeedAPIResponse, Error>) in
             completion(result)
         }
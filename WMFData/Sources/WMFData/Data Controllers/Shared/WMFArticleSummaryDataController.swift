@@ -50,7 +50,7 @@ public actor WMFArticleSummaryDataController: WMFArticleSummaryDataControlling {
             return
         }
 
-        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, acceptType: .json)
+        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, acceptType: .json, coalescing: .inFlight)
         service.performDecodableGET(request: request) { [weak self] (result: Result<WMFArticleSummary, Error>) in
             switch result {
             case .success(let summary):
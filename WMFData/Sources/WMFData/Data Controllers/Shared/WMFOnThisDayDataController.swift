@@ -55,7 +55,7 @@ public actor WMFOnThisDayDataController {
             return
         }
 
-        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, acceptType: .json)
+        let request = WMFBasicServiceRequest(url: url, method: .GET, languageVariantCode: project.languageVariantCode, acceptType: .json, coalescing: .inFlight)
         basicService.performDecodableGET(request: request) { (result: Result<WMFOnThisDayResponse, Error>) in
             completion(result)
         }
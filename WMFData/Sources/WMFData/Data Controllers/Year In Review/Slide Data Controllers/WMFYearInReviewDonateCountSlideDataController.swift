@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewDonateCountSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
     
     let id = WMFYearInReviewPersonalizedSlideID.donateCount.rawValue
@@ -34,6 +34,7 @@ final class YearInReviewDonateCountSlideDataController: YearInReviewSlideDataCon
             return
         }
         donateCount = getDonateCount(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
         
         if let globalUserID,
            let startDate = yirConfig.dataStartDate,
@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewMostReadCategoriesSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
     let id = WMFYearInReviewPersonalizedSlideID.mostReadCategories.rawValue
     let year: Int
@@ -28,6 +28,7 @@ final class YearInReviewMostReadCategoriesSlideDataController: YearInReviewSlide
         }
 
         let categoryCounts = try await WMFCategoriesDataController().fetchCategoryCounts(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
 
         var filtered = categoryCounts
             .filter { key, _ in
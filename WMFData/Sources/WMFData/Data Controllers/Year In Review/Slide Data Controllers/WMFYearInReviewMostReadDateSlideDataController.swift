@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewMostReadDateSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
     let id = WMFYearInReviewPersonalizedSlideID.mostReadDate.rawValue
     let year: Int
@@ -29,6 +29,7 @@ final class YearInReviewMostReadDateSlideDataController: YearInReviewSlideDataCo
         }
         
         let dates = try await WMFPageViewsDataController().fetchPageViewDates(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
         
         if let mostReadHour = dates?.times.sorted(by: { $0.viewCount < $1.viewCount }).first,
            let mostReadDay = dates?.days.sorted(by: { $0.viewCount < $1.viewCount }).first,
@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewSaveCountSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
 
     let id = WMFYearInReviewPersonalizedSlideID.saveCount.rawValue
@@ -28,7 +28,9 @@ final class YearInReviewSaveCountSlideDataController: YearInReviewSlideDataContr
             return
         }
         
-        self.savedData = await savedSlideDataDelegate?.getSavedArticleSlideData(from: startDate, to: endDate)
+        let savedData = await savedSlideDataDelegate?.getSavedArticleSlideData(from: startDate, to: endDate)
+        try Task.checkCancellation()
+        self.savedData = savedData
         
         guard savedData != nil else { return }
         
@@ -1,11 +1,11 @@
 import Foundation
 import CoreData
 
-// Sendable so slide data controllers can cross into the Core Data `perform`
-// closures in WMFYearInReviewDataController. Conformers are classes with a
-// mutable `isEvaluated`, so each conforms via @unchecked Sendable: instances are
-// confined to the sequential populate flow (mutated in a loop, then read once in
-// a single perform closure), so there is no concurrent access in practice.
+// Sendable so slide data controllers can be populated in task group children and
+// cross into the Core Data `perform` closures in WMFYearInReviewDataController.
+// Conformers are classes with a mutable `isEvaluated`, so each conforms via
+// @unchecked Sendable: every instance is populated by exactly one child task and
+// only read again once the group has finished, so there is no concurrent access.
 protocol YearInReviewSlideDataControllerProtocol: Sendable {
     /// A unique identifier for the slide (e.g., readCount, editCount).
     var id: String { get }
@@ -23,6 +23,7 @@ protocol YearInReviewSlideDataControllerProtocol: Sendable {
     static var shouldFreeze: Bool { get }
 
     /// Populate the slide’s data in the background context, using dependencies like saved data, page views, or edit stats.
+    /// Call `Task.checkCancellation()` after each fetch, so a slide that runs past its timeout stops without waiting on more work.
     func populateSlideData(in context: NSManagedObjectContext) async throws
 
     /// Returns an instance of `CDYearInReviewSlide` (used for Core Data storage).
@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewViewCountSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
     let id = WMFYearInReviewPersonalizedSlideID.viewCount.rawValue
     let year: Int
@@ -28,7 +28,9 @@ final class YearInReviewViewCountSlideDataController: YearInReviewSlideDataContr
 
     func populateSlideData(in context: NSManagedObjectContext) async throws {
         guard let userID, let languageCode else { return }
-        viewCount = try await self.fetchEditViews(project: project, userId: userID, language: languageCode)
+        let viewCount = try await self.fetchEditViews(project: project, userId: userID, language: languageCode)
+        try Task.checkCancellation()
+        self.viewCount = viewCount
         isEvaluated = true
     }
 
@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewEditCountSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
 
     let id = WMFYearInReviewPersonalizedSlideID.editCount.rawValue
@@ -36,7 +36,9 @@ final class YearInReviewEditCountSlideDataController: YearInReviewSlideDataContr
         }
         
         let editCountDataController = WMFGlobalEditCountDataController(globalUserID: globalUserID)
-        self.editCount = try await editCountDataController.fetchEditCount(startDate: startDate, endDate: endDate)
+        let editCount = try await editCountDataController.fetchEditCount(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
+        self.editCount = editCount
 
         isEvaluated = true
     }
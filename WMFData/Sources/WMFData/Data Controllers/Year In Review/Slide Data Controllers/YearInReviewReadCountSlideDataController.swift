@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewReadCountSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
 
     let id = WMFYearInReviewPersonalizedSlideID.readCount.rawValue
@@ -32,7 +32,9 @@ final class YearInReviewReadCountSlideDataController: YearInReviewSlideDataContr
         let dataController = try WMFPageViewsDataController()
         
         let readCount = try await dataController.fetchPageViewCounts(startDate: startDate, endDate: endDate).count
+        try Task.checkCancellation()
         let minutesRead = try await dataController.fetchPageViewMinutes(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
         
         readData = WMFYearInReviewReadData(readCount: readCount, minutesRead: minutesRead)
         
@@ -1,8 +1,8 @@
 import CoreData
 
-// @unchecked: `isEvaluated` is mutable, but instances are confined to the sequential
-// populate flow in WMFYearInReviewDataController (mutated in a loop, then read in a
-// single Core Data perform closure) — see YearInReviewSlideDataControllerProtocol.
+// @unchecked: `isEvaluated` is mutable, but each instance is confined to a single
+// child task of the populate task group in WMFYearInReviewDataController, then read
+// in a single Core Data perform closure — see YearInReviewSlideDataControllerProtocol.
 final class YearInReviewTopReadArticleSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
 
     let id = WMFYearInReviewPersonalizedSlideID.topArticles.rawValue
@@ -29,7 +29,9 @@ final class YearInReviewTopReadArticleSlideDataController: YearInReviewSlideData
               let endDate = yirConfig.dataEndDate else {
             throw NSError(domain: "", code: 0, userInfo: nil)
         }
-        if let pageViewCounts = try? await dataController.fetchPageViewCounts(startDate: startDate, endDate: endDate) {
+        let pageViewCounts = try? await dataController.fetchPageViewCounts(startDate: startDate, endDate: endDate)
+        try Task.checkCancellation()
+        if let pageViewCounts {
             let top5 = pageViewCounts
                 .filter { $0.count > 1 }
                 .sorted { $0.count > $1.count }
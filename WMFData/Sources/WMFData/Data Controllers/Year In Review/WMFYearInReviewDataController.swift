@@ -11,6 +11,7 @@ import CoreData
         case alreadyAssignedExperiment
         case notQualifiedForExperiment
         case missingPrimaryAppLanguage
+        case slidePopulationTimedOut
     }
 
     public let coreDataStore: WMFCoreDataStore
@@ -24,6 +25,11 @@ import CoreData
     private let service = WMFDataEnvironment.current.mediaWikiService
     private var dataPopulationBackgroundTaskID: UIBackgroundTaskIdentifier = .invalid
 
+    static let slidePopulationTimeout: TimeInterval = 30
+
+    /// Wall-clock timings from the most recent call to `populateYearInReviewReportData`.
+    public private(set) var lastPopulationMetrics: WMFYearInReviewPopulationMetrics?
+
     struct FeatureAnnouncementStatus: Codable {
         var hasPresentedYiRFeatureAnnouncementModal: Bool
         static var `default`: FeatureAnnouncementStatus {
@@ -435,20 +441,11 @@ import CoreData
             return Set((cdReport?.slides as? Set<CDYearInReviewSlide>)?.compactMap { $0.id } ?? [])
         }
 
-        // For any slide IDs missing, create associated slide data controllers and populate their data. Set evaluated flag if population succeeds
-        var slideDataControllers = try await slideFactory.makeSlideDataControllers(missingFrom: existingIDs)
-        for index in slideDataControllers.indices {
-            do {
-                try await slideDataControllers[index].populateSlideData(in: backgroundContext)
-                slideDataControllers[index].isEvaluated = true
-            } catch {
-                slideDataControllers[index].isEvaluated = false
-            }
-        }
+        // For any slide IDs missing, create associated slide data controllers and populate their data concurrently. Set evaluated flag if population succeeds
+        let slideDataControllers = try await slideFactory.makeSlideDataControllers(missingFrom: existingIDs)
+        let metrics = await populateSlideData(for: slideDataControllers, in: backgroundContext)
+        lastPopulationMetrics = metrics
 
-        // Snapshot the evaluated controllers into a `let` so the @Sendable perform
-        // closure below captures an immutable binding rather than the mutable
-        // `slideDataControllers` var.
         let evaluatedSlideDataControllers = slideDataControllers.filter { $0.isEvaluated }
 
         // Create new core data slides from evaluated data controllers, save to core data report and return generic report struct
@@ -496,6 +493,61 @@ import CoreData
         return report
     }
 
+    /// Populates each slide data controller in its own child task, so the independent network and Core Data workloads overlap instead of running back to back.
+    /// Slides share the given context for reads only; all writes happen afterwards in the single save of `populateYearInReviewReportData`.
+    /// A slide that throws or does not finish within `slideTimeout` seconds is left unevaluated and dropped from the report.
+    func populateSlideData(for slideDataControllers: [YearInReviewSlideDataControllerProtocol], in context: NSManagedObjectContext, slideTimeout: TimeInterval = WMFYearInReviewDataController.slidePopulationTimeout) async -> WMFYearInReviewPopulationMetrics {
+
+        let start = Date()
+
+        let results = await withTaskGroup(of: (index: Int, isEvaluated: Bool, duration: TimeInterval).self) { group in
+            for (index, slideDataController) in slideDataControllers.enumerated() {
+                group.addTask {
+                    let slideStart = Date()
+                    let isEvaluated: Bool
+                    do {
+                        try await Self.populate(slideDataController, in: context, timeout: slideTimeout)
+                        isEvaluated = true
+                    } catch {
+                        isEvaluated = false
+                    }
+                    return (index, isEvaluated, Date().timeIntervalSince(slideStart))
+                }
+            }
+
+            var results: [(index: Int, isEvaluated: Bool, duration: TimeInterval)] = []
+            for await result in group { results.append(result) }
+            return results
+        }
+
+        // Each controller was only touched by its own child task, and the group has finished, so it is safe to write the flags here.
+        var slideDurations: [String: TimeInterval] = [:]
+        for result in results {
+            var slideDataController = slideDataControllers[result.index]
+            slideDataController.isEvaluated = result.isEvaluated
+            slideDurations[slideDataController.id] = result.duration
+        }
+
+        return WMFYearInReviewPopulationMetrics(slideDurations: slideDurations, totalDuration: Date().timeIntervalSince(start))
+    }
+
+    /// Races slide population against a timer. When the timer wins, the slide is cancelled and the group waits for it to stop, so nothing outlives this call.
+    /// Slides check for cancellation after each fetch, so a timed out slide stops once its current fetch returns. The wall time is bounded by `timeout` plus the longest single fetch, not by `timeout` alone.
+    private static func populate(_ slideDataController: YearInReviewSlideDataControllerProtocol, in context: NSManagedObjectContext, timeout: TimeInterval) async throws {
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            group.addTask {
+                try await slideDataController.populateSlideData(in: context)
+            }
+            group.addTask {
+                try await Task.sleep(for: .seconds(timeout))
+                throw CustomError.slidePopulationTimedOut
+            }
+
+            defer { group.cancelAll() }
+            try await group.next()
+        }
+    }
+
     public func fetchYearInReviewReport(forYear year: Int) throws -> WMFYearInReviewReport? {
         assert(Thread.isMainThread, "This report must be called from the main thread in order to keep it synchronous")
 
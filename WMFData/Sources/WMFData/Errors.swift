@@ -35,6 +35,12 @@ enum WMFCoreDataStoreError: Error {
     case setupMissingPersistentContainer
     case missingEntity
     case unexpectedFetchGroupResult
+    case sqliteFailure(code: Int32)
+}
+
+public enum WMFOfflineSearchIndexError: Error {
+    case sqliteFailure(code: Int32)
+    case missingDocumentID
 }
 
 public enum WMFDonateDataControllerError: LocalizedError {
@@ -0,0 +1,24 @@
+import Foundation
+
+/// Wall-clock timings for one Year in Review report population pass.
+public struct WMFYearInReviewPopulationMetrics: Sendable, CustomStringConvertible {
+
+    /// Time spent populating each slide, keyed by slide ID. Slides run concurrently, so these overlap.
+    public let slideDurations: [String: TimeInterval]
+
+    /// Time from the first slide starting to the last slide finishing.
+    public let totalDuration: TimeInterval
+
+    /// What the same pass would have cost if slides had been populated one after another.
+    public var sequentialDuration: TimeInterval {
+        return slideDurations.values.reduce(0, +)
+    }
+
+    public var description: String {
+        let slides = slideDurations
+            .sorted { $0.key < $1.key }
+            .map { String(format: "%@: %.3fs", $0.key, $0.value) }
+            .joined(separator: ", ")
+        return String(format: "total %.3fs (sequential %.3fs) [%@]", totalDuration, sequentialDuration, slides)
+    }
+}
@@ -4,9 +4,19 @@ import Foundation
 public final class WMFBasicService: WMFService {
     
     private let urlSession: WMFURLSession
+    private let coalescer: WMFRequestCoalescer
+
+    /// Shared across requests; decoding does not mutate it, so there is no need to allocate one per response.
+    private static let decoder = JSONDecoder()
+
+    /// Hit, miss and coalesce counts for GET requests that opted in to coalescing.
+    public var requestStatistics: WMFRequestCoalescer.Statistics {
+        return coalescer.statistics
+    }
     
     public init(urlSession: WMFURLSession = URLSession.shared) {
         self.urlSession = urlSession
+        self.coalescer = WMFRequestCoalescer()
     }
     
     public func perform<R: WMFServiceRequest>(request: R, completion: @escaping (Result<Data, Error>) -> Void) {
@@ -181,42 +191,55 @@ public final class WMFBasicService: WMFService {
 
         let attemptedURLString = urlRequest.url?.absoluteString
         let attemptedMethod = request.method.rawValue
-        let task = urlSession.wmfDataTask(with: urlRequest) { data, response, error in
-            
-            if let error {
-                completion(nil, nil, error)
-                return
-            }
+        let urlSession = self.urlSession
 
-            guard let httpResponse = response as? HTTPURLResponse else {
-                completion(nil, nil, WMFServiceError.invalidHttpResponse(nil))
-                return
-            }
-            
-            guard httpResponse.isSuccessStatusCode else {
-                if httpResponse.isHTTPError {
-                    WMFDataEnvironment.current.httpErrorLogger?(
-                        WMFHTTPErrorInfo(
-                            statusCode: httpResponse.statusCode,
-                            method: attemptedMethod,
-                            url: attemptedURLString,
-                            source: "WMFBasicService"
-                        )
-                    )
+        let start: (@escaping (Data?, URLResponse?, Error?) -> Void) -> Void = { completion in
+            let task = urlSession.wmfDataTask(with: urlRequest) { data, response, error in
+                
+                if let error {
+                    completion(nil, nil, error)
+                    return
                 }
 
-                completion(nil, nil, WMFServiceError.invalidHttpResponse(httpResponse.statusCode))
-                return
-            }
-            
-            guard let data = data else {
-                completion(nil, nil, WMFServiceError.missingData)
-                return
+                guard let httpResponse = response as? HTTPURLResponse else {
+                    completion(nil, nil, WMFServiceError.invalidHttpResponse(nil))
+                    return
+                }
+                
+                guard httpResponse.isSuccessStatusCode else {
+                    if httpResponse.isHTTPError {
+                        WMFDataEnvironment.current.httpErrorLogger?(
+                            WMFHTTPErrorInfo(
+                                statusCode: httpResponse.statusCode,
+                                method: attemptedMethod,
+                                url: attemptedURLString,
+                                source: "WMFBasicService"
+                            )
+                        )
+                    }
+
+                    completion(nil, nil, WMFServiceError.invalidHttpResponse(httpResponse.statusCode))
+                    return
+                }
+                
+                guard let data = data else {
+                    completion(nil, nil, WMFServiceError.missingData)
+                    return
+                }
+                
+                completion(data, response, error)
             }
-            
-            completion(data, response, error)
+            task.resume()
+        }
+
+        switch basicRequest.coalescing {
+        case .none:
+            start(completion)
+        case .inFlight:
+            coalescer.perform(urlRequest, completion: completion, start: start)
+        case .inFlightAndMemoized(let memoTTL):
+            coalescer.perform(urlRequest, memoTTL: memoTTL, completion: completion, start: start)
         }
-        task.resume()
     }
     
     public func performDecodableGET<R: WMFServiceRequest, T: Decodable>(request: R, completion: @escaping (Result<T, Error>) -> Void) {
@@ -234,8 +257,7 @@ public final class WMFBasicService: WMFService {
             }
             
             do {
-                let decoder = JSONDecoder()
-                let result: T = try decoder.decode(T.self, from: data)
+                let result: T = try Self.decoder.decode(T.self, from: data)
                 completion(.success(result))
             } catch let error {
                 completion(.failure(error))
@@ -258,8 +280,7 @@ public final class WMFBasicService: WMFService {
             }
             
             do {
-                let decoder = JSONDecoder()
-                let result: T = try decoder.decode(T.self, from: data)
+                let result: T = try Self.decoder.decode(T.self, from: data)
                 completion(.success(result))
             } catch let error {
                 completion(.failure(error))
@@ -269,6 +290,7 @@ public final class WMFBasicService: WMFService {
     
     public func clearCachedData() {
         urlSession.clearCachedData()
+        coalescer.removeAllMemoizedResponses()
     }
 }
 
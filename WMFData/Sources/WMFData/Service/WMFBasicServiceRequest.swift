@@ -11,6 +11,15 @@ public struct WMFBasicServiceRequest: WMFServiceRequest {
         case json
         case none
     }
+
+    /// Whether a GET can share its response with identical GETs. Only opt in when identical requests should get identical responses, so never for endpoints like random articles.
+    public enum Coalescing {
+        case none
+        /// Concurrent identical GETs share one data task.
+        case inFlight
+        /// As `inFlight`, and a successful response is also reused for the given number of seconds.
+        case inFlightAndMemoized(TimeInterval)
+    }
     
     public let url: URL?
     public let method: WMFServiceRequestMethod
@@ -18,13 +27,15 @@ public struct WMFBasicServiceRequest: WMFServiceRequest {
     public let parameters: [String: Any]?
     public var contentType: ContentType?
     public var acceptType: AcceptType
+    public var coalescing: Coalescing
 
-    internal init(url: URL? = nil, method: WMFServiceRequestMethod, languageVariantCode: String? = nil, parameters: [String : Any]? = nil, contentType: ContentType? = nil, acceptType: AcceptType) {
+    internal init(url: URL? = nil, method: WMFServiceRequestMethod, languageVariantCode: String? = nil, parameters: [String : Any]? = nil, contentType: ContentType? = nil, acceptType: AcceptType, coalescing: Coalescing = .none) {
         self.url = url
         self.method = method
         self.languageVariantCode = languageVariantCode
         self.parameters = parameters
         self.contentType = contentType
         self.acceptType = acceptType
+        self.coalescing = coalescing
     }
 }
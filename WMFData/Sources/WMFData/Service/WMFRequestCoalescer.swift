@@ -0,0 +1,134 @@
+import Foundation
+
+/// Attaches concurrent callers asking for the same GET to a single in-flight data task, and optionally memoizes successful responses for a short time.
+/// Callers opt in per request, see `WMFBasicServiceRequest.Coalescing`.
+/// Requests are keyed by their canonical URL and headers, so two requests only share a response if the server would see them as identical.
+public final class WMFRequestCoalescer: @unchecked Sendable {
+
+    public typealias Completion = (Data?, URLResponse?, Error?) -> Void
+
+    public struct Statistics: Equatable, Sendable {
+        /// Requests answered from the memo cache without touching the network.
+        public var hits: Int = 0
+        /// Requests that started a new data task.
+        public var misses: Int = 0
+        /// Requests that attached to a data task already in flight.
+        public var coalesced: Int = 0
+    }
+
+    struct Key: Hashable {
+        let url: String
+        let headers: [String: String]
+
+        init?(urlRequest: URLRequest) {
+            guard let url = urlRequest.url?.absoluteString else {
+                return nil
+            }
+
+            self.url = url
+            var headers: [String: String] = [:]
+            for (name, value) in urlRequest.allHTTPHeaderFields ?? [:] {
+                headers[name.lowercased()] = value
+            }
+            self.headers = headers
+        }
+    }
+
+    private struct MemoEntry {
+        let data: Data
+        let response: URLResponse?
+        let expirationDate: Date
+    }
+
+    private let memoCountLimit: Int
+
+    private let lock = NSLock()
+    private var inFlightCompletions: [Key: [Completion]] = [:]
+    private var memo: [Key: MemoEntry] = [:]
+    private var _statistics = Statistics()
+
+    public var statistics: Statistics {
+        lock.withLock { _statistics }
+    }
+
+    public init(memoCountLimit: Int = 100) {
+        self.memoCountLimit = memoCountLimit
+    }
+
+    /// Calls `start` only if no matching request is memoized or already in flight. `start` must call its argument exactly once with the task result.
+    /// - Parameters:
+    ///   - memoTTL: How long a successful response is reused. Zero only shares the response with requests in flight at the same time.
+    ///   - completion: Called on a background queue, like a data task's completion handler, including when the response is memoized.
+    public func perform(_ urlRequest: URLRequest, memoTTL: TimeInterval = 0, completion: @escaping Completion, start: (@escaping Completion) -> Void) {
+
+        guard let key = Key(urlRequest: urlRequest) else {
+            start(completion)
+            return
+        }
+
+        lock.lock()
+
+        if let entry = memo[key] {
+            if entry.expirationDate > Date() {
+                _statistics.hits += 1
+                lock.unlock()
+                // Like a data task, never call back before `perform` returns
+                DispatchQueue.global(qos: .userInitiated).async {
+                    completion(entry.data, entry.response, nil)
+                }
+                return
+            }
+            memo[key] = nil
+        }
+
+        if inFlightCompletions[key] != nil {
+            inFlightCompletions[key]?.append(completion)
+            _statistics.coalesced += 1
+            lock.unlock()
+            return
+        }
+
+        inFlightCompletions[key] = [completion]
+        _statistics.misses += 1
+        lock.unlock()
+
+        start { data, response, error in
+            let completions = self.finish(key: key, memoTTL: memoTTL, data: data, response: response, error: error)
+            for completion in completions {
+                completion(data, response, error)
+            }
+        }
+    }
+
+    public func removeAllMemoizedResponses() {
+        lock.withLock {
+            memo.removeAll()
+        }
+    }
+
+    public func resetStatistics() {
+        lock.withLock {
+            _statistics = Statistics()
+        }
+    }
+
+    private func finish(key: Key, memoTTL: TimeInterval, data: Data?, response: URLResponse?, error: Error?) -> [Completion] {
+        lock.withLock {
+            let completions = inFlightCompletions.removeValue(forKey: key) ?? []
+
+            if memoTTL > 0, error == nil, let data {
+                let now = Date()
+                if memo.count >= memoCountLimit {
+                    memo = memo.filter { $0.value.expirationDate > now }
+                }
+                if memo.count >= memoCountLimit,
+                   let oldest = memo.min(by: { $0.value.expirationDate < $1.value.expirationDate })?.key {
+                    memo[oldest] = nil
+                }
+                memo[key] = MemoEntry(data: data, response: response, expirationDate: now.addingTimeInterval(memoTTL))
+            }
+
+            return completions
+        }
+    }
+}
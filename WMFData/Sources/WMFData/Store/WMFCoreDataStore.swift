@@ -4,6 +4,18 @@ import CoreData
 public final class WMFCoreDataStore: @unchecked Sendable {
 
     private let appContainerURL: URL
+    private let databaseFileURL: URL
+
+    /// Objects deleted per save during housekeeping. Keeps each save, and the memory it needs, small.
+    static let housekeepingChunkSize = 500
+
+    /// Default time a single housekeeping run may take. Work left over is resumed by the next run.
+    public static let housekeepingTimeBudget: TimeInterval = 20
+
+    /// Pages released per incremental vacuum step, so the time budget is checked between steps.
+    private static let incrementalVacuumPageStep = 256
+
+    private static let maintenanceQueue = DispatchQueue(label: "org.wikimedia.wmfdata.sqliteMaintenance", qos: .utility)
 
     // Will only be populated if persistent stores load correctly
     private var persistentContainer: NSPersistentContainer?
@@ -20,6 +32,7 @@ public final class WMFCoreDataStore: @unchecked Sendable {
         let databaseFileName = "WMFData.sqlite"
         var databaseFileURL = appContainerURL
         databaseFileURL.appendPathComponent(databaseFileName, isDirectory: false)
+        self.databaseFileURL = databaseFileURL
 
         guard let dataModelFileURL = Bundle.module.url(forResource: dataModelName, withExtension: "momd") else {
             throw WMFCoreDataStoreError.setupMissingDataModelFileURL
@@ -33,6 +46,11 @@ public final class WMFCoreDataStore: @unchecked Sendable {
         description.shouldAddStoreAsynchronously = true
         description.setOption(true as NSNumber, forKey: NSMigratePersistentStoresAutomaticallyOption)
         description.setOption(true as NSNumber, forKey: NSInferMappingModelAutomaticallyOption)
+        description.setOption(["auto_vacuum": "INCREMENTAL"] as NSDictionary, forKey: NSSQLitePragmasOption)
+        // The auto_vacuum pragma only applies to existing stores once the file is rebuilt. Have Core Data rebuild it while loading, before any context uses it, and only for stores that have not been converted yet.
+        if await Self.storeNeedsIncrementalAutoVacuumConversion(databaseFileURL: databaseFileURL) {
+            description.setOption(true as NSNumber, forKey: NSSQLiteManualVacuumOption)
+        }
 
         let container = NSPersistentContainer(name: dataModelName, managedObjectModel: dataModel)
         container.persistentStoreDescriptions = [description]
@@ -42,6 +60,24 @@ public final class WMFCoreDataStore: @unchecked Sendable {
         try await loadPersistentStores()
     }
 
+    /// Reading the mode only opens the file and reads its header page, and this store has no Core Data connections yet to wait on. Another process holding a lock could still make it wait out the busy timeout, so it runs on the maintenance queue rather than blocking the caller's thread.
+    private static func storeNeedsIncrementalAutoVacuumConversion(databaseFileURL: URL) async -> Bool {
+        guard FileManager.default.fileExists(atPath: databaseFileURL.path) else {
+            return false
+        }
+
+        return await withCheckedContinuation { continuation in
+            maintenanceQueue.async {
+                do {
+                    let maintenance = try WMFSQLiteMaintenance(fileURL: databaseFileURL)
+                    continuation.resume(returning: try maintenance.autoVacuumMode != .incremental)
+                } catch {
+                    continuation.resume(returning: false)
+                }
+            }
+        }
+    }
+
     private func loadPersistentStores() async throws {
         guard let persistentContainer else {
             throw WMFCoreDataStoreError.setupMissingPersistentContainer
@@ -153,7 +189,58 @@ public final class WMFCoreDataStore: @unchecked Sendable {
         }
     }
 
-    public func performDatabaseHousekeeping() async throws {
+    /// Prunes old and orphaned records in small chunks, then compacts the store file.
+    /// Stops starting new work once `timeBudget` has passed or the calling task is cancelled. Retention rules are expressed as predicates, so the next run resumes wherever this one stopped.
+    /// Throws only if pruning fails. A compaction failure is reported in the returned report, since the deletions it follows have already been saved.
+    @discardableResult
+    public func performDatabaseHousekeeping(timeBudget: TimeInterval = WMFCoreDataStore.housekeepingTimeBudget) async throws -> WMFDatabaseHousekeepingReport {
+
+        let startDate = Date()
+        let deadline = startDate.addingTimeInterval(timeBudget)
+        let fileSizeBefore = databaseFileSize()
+
+        var deletedObjectCounts: [String: Int] = [:]
+        var isRetentionComplete = true
+
+        let backgroundContext = try newBackgroundContext
+        for rule in housekeepingRetentionRules() {
+            let result = try await deleteInChunks(entityName: rule.entityName, predicate: rule.predicate, deadline: deadline, in: backgroundContext)
+            deletedObjectCounts[rule.entityName] = result.deletedCount
+
+            guard result.isComplete else {
+                isRetentionComplete = false
+                break
+            }
+        }
+
+        var pagesFreed = 0
+        var compactionError: Error?
+        do {
+            pagesFreed = try await compactDatabaseFile(deadline: deadline)
+        } catch {
+            compactionError = error
+        }
+
+        return WMFDatabaseHousekeepingReport(
+            deletedObjectCounts: deletedObjectCounts,
+            isRetentionComplete: isRetentionComplete,
+            fileSizeBefore: fileSizeBefore,
+            fileSizeAfter: databaseFileSize(),
+            pagesFreed: pagesFreed,
+            compactionErrorDescription: compactionError.map { String(describing: $0) },
+            duration: Date().timeIntervalSince(startDate)
+        )
+    }
+
+    // MARK: - Housekeeping
+
+    private struct RetentionRule {
+        let entityName: String
+        let predicate: NSPredicate
+    }
+
+    /// Rules run in order: deleting page views leaves pages empty, and deleting pages leaves categories and topics orphaned.
+    private func housekeepingRetentionRules() -> [RetentionRule] {
 
         let currentYear = Calendar.current.component(.year, from: Date())
         var dateComponents = DateComponents()
@@ -162,56 +249,105 @@ public final class WMFCoreDataStore: @unchecked Sendable {
         dateComponents.month = 1
 
         guard let oneYearAgoDate = Calendar.current.date(from: dateComponents) else {
-            return
+            return []
         }
 
-        let backgroundContext = try newBackgroundContext
-        try await backgroundContext.perform { [weak self] in
+        let timestamp = NSPredicate(format: "timestamp < %@", argumentArray: [oneYearAgoDate])
+        let emptyPageViewsPredicate = NSPredicate(format: "pageViews.@count == 0")
+        let emptyArticleTabItemsPredicate = NSPredicate(format: "articleTabItems.@count == 0")
+        let savedPageInfoPredicate = NSPredicate(format: "savedInfo == nil")
+
+        return [
+            // CDPageViews that were added > one year ago
+            RetentionRule(entityName: NSStringFromClass(CDPageView.self), predicate: timestamp),
+            // CDPages that have no page views, no article tab items, are not saved, and were added > one year ago
+            RetentionRule(entityName: NSStringFromClass(CDPage.self), predicate: NSCompoundPredicate(andPredicateWithSubpredicates: [timestamp, emptyPageViewsPredicate, emptyArticleTabItemsPredicate, savedPageInfoPredicate])),
+            // CDCategorys that have empty pages
+            RetentionRule(entityName: NSStringFromClass(CDCategory.self), predicate: NSPredicate(format: "pages.@count == 0")),
+            // CDPageTopics whose page is gone
+            RetentionRule(entityName: NSStringFromClass(CDPageTopic.self), predicate: NSPredicate(format: "page == nil")),
+            // CDYearInReviewSlides whose report is gone
+            RetentionRule(entityName: NSStringFromClass(CDYearInReviewSlide.self), predicate: NSPredicate(format: "report == nil"))
+        ]
+    }
 
-            try autoreleasepool {
+    /// Deletes matching objects `housekeepingChunkSize` at a time, saving and resetting the context after each chunk so memory stays flat and other work on the store can interleave.
+    private func deleteInChunks(entityName: String, predicate: NSPredicate, deadline: Date, in moc: NSManagedObjectContext) async throws -> (deletedCount: Int, isComplete: Bool) {
 
-                guard let self else { return }
+        let chunkSize = Self.housekeepingChunkSize
+        var deletedCount = 0
 
-                // Delete CDPageViews that were added > one year ago
-                let timestamp = NSPredicate(format: "timestamp < %@", argumentArray: [oneYearAgoDate])
+        while Date() < deadline && !Task.isCancelled {
+            let chunkCount = try await moc.perform { [weak self] in
+                try autoreleasepool {
+                    guard let self else { return 0 }
 
-                guard let pageViewsToDelete = try self.fetch(entityType: CDPageView.self, predicate: timestamp, fetchLimit: 2000, in: backgroundContext) else {
-                    return
-                }
+                    let fetchRequest = NSFetchRequest<NSManagedObject>(entityName: entityName)
+                    fetchRequest.predicate = predicate
+                    fetchRequest.fetchLimit = chunkSize
+                    fetchRequest.includesPropertyValues = false
 
-                for pageView in pageViewsToDelete {
-                    backgroundContext.delete(pageView)
+                    let objects = try moc.fetch(fetchRequest)
+                    for object in objects {
+                        moc.delete(object)
+                    }
+
+                    try self.saveIfNeeded(moc: moc)
+                    moc.reset()
+                    return objects.count
                 }
+            }
 
-                let emptyPageViewsPredicate = NSPredicate(format: "pageViews.@count == 0")
-                let emptyArticleTabItemsPredicate = NSPredicate(format: "articleTabItems.@count == 0")
-                let savedPageInfoPredicate = NSPredicate(format: "savedInfo == nil")
+            deletedCount += chunkCount
 
-                let compoundPredicate = NSCompoundPredicate(andPredicateWithSubpredicates: [timestamp, emptyPageViewsPredicate, emptyArticleTabItemsPredicate, savedPageInfoPredicate])
+            if chunkCount < chunkSize {
+                return (deletedCount, true)
+            }
+        }
 
-                // Delete CDPages that have no page views, no article tab items, and were added > one year ago
-                guard let pagesToDelete = try self.fetch(entityType: CDPage.self, predicate: compoundPredicate, fetchLimit: 2000, in: backgroundContext) else {
-                    return
-                }
+        return (deletedCount, false)
+    }
 
-                for page in pagesToDelete {
-                    backgroundContext.delete(page)
-                }
+    /// Checkpoints the WAL and releases free pages in steps until none are left or the deadline passes. Returns the number of pages freed.
+    /// Stores are converted to incremental auto-vacuum when they load, so this never rebuilds the whole file. A store that is somehow still not incremental is left alone.
+    private func compactDatabaseFile(deadline: Date) async throws -> Int {
 
-                // Delete CDCategorys that have empty pages
-                let emptyPagesPredicate = NSPredicate(format: "pages.@count == 0")
-                guard let categoriesToDelete = try self.fetch(entityType: CDCategory.self, predicate: emptyPagesPredicate, fetchLimit: nil, in: backgroundContext) else {
-                    return
-                }
+        let databaseFileURL = self.databaseFileURL
+        let pageStep = Self.incrementalVacuumPageStep
 
-                for category in categoriesToDelete {
-                    backgroundContext.delete(category)
-                }
+        return try await withCheckedThrowingContinuation { continuation in
+            Self.maintenanceQueue.async {
+                do {
+                    let maintenance = try WMFSQLiteMaintenance(fileURL: databaseFileURL)
+                    try maintenance.checkpoint()
+
+                    let pageCountBefore = try maintenance.pageCount
+
+                    if try maintenance.autoVacuumMode == .incremental {
+                        while Date() < deadline, try maintenance.freelistCount > 0 {
+                            try maintenance.incrementalVacuum(pageLimit: pageStep)
+                        }
+                    }
 
-                try self.saveIfNeeded(moc: backgroundContext)
+                    // Vacuuming writes to the WAL, so checkpoint again to shrink it.
+                    try maintenance.checkpoint()
+
+                    let pagesFreed = max(0, pageCountBefore - (try maintenance.pageCount))
+                    continuation.resume(returning: pagesFreed)
+                } catch {
+                    continuation.resume(throwing: error)
+                }
             }
         }
     }
+
+    private func databaseFileSize() -> Int64 {
+        let walFileURL = URL(fileURLWithPath: databaseFileURL.path + "-wal")
+        return [databaseFileURL, walFileURL].reduce(Int64(0)) { total, fileURL in
+            let size = (try? FileManager.default.attributesOfItem(atPath: fileURL.path)[.size] as? NSNumber)?.int64Value ?? 0
+            return total + size
+        }
+    }
 }
 
 extension String {
@@ -0,0 +1,39 @@
+import Foundation
+
+/// Summary of a single `WMFCoreDataStore.performDatabaseHousekeeping` run.
+public struct WMFDatabaseHousekeepingReport: Sendable, CustomStringConvertible {
+
+    /// Number of objects deleted this run, keyed by entity name. Entities the run did not reach before its time budget ran out are missing.
+    public let deletedObjectCounts: [String: Int]
+
+    /// False if the time budget ran out or the run was cancelled before every retention rule finished. The next run picks up where this one stopped.
+    public let isRetentionComplete: Bool
+
+    /// Size in bytes of the store file and its WAL, before and after the run.
+    public let fileSizeBefore: Int64
+    public let fileSizeAfter: Int64
+
+    /// Database pages returned to the file system by vacuuming.
+    public let pagesFreed: Int
+
+    /// Set if compacting the store file failed. Pruning still completed as reported, and compaction is retried on the next run.
+    public let compactionErrorDescription: String?
+
+    public let duration: TimeInterval
+
+    public var deletedObjectCount: Int {
+        return deletedObjectCounts.values.reduce(0, +)
+    }
+
+    public var description: String {
+        let counts = deletedObjectCounts
+            .sorted { $0.key < $1.key }
+            .map { "\($0.key): \($0.value)" }
+            .joined(separator: ", ")
+        let byteCountFormatter = ByteCountFormatter()
+        let sizeBefore = byteCountFormatter.string(fromByteCount: fileSizeBefore)
+        let sizeAfter = byteCountFormatter.string(fromByteCount: fileSizeAfter)
+        let compaction = compactionErrorDescription.map { "compaction failed (\($0))" } ?? "\(pagesFreed) pages freed"
+        return "deleted [\(counts)], retention \(isRetentionComplete ? "complete" : "incomplete"), size \(sizeBefore) -> \(sizeAfter), \(compaction), \(String(format: "%.2f", duration))s"
+    }
+}
@@ -0,0 +1,300 @@
+import Foundation
+import SQLite3
+
+/// A full-text index of articles available offline, kept in its own SQLite file using FTS5.
+/// Text is indexed as given, so callers strip markup before adding a document. Results are ranked with BM25, weighting title matches above body matches, and come with a snippet of the best matching passage.
+/// Calls block on a private serial queue, so use it off the main thread.
+public final class WMFOfflineSearchIndex: @unchecked Sendable {
+
+    public struct Document: Sendable {
+        public let key: String
+        public let languageCode: String
+        public let title: String
+        public let text: String
+
+        public init(key: String, languageCode: String, title: String, text: String) {
+            self.key = key
+            self.languageCode = languageCode
+            self.title = title
+            self.text = text
+        }
+    }
+
+    public struct Result: Sendable, Equatable {
+        public let key: String
+        public let languageCode: String
+        public let title: String
+
+        /// The best matching passage of the document's text, with an ellipsis where it was cut
+        public let snippet: String
+
+        /// Ranges in `snippet` of the words that matched the search
+        public let highlightedRanges: [NSRange]
+    }
+
+    /// Bumped whenever the schema changes. The index is rebuilt from scratch rather than migrated, as it only holds derived data.
+    private static let schemaVersion = 1
+
+    // Private use characters mark highlights in snippets, as they can't appear in article text
+    private static let highlightStart: unichar = 0xE000
+    private static let highlightEnd: unichar = 0xE001
+    private static let snippetTokenCount = 24
+
+    private static let titleWeight = 10.0
+    private static let textWeight = 1.0
+
+    private let queue = DispatchQueue(label: "org.wikimedia.wikipedia.offlineSearchIndex")
+    private var database: OpaquePointer?
+
+    public init(fileURL: URL) throws {
+        let flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX
+        let result = sqlite3_open_v2(fileURL.path, &database, flags, nil)
+        guard result == SQLITE_OK else {
+            sqlite3_close(database)
+            database = nil
+            throw WMFOfflineSearchIndexError.sqliteFailure(code: result)
+        }
+
+        do {
+            try execute("PRAGMA journal_mode = WAL")
+            try execute("PRAGMA synchronous = NORMAL")
+            try setUpSchema()
+        } catch {
+            sqlite3_close(database)
+            database = nil
+            throw error
+        }
+    }
+
+    deinit {
+        sqlite3_close(database)
+    }
+
+    // MARK: - Public
+
+    /// Adds the document, replacing any earlier version with the same key
+    public func add(_ document: Document) throws {
+        try add([document])
+    }
+
+    /// Adds the documents in a single transaction, which is much faster than adding them one at a time when building a large index
+    public func add(_ documents: [Document]) throws {
+        try queue.sync {
+            try inTransaction {
+                for document in documents {
+                    try insert(document)
+                }
+            }
+        }
+    }
+
+    public func remove(key: String) throws {
+        try queue.sync {
+            try inTransaction {
+                try execute("DELETE FROM document_text WHERE rowid = (SELECT id FROM documents WHERE key = ?1)", bindings: [.text(key)])
+                try execute("DELETE FROM documents WHERE key = ?1", bindings: [.text(key)])
+            }
+        }
+    }
+
+    public func removeAll() throws {
+        try queue.sync {
+            try inTransaction {
+                try execute("DELETE FROM document_text")
+                try execute("DELETE FROM documents")
+            }
+        }
+    }
+
+    public var documentCount: Int {
+        get throws {
+            try queue.sync {
+                var count = 0
+                try query("SELECT count(*) FROM documents") { statement in
+                    count = Int(sqlite3_column_int64(statement, 0))
+                }
+                return count
+            }
+        }
+    }
+
+    /// Returns the best matches for `term`, treating its last word as a prefix so results keep up while the user types
+    /// - Parameter languageCode: Only return documents in this language, or from every language if nil
+    public func search(_ term: String, languageCode: String? = nil, limit: Int = 20) throws -> [Result] {
+        guard let matchExpression = Self.matchExpression(for: term) else {
+            return []
+        }
+
+        let sql = """
+            SELECT documents.key, documents.language_code, document_text.title,
+                   snippet(document_text, 1, char(\(Self.highlightStart)), char(\(Self.highlightEnd)), '…', \(Self.snippetTokenCount))
+            FROM document_text JOIN documents ON documents.id = document_text.rowid
+            WHERE document_text MATCH ?1 AND (?2 IS NULL OR documents.language_code = ?2)
+            ORDER BY bm25(document_text, \(Self.titleWeight), \(Self.textWeight))
+            LIMIT ?3
+            """
+
+        return try queue.sync {
+            var results: [Result] = []
+            try query(sql, bindings: [.text(matchExpression), languageCode.map { .text($0) } ?? .null, .integer(Int64(limit))]) { statement in
+                let (snippet, highlightedRanges) = Self.snippetAndHighlightedRanges(from: Self.string(from: statement, column: 3))
+                results.append(Result(
+                    key: Self.string(from: statement, column: 0),
+                    languageCode: Self.string(from: statement, column: 1),
+                    title: Self.string(from: statement, column: 2),
+                    snippet: snippet,
+                    highlightedRanges: highlightedRanges
+                ))
+            }
+            return results
+        }
+    }
+
+    // MARK: - Query Building
+
+    /// Quotes each word so punctuation in the term can't be read as FTS5 query syntax, and makes the last word a prefix query
+    static func matchExpression(for term: String) -> String? {
+        let words = term.components(separatedBy: .whitespacesAndNewlines).filter { !$0.isEmpty }
+        guard !words.isEmpty else {
+            return nil
+        }
+
+        return words.enumerated().map { index, word in
+            let quotedWord = "\"" + word.replacingOccurrences(of: "\"", with: "\"\"") + "\""
+            return index == words.count - 1 ? quotedWord + "*" : quotedWord
+        }.joined(separator: " ")
+    }
+
+    /// Removes the highlight markers from an FTS5 snippet, returning the plain snippet and where the markers were
+    static func snippetAndHighlightedRanges(from markedSnippet: String) -> (String, [NSRange]) {
+        let units = Array(markedSnippet.utf16)
+        var plainUnits: [unichar] = []
+        plainUnits.reserveCapacity(units.count)
+        var highlightedRanges: [NSRange] = []
+        var highlightStartLocation: Int?
+
+        for unit in units {
+            switch unit {
+            case highlightStart:
+                highlightStartLocation = plainUnits.count
+            case highlightEnd:
+                if let location = highlightStartLocation, plainUnits.count > location {
+                    highlightedRanges.append(NSRange(location: location, length: plainUnits.count - location))
+                }
+                highlightStartLocation = nil
+            default:
+                plainUnits.append(unit)
+            }
+        }
+
+        return (String(utf16CodeUnits: plainUnits, count: plainUnits.count), highlightedRanges)
+    }
+
+    // MARK: - Private
+
+    private enum Binding {
+        case text(String)
+        case integer(Int64)
+        case null
+    }
+
+    private func setUpSchema() throws {
+        var version = 0
+        try query("PRAGMA user_version") { statement in
+            version = Int(sqlite3_column_int64(statement, 0))
+        }
+
+        guard version != Self.schemaVersion else {
+            return
+        }
+
+        try inTransaction {
+            try execute("DROP TABLE IF EXISTS document_text")
+            try execute("DROP TABLE IF EXISTS documents")
+            try execute("CREATE TABLE documents (id INTEGER PRIMARY KEY, key TEXT NOT NULL UNIQUE, language_code TEXT NOT NULL)")
+            // unicode61 folds case and, with remove_diacritics, accents, so "cafe" finds "Café"
+            try execute("CREATE VIRTUAL TABLE document_text USING fts5(title, text, tokenize = 'unicode61 remove_diacritics 2')")
+            try execute("PRAGMA user_version = \(Self.schemaVersion)")
+        }
+    }
+
+    /// Documents and their text share an id, so replacing or removing a document never has to scan the full-text table
+    private func insert(_ document: Document) throws {
+        var id: Int64?
+        try query("INSERT INTO documents (key, language_code) VALUES (?1, ?2) ON CONFLICT (key) DO UPDATE SET language_code = excluded.language_code RETURNING id", bindings: [.text(document.key), .text(document.languageCode)]) { statement in
+            id = sqlite3_column_int64(statement, 0)
+        }
+
+        guard let id else {
+            throw WMFOfflineSearchIndexError.missingDocumentID
+        }
+
+        try execute("DELETE FROM document_text WHERE rowid = ?1", bindings: [.integer(id)])
+        try execute("INSERT INTO document_text (rowid, title, text) VALUES (?1, ?2, ?3)", bindings: [.integer(id), .text(document.title), .text(document.text)])
+    }
+
+    private func inTransaction(_ body: () throws -> Void) throws {
+        try execute("BEGIN IMMEDIATE")
+        do {
+            try body()
+            try execute("COMMIT")
+        } catch {
+            try? execute("ROLLBACK")
+            throw error
+        }
+    }
+
+    /// Steps a statement to completion, discarding any rows
+    private func execute(_ sql: String, bindings: [Binding] = []) throws {
+        try query(sql, bindings: bindings) { _ in }
+    }
+
+    /// Steps a statement to completion, calling `row` for each row it returns
+    private func query(_ sql: String, bindings: [Binding] = [], row: (OpaquePointer) throws -> Void) throws {
+        var statement: OpaquePointer?
+        defer {
+            sqlite3_finalize(statement)
+        }
+
+        let prepareResult = sqlite3_prepare_v2(database, sql, -1, &statement, nil)
+        guard prepareResult == SQLITE_OK, let statement else {
+            throw WMFOfflineSearchIndexError.sqliteFailure(code: prepareResult)
+        }
+
+        for (offset, binding) in bindings.enumerated() {
+            let index = Int32(offset + 1)
+            let bindResult: Int32
+            switch binding {
+            case .text(let value):
+                bindResult = sqlite3_bind_text(statement, index, value, -1, Self.transientDestructor)
+            case .integer(let value):
+                bindResult = sqlite3_bind_int64(statement, index, value)
+            case .null:
+                bindResult = sqlite3_bind_null(statement, index)
+            }
+            guard bindResult == SQLITE_OK else {
+                throw WMFOfflineSearchIndexError.sqliteFailure(code: bindResult)
+            }
+        }
+
+        var stepResult = sqlite3_step(statement)
+        while stepResult == SQLITE_ROW {
+            try row(statement)
+            stepResult = sqlite3_step(statement)
+        }
+
+        guard stepResult == SQLITE_DONE else {
+            throw WMFOfflineSearchIndexError.sqliteFailure(code: stepResult)
+        }
+    }
+
+    /// Tells SQLite to copy bound strings, as Swift's bridged buffers don't outlive the call
+    private static let transientDestructor = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+
+    private static func string(from statement: OpaquePointer, column: Int32) -> String {
+        guard let text = sqlite3_column_text(statement, column) else {
+            return ""
+        }
+        return String(cString: text)
+    }
+}
@@ -0,0 +1,111 @@
+import Foundation
+import SQLite3
+
+/// A short-lived SQLite connection to the Core Data store file, used for maintenance Core Data does not expose: page counts, incremental vacuum and WAL checkpoints.
+/// It never rebuilds the file. A full VACUUM on a second connection would race Core Data's own connections, so conversion to incremental auto-vacuum is left to Core Data at store load.
+/// Calls block, so use it off the main thread and close it (by releasing it) as soon as maintenance is done.
+final class WMFSQLiteMaintenance {
+
+    enum AutoVacuumMode: Int {
+        case none = 0
+        case full = 1
+        case incremental = 2
+    }
+
+    private var database: OpaquePointer?
+
+    init(fileURL: URL, busyTimeout: TimeInterval = 2) throws {
+        let flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_NOMUTEX
+        let result = sqlite3_open_v2(fileURL.path, &database, flags, nil)
+        guard result == SQLITE_OK else {
+            sqlite3_close(database)
+            database = nil
+            throw WMFCoreDataStoreError.sqliteFailure(code: result)
+        }
+
+        // Core Data's own connections may briefly hold locks, so wait for them rather than failing immediately.
+        sqlite3_busy_timeout(database, Int32(busyTimeout * 1000))
+    }
+
+    deinit {
+        sqlite3_close(database)
+    }
+
+    var pageSize: Int {
+        get throws { try integer(forPragma: "page_size") }
+    }
+
+    var pageCount: Int {
+        get throws { try integer(forPragma: "page_count") }
+    }
+
+    var freelistCount: Int {
+        get throws { try integer(forPragma: "freelist_count") }
+    }
+
+    var autoVacuumMode: AutoVacuumMode {
+        get throws { AutoVacuumMode(rawValue: try integer(forPragma: "auto_vacuum")) ?? .none }
+    }
+
+    /// Returns up to `pageLimit` free pages to the file system. Only has an effect once incremental auto-vacuum is enabled.
+    func incrementalVacuum(pageLimit: Int) throws {
+        try execute("PRAGMA incremental_vacuum(\(pageLimit))")
+    }
+
+    /// Copies the WAL back into the database and truncates it. Returns false if a reader kept the checkpoint from completing, which is retried on the next run.
+    @discardableResult
+    func checkpoint() throws -> Bool {
+        let result = sqlite3_wal_checkpoint_v2(database, nil, SQLITE_CHECKPOINT_TRUNCATE, nil, nil)
+        switch result {
+        case SQLITE_OK:
+            return true
+        case SQLITE_BUSY, SQLITE_LOCKED:
+            return false
+        default:
+            throw WMFCoreDataStoreError.sqliteFailure(code: result)
+        }
+    }
+
+    // MARK: - Private
+
+    private func integer(forPragma name: String) throws -> Int {
+        var statement: OpaquePointer?
+        defer {
+            sqlite3_finalize(statement)
+        }
+
+        let prepareResult = sqlite3_prepare_v2(database, "PRAGMA \(name)", -1, &statement, nil)
+        guard prepareResult == SQLITE_OK else {
+            throw WMFCoreDataStoreError.sqliteFailure(code: prepareResult)
+        }
+
+        let stepResult = sqlite3_step(statement)
+        guard stepResult == SQLITE_ROW else {
+            throw WMFCoreDataStoreError.sqliteFailure(code: stepResult)
+        }
+
+        return Int(sqlite3_column_int64(statement, 0))
+    }
+
+    /// Steps a statement to completion, discarding any rows. Some pragmas, like `incremental_vacuum`, only do their work as rows are stepped.
+    private func execute(_ sql: String) throws {
+        var statement: OpaquePointer?
+        defer {
+            sqlite3_finalize(statement)
+        }
+
+        let prepareResult = sqlite3_prepare_v2(database, sql, -1, &statement, nil)
+        guard prepareResult == SQLITE_OK else {
+            throw WMFCoreDataStoreError.sqliteFailure(code: prepareResult)
+        }
+
+        var stepResult = sqlite3_step(statement)
+        while stepResult == SQLITE_ROW {
+            stepResult = sqlite3_step(statement)
+        }
+
+        guard stepResult == SQLITE_DONE else {
+            throw WMFCoreDataStoreError.sqliteFailure(code: stepResult)
+        }
+    }
+}
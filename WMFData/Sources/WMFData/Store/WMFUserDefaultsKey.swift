@@ -93,6 +93,9 @@ public enum WMFUserDefaultsKey: String {
     case hasSeenOneTimeOnboardingHome = "has-seen-one-time-home-onboarding"
     case hasSeenUpdatedHomeOnboarding = "has-seen-updated-home-onboarding"
 
+    // Offline search
+    case didBackfillOfflineSearchIndex = "did-backfill-offline-search-index"
+
     // Article View Controller: Enable visual editor
     case developerSettingsEnableVisualEditingJourney = "dev-settings-enable-visual-editing-journey"
     case defaultEditMode = "default-edit-mode"
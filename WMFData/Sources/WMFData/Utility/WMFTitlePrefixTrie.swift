@@ -0,0 +1,114 @@
+import Foundation
+
+/// A prefix index over article titles, for suggesting articles while the user types without waiting on the network.
+///
+/// Each node keeps the best `maxMatchesPerPrefix` titles below it, ordered by weight, so a lookup only walks the
+/// typed prefix no matter how many titles share it. Weights only ever go up: inserting a title again keeps the higher
+/// of its weights, which lets callers add the same title from several sources (say history, then a recent result)
+/// without it dropping in rank.
+///
+/// Titles and prefixes are compared ignoring case, diacritics and the difference between underscores and spaces.
+/// Not thread safe; build it on one queue and hand it over, or confine it to the main thread.
+public final class WMFTitlePrefixTrie<Value> {
+
+    private final class Node {
+        var children: [Character: Node] = [:]
+
+        /// Indexes into `entries` of the best titles at or below this node, best first
+        var topEntryIndexes: [Int] = []
+    }
+
+    private struct Entry {
+        var value: Value
+        var weight: Double
+    }
+
+    public let maxMatchesPerPrefix: Int
+
+    private let root = Node()
+    private var entries: [Entry] = []
+    private var entryIndexesByNormalizedTitle: [String: Int] = [:]
+
+    public init(maxMatchesPerPrefix: Int = 10) {
+        self.maxMatchesPerPrefix = maxMatchesPerPrefix
+    }
+
+    public var count: Int {
+        return entries.count
+    }
+
+    /// Adds `title` with `value`, or replaces the value of a title already present and keeps the higher weight
+    public func insert(_ value: Value, forTitle title: String, weight: Double) {
+        let normalizedTitle = Self.normalized(title)
+        guard !normalizedTitle.isEmpty else {
+            return
+        }
+
+        let index: Int
+        if let existingIndex = entryIndexesByNormalizedTitle[normalizedTitle] {
+            index = existingIndex
+            entries[index].value = value
+            entries[index].weight = max(entries[index].weight, weight)
+        } else {
+            index = entries.count
+            entries.append(Entry(value: value, weight: weight))
+            entryIndexesByNormalizedTitle[normalizedTitle] = index
+        }
+
+        var node = root
+        for character in normalizedTitle {
+            let child: Node
+            if let existingChild = node.children[character] {
+                child = existingChild
+            } else {
+                child = Node()
+                node.children[character] = child
+            }
+            rank(index, in: child)
+            node = child
+        }
+    }
+
+    /// The best titles starting with `prefix`, best first
+    public func matches(forPrefix prefix: String, limit: Int? = nil) -> [Value] {
+        let normalizedPrefix = Self.normalized(prefix)
+        guard !normalizedPrefix.isEmpty else {
+            return []
+        }
+
+        var node = root
+        for character in normalizedPrefix {
+            guard let child = node.children[character] else {
+                return []
+            }
+            node = child
+        }
+
+        return node.topEntryIndexes.prefix(limit ?? maxMatchesPerPrefix).map { entries[$0].value }
+    }
+
+    // MARK: - Private
+
+    /// Moves the entry to its place in the node's top list, or leaves it out if it doesn't make the cut. Ties keep the earlier title first.
+    private func rank(_ index: Int, in node: Node) {
+        node.topEntryIndexes.removeAll { $0 == index }
+
+        let weight = entries[index].weight
+        let position = node.topEntryIndexes.firstIndex { entries[$0].weight < weight } ?? node.topEntryIndexes.endIndex
+        guard position < maxMatchesPerPrefix else {
+            return
+        }
+
+        node.topEntryIndexes.insert(index, at: position)
+        if node.topEntryIndexes.count > maxMatchesPerPrefix {
+            node.topEntryIndexes.removeLast()
+        }
+    }
+
+    static func normalized(_ title: String) -> String {
+        let folded = title
+            .replacingOccurrences(of: "_", with: " ")
+            .folding(options: [.caseInsensitive, .diacriticInsensitive, .widthInsensitive], locale: nil)
+        return String(folded.drop { $0.isWhitespace })
+    }
+}
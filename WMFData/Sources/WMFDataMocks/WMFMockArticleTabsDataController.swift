@@ -112,6 +112,17 @@ public final class WMFMockArticleTabsDataController: WMFArticleTabsDataControlli
     public func fetchAllArticleTabs() async throws -> [WMFArticleTabsDataController.WMFArticleTab] {
         return tabs
     }
+    
+    public func fetchArticleTabSummaries() async throws -> [WMFArticleTabsDataController.WMFArticleTab] {
+        return tabs.map { tab in
+            WMFArticleTabsDataController.WMFArticleTab(
+                identifier: tab.identifier,
+                timestamp: tab.timestamp,
+                isCurrent: tab.isCurrent,
+                articles: tab.articles.last.map { [$0] } ?? []
+            )
+        }
+    }
 
     public func populateWithInitialTabs() async throws {
         
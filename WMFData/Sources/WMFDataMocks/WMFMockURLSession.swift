@@ -73,3 +73,31 @@ final class WMFMockMissingDataSession: WMFURLSession {
         // no-op
     }
 }
+
+/// Holds completion handlers until `completeAll()` is called, so tests can issue overlapping requests.
+final class WMFMockDeferredURLSession: WMFURLSession {
+
+    private(set) var dataTaskCount = 0
+    private var pendingCompletions: [@Sendable (Data?, URLResponse?, Error?) -> Void] = []
+
+    func wmfDataTask(with request: URLRequest, completionHandler: @escaping @Sendable (Data?, URLResponse?, Error?) -> Void) -> WMFData.WMFURLSessionDataTask {
+        dataTaskCount += 1
+        pendingCompletions.append(completionHandler)
+        return WMFMockURLSessionDataTask()
+    }
+
+    func completeAll() {
+        let data = try? JSONEncoder().encode(WMFMockData(oneInt: 1, twoString: "two"))
+        let response = HTTPURLResponse(url: URL(string: "http://wikipedia.org")!, statusCode: 200, httpVersion: nil, headerFields: nil)
+
+        let completions = pendingCompletions
+        pendingCompletions.removeAll()
+        for completion in completions {
+            completion(data, response, nil)
+        }
+    }
+
+    func clearCachedData() {
+        // no-op
+    }
+}
@@ -351,4 +351,117 @@ final class WMFArticleTabsDataControllerTests: XCTestCase {
         XCTAssertEqual(secondTab.articles.count, 1, "Second tab should have one article")
         XCTAssertEqual(secondTab.articles[0].title, "Dog")
     }
+    
+    private func article(_ title: String) -> WMFArticleTabsDataController.WMFArticle {
+        return WMFArticleTabsDataController.WMFArticle(
+            identifier: nil,
+            title: title,
+            project: enProject,
+            articleURL: URL(string: "https://en.wikipedia.org/wiki/\(title)")
+        )
+    }
+    
+    func testGetAdjacentArticleInTab() async throws {
+        guard let dataController else {
+            throw TestsError.missingDataController
+        }
+        
+        let identifiers = try await dataController.createArticleTab(initialArticle: article("Cat"), setAsCurrent: true)
+        let dogIdentifiers = try await dataController.appendArticle(article("Dog"), toTabIdentifier: identifiers.tabIdentifier)
+        _ = try await dataController.appendArticle(article("Fox"), toTabIdentifier: identifiers.tabIdentifier)
+        
+        // Fox is current: it has a previous article but no next.
+        var previous = try await dataController.getAdjacentArticleInTab(tabIdentifier: identifiers.tabIdentifier, isPrev: true)
+        var next = try await dataController.getAdjacentArticleInTab(tabIdentifier: identifiers.tabIdentifier, isPrev: false)
+        XCTAssertEqual(previous?.title, "Dog")
+        XCTAssertNil(next)
+        
+        // Step back to Dog.
+        try await dataController.setTabItemAsCurrent(tabIdentifier: identifiers.tabIdentifier, tabItemIdentifier: try XCTUnwrap(dogIdentifiers.tabItemIdentifier))
+        previous = try await dataController.getAdjacentArticleInTab(tabIdentifier: identifiers.tabIdentifier, isPrev: true)
+        next = try await dataController.getAdjacentArticleInTab(tabIdentifier: identifiers.tabIdentifier, isPrev: false)
+        XCTAssertEqual(previous?.title, "Cat")
+        XCTAssertEqual(next?.title, "Fox")
+    }
+    
+    func testAppendArticleCleansOutFutureArticles() async throws {
+        guard let dataController else {
+            throw TestsError.missingDataController
+        }
+        
+        let identifiers = try await dataController.createArticleTab(initialArticle: article("Cat"), setAsCurrent: true)
+        let dogIdentifiers = try await dataController.appendArticle(article("Dog"), toTabIdentifier: identifiers.tabIdentifier)
+        _ = try await dataController.appendArticle(article("Fox"), toTabIdentifier: identifiers.tabIdentifier)
+        
+        // Back on Dog, navigating to a new article drops Fox.
+        try await dataController.setTabItemAsCurrent(tabIdentifier: identifiers.tabIdentifier, tabItemIdentifier: try XCTUnwrap(dogIdentifiers.tabItemIdentifier))
+        _ = try await dataController.appendArticle(article("Owl"), toTabIdentifier: identifiers.tabIdentifier, needsCleanoutOfFutureArticles: true)
+        
+        let tabs = try await dataController.fetchAllArticleTabs()
+        XCTAssertEqual(tabs.first?.articles.map(\.title), ["Cat", "Dog", "Owl"])
+        
+        let previous = try await dataController.getAdjacentArticleInTab(tabIdentifier: identifiers.tabIdentifier, isPrev: true)
+        XCTAssertEqual(previous?.title, "Dog")
+    }
+    
+    func testFetchArticleTabSummariesOnlyIncludesCurrentArticle() async throws {
+        guard let dataController else {
+            throw TestsError.missingDataController
+        }
+        
+        let firstIdentifiers = try await dataController.createArticleTab(initialArticle: article("Cat"), setAsCurrent: true)
+        _ = try await dataController.appendArticle(article("Dog"), toTabIdentifier: firstIdentifiers.tabIdentifier)
+        let secondIdentifiers = try await dataController.createArticleTab(initialArticle: article("Fox"), setAsCurrent: false)
+        
+        let summaries = try await dataController.fetchArticleTabSummaries()
+        XCTAssertEqual(summaries.count, 2)
+        
+        let firstTab = try XCTUnwrap(summaries.first(where: { $0.identifier == firstIdentifiers.tabIdentifier }))
+        XCTAssertTrue(firstTab.isCurrent)
+        XCTAssertEqual(firstTab.articles.map(\.title), ["Dog"])
+        
+        let secondTab = try XCTUnwrap(summaries.first(where: { $0.identifier == secondIdentifiers.tabIdentifier }))
+        XCTAssertFalse(secondTab.isCurrent)
+        XCTAssertEqual(secondTab.articles.map(\.title), ["Fox"])
+    }
+    
+    func testLegacyTabsAreAssignedItemPositions() async throws {
+        guard let store else {
+            throw TestsError.missingStore
+        }
+        
+        // Simulate a tab saved before item positions existed: ordered items, all at position 0.
+        let tabIdentifier = UUID()
+        let context = try store.newBackgroundContext
+        try await context.perform {
+            let tab = try store.create(entityType: CDArticleTab.self, in: context)
+            tab.identifier = tabIdentifier
+            tab.timestamp = Date()
+            tab.isCurrent = true
+            tab.hasItemPositions = false
+            
+            var items: [CDArticleTabItem] = []
+            for title in ["Cat", "Dog", "Fox"] {
+                let page = try store.create(entityType: CDPage.self, in: context)
+                page.title = title
+                page.namespaceID = 0
+                page.projectID = self.enProject.id
+                page.timestamp = Date()
+                
+                let item = try store.create(entityType: CDArticleTabItem.self, in: context)
+                item.identifier = UUID()
+                item.page = page
+                item.isCurrent = title == "Dog"
+                items.append(item)
+            }
+            tab.items = NSOrderedSet(array: items)
+            try store.saveIfNeeded(moc: context)
+        }
+        
+        let dataController = WMFArticleTabsDataController(coreDataStore: store)
+        let previous = try await dataController.getAdjacentArticleInTab(tabIdentifier: tabIdentifier, isPrev: true)
+        let next = try await dataController.getAdjacentArticleInTab(tabIdentifier: tabIdentifier, isPrev: false)
+        XCTAssertEqual(previous?.title, "Cat")
+        XCTAssertEqual(next?.title, "Fox")
+    }
 }
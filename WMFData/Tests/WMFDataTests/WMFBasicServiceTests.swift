@@ -167,6 +167,88 @@ final class WMFBasicServiceTests: XCTestCase {
         service.perform(request: request, completion: completion)
     }
     
+    // MARK: - Coalescing Tests
+
+    func testConcurrentIdenticalGetsShareOneDataTask() {
+
+        let session = WMFMockDeferredURLSession()
+        let service = WMFBasicService(urlSession: session)
+        let request = WMFBasicServiceRequest(url: URL(string: "http://wikipedia.org")!, method: .GET, parameters: ["one": "1"], acceptType: .json, coalescing: .inFlight)
+
+        var results: [WMFMockData] = []
+        for _ in 0..<3 {
+            service.performDecodableGET(request: request) { (result: Result<WMFMockData, Error>) in
+                if case .success(let response) = result {
+                    results.append(response)
+                }
+            }
+        }
+
+        XCTAssertEqual(session.dataTaskCount, 1, "Concurrent identical GETs should share one data task")
+        session.completeAll()
+
+        XCTAssertEqual(results.count, 3)
+        XCTAssertEqual(service.requestStatistics, WMFRequestCoalescer.Statistics(hits: 0, misses: 1, coalesced: 2))
+
+        // Nothing is memoized, so a later GET goes back to the network.
+        service.performDecodableGET(request: request) { (_: Result<WMFMockData, Error>) in }
+        XCTAssertEqual(session.dataTaskCount, 2)
+    }
+
+    func testGetsAreNotCoalescedByDefault() {
+
+        let session = WMFMockDeferredURLSession()
+        let service = WMFBasicService(urlSession: session)
+        let request = WMFBasicServiceRequest(url: URL(string: "http://wikipedia.org/api/rest_v1/page/random/summary")!, method: .GET, acceptType: .json)
+
+        service.performDecodableGET(request: request) { (_: Result<WMFMockData, Error>) in }
+        service.performDecodableGET(request: request) { (_: Result<WMFMockData, Error>) in }
+
+        XCTAssertEqual(session.dataTaskCount, 2, "Requests that don't opt in, like random articles, should each get their own data task")
+        XCTAssertEqual(service.requestStatistics, WMFRequestCoalescer.Statistics())
+    }
+
+    func testDifferentGetsAreNotCoalesced() {
+
+        let session = WMFMockDeferredURLSession()
+        let service = WMFBasicService(urlSession: session)
+        let requestOne = WMFBasicServiceRequest(url: URL(string: "http://wikipedia.org")!, method: .GET, parameters: ["one": "1"], acceptType: .json, coalescing: .inFlight)
+        let requestTwo = WMFBasicServiceRequest(url: URL(string: "http://wikipedia.org")!, method: .GET, parameters: ["one": "1"], acceptType: .none, coalescing: .inFlight)
+
+        service.performDecodableGET(request: requestOne) { (_: Result<WMFMockData, Error>) in }
+        service.performDecodableGET(request: requestTwo) { (_: Result<WMFMockData, Error>) in }
+
+        XCTAssertEqual(session.dataTaskCount, 2, "Requests with different headers should not share a data task")
+        XCTAssertEqual(service.requestStatistics.coalesced, 0)
+    }
+
+    func testMemoizedGetIsServedWithoutNetwork() {
+
+        let session = WMFMockDeferredURLSession()
+        let service = WMFBasicService(urlSession: session)
+        let request = WMFBasicServiceRequest(url: URL(string: "http://wikipedia.org")!, method: .GET, acceptType: .json, coalescing: .inFlightAndMemoized(60))
+
+        service.performDecodableGET(request: request) { (_: Result<WMFMockData, Error>) in }
+        session.completeAll()
+
+        let expectation = expectation(description: "Memoized response")
+        var memoizedResult: WMFMockData?
+        service.performDecodableGET(request: request) { (result: Result<WMFMockData, Error>) in
+            memoizedResult = try? result.get()
+            expectation.fulfill()
+        }
+        XCTAssertNil(memoizedResult, "A memoized response should be delivered asynchronously, like one from the network")
+        wait(for: [expectation], timeout: 1)
+
+        XCTAssertEqual(session.dataTaskCount, 1)
+        XCTAssertEqual(memoizedResult?.twoString, "two")
+        XCTAssertEqual(service.requestStatistics, WMFRequestCoalescer.Statistics(hits: 1, misses: 1, coalesced: 0))
+
+        service.clearCachedData()
+        service.performDecodableGET(request: request) { (_: Result<WMFMockData, Error>) in }
+        XCTAssertEqual(session.dataTaskCount, 2, "Clearing cached data should drop memoized responses")
+    }
+
     // MARK: - POST Tests
     
     func testSuccessfulDictionaryPost() {
@@ -1,6 +1,7 @@
 import XCTest
 @testable import WMFData
 import CoreData
+import SQLite3
 
 final class WMFCoreDataStoreTests: XCTestCase {
     
@@ -10,12 +11,14 @@ final class WMFCoreDataStoreTests: XCTestCase {
     }
     
     var store: WMFCoreDataStore?
+    var databaseFileURL: URL?
     
     override func setUp() async throws {
         
         let temporaryDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
         let store = try await WMFCoreDataStore(appContainerURL: temporaryDirectory)
         self.store = store
+        self.databaseFileURL = temporaryDirectory.appendingPathComponent("WMFData.sqlite")
         
         try await super.setUp()
     }
@@ -196,7 +199,10 @@ final class WMFCoreDataStoreTests: XCTestCase {
         }
         
         // Clean up via database housekeeper
-        try await store.performDatabaseHousekeeping()
+        let report = try await store.performDatabaseHousekeeping()
+        XCTAssertTrue(report.isRetentionComplete)
+        XCTAssertEqual(report.deletedObjectCounts["CDPageView"], 2)
+        XCTAssertEqual(report.deletedObjectCounts["CDPage"], 1)
         
         try await backgroundContext.perform {
             backgroundContext.refreshAllObjects()
@@ -214,4 +220,88 @@ final class WMFCoreDataStoreTests: XCTestCase {
             XCTAssertEqual(newPageViews.count, 2)
         }
     }
+    
+    func testDatabaseHousekeepingResumesAfterTimeBudgetRunsOut() async throws {
+        
+        guard let store else {
+            throw TestsError.missingStore
+        }
+        
+        let overTwoYearsAgoInSeconds = TimeInterval(60 * 60 * 24 * 800)
+        let pageViewCount = WMFCoreDataStore.housekeepingChunkSize + 10
+        
+        let backgroundContext = try store.newBackgroundContext
+        try await backgroundContext.perform {
+            let page = try store.create(entityType: CDPage.self, in: backgroundContext)
+            page.title = "Cat"
+            page.namespaceID = 0
+            page.projectID = WMFProject.wikipedia(WMFLanguage(languageCode: "en", languageVariantCode: nil)).id
+            page.timestamp = Date()
+            
+            for _ in 0..<pageViewCount {
+                let pageView = try store.create(entityType: CDPageView.self, in: backgroundContext)
+                pageView.timestamp = Date(timeIntervalSinceNow: -overTwoYearsAgoInSeconds)
+                pageView.page = page
+            }
+            
+            try store.saveIfNeeded(moc: backgroundContext)
+        }
+        
+        // No time budget: nothing is pruned and the run reports itself incomplete.
+        let firstReport = try await store.performDatabaseHousekeeping(timeBudget: 0)
+        XCTAssertFalse(firstReport.isRetentionComplete)
+        XCTAssertEqual(firstReport.deletedObjectCount, 0)
+        
+        // The next run picks up all of the remaining work, across more than one chunk.
+        let secondReport = try await store.performDatabaseHousekeeping()
+        XCTAssertTrue(secondReport.isRetentionComplete)
+        XCTAssertEqual(secondReport.deletedObjectCounts["CDPageView"], pageViewCount)
+        XCTAssertGreaterThan(secondReport.fileSizeAfter, 0)
+        
+        try await backgroundContext.perform {
+            backgroundContext.refreshAllObjects()
+            let pageViews = try store.fetch(entityType: CDPageView.self, predicate: nil, fetchLimit: nil, in: backgroundContext)
+            XCTAssertEqual(pageViews?.count, 0)
+        }
+    }
+    
+    func testStoreUsesIncrementalVacuum() async throws {
+        
+        guard let store, let databaseFileURL else {
+            throw TestsError.missingStore
+        }
+        
+        var database: OpaquePointer?
+        var statement: OpaquePointer?
+        XCTAssertEqual(sqlite3_open(databaseFileURL.path, &database), SQLITE_OK)
+        XCTAssertEqual(sqlite3_prepare_v2(database, "PRAGMA auto_vacuum", -1, &statement, nil), SQLITE_OK)
+        XCTAssertEqual(sqlite3_step(statement), SQLITE_ROW)
+        let autoVacuum = sqlite3_column_int(statement, 0)
+        sqlite3_finalize(statement)
+        sqlite3_close(database)
+        
+        // 2 is INCREMENTAL
+        XCTAssertEqual(autoVacuum, 2)
+        
+        let report = try await store.performDatabaseHousekeeping()
+        XCTAssertNil(report.compactionErrorDescription)
+    }
+    
+    func testExistingStoreIsConvertedToIncrementalVacuumOnLoad() async throws {
+        
+        let temporaryDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        let databaseFileURL = temporaryDirectory.appendingPathComponent("WMFData.sqlite")
+        _ = try await WMFCoreDataStore(appContainerURL: temporaryDirectory)
+        
+        // Turn the new store back into one created before incremental auto-vacuum was enabled.
+        var database: OpaquePointer?
+        XCTAssertEqual(sqlite3_open(databaseFileURL.path, &database), SQLITE_OK)
+        XCTAssertEqual(sqlite3_exec(database, "PRAGMA auto_vacuum = NONE; VACUUM;", nil, nil, nil), SQLITE_OK)
+        sqlite3_close(database)
+        XCTAssertEqual(try WMFSQLiteMaintenance(fileURL: databaseFileURL).autoVacuumMode, WMFSQLiteMaintenance.AutoVacuumMode.none)
+        
+        _ = try await WMFCoreDataStore(appContainerURL: temporaryDirectory)
+        
+        XCTAssertEqual(try WMFSQLiteMaintenance(fileURL: databaseFileURL).autoVacuumMode, .incremental)
+    }
 }
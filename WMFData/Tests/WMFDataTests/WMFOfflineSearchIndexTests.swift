@@ -0,0 +1,128 @@
+import XCTest
+@testable import WMFData
+
+final class WMFOfflineSearchIndexTests: XCTestCase {
+
+    var index: WMFOfflineSearchIndex!
+
+    override func setUpWithError() throws {
+        try super.setUpWithError()
+        index = try WMFOfflineSearchIndex(fileURL: Self.temporaryIndexURL())
+    }
+
+    override func tearDownWithError() throws {
+        index = nil
+        try super.tearDownWithError()
+    }
+
+    private static func temporaryIndexURL() -> URL {
+        return FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString).appendingPathExtension("sqlite")
+    }
+
+    private func document(_ title: String, _ text: String, languageCode: String = "en") -> WMFOfflineSearchIndex.Document {
+        return WMFOfflineSearchIndex.Document(key: "https://\(languageCode).wikipedia.org/wiki/\(title)", languageCode: languageCode, title: title, text: text)
+    }
+
+    func testTitleMatchesRankAboveTextMatches() throws {
+        try index.add([
+            document("Cat", "The cat is a small carnivorous mammal. Unlike the dog, it is mostly solitary."),
+            document("Dog", "The dog is a domesticated descendant of the wolf.")
+        ])
+
+        let results = try index.search("dog")
+        XCTAssertEqual(results.map { $0.title }, ["Dog", "Cat"])
+    }
+
+    func testLastWordMatchesAsPrefix() throws {
+        try index.add(document("Dog", "The dog is a domesticated descendant of the wolf."))
+
+        XCTAssertEqual(try index.search("domest").map { $0.title }, ["Dog"])
+        XCTAssertEqual(try index.search("domest wolf").count, 0, "Only the last word is a prefix")
+        XCTAssertEqual(try index.search("domesticated wo").map { $0.title }, ["Dog"])
+    }
+
+    func testSearchIgnoresCaseAndDiacritics() throws {
+        try index.add(document("Café", "A café serves coffee."))
+
+        XCTAssertEqual(try index.search("CAFE").map { $0.title }, ["Café"])
+    }
+
+    func testQuerySyntaxInTermIsTreatedAsText() throws {
+        try index.add(document("Dog", "The dog is a domesticated descendant of the wolf."))
+
+        XCTAssertEqual(try index.search("dog \" OR NEAR(").count, 0)
+        XCTAssertEqual(try index.search("   ").count, 0)
+    }
+
+    func testSnippetHighlightsMatches() throws {
+        try index.add(document("Dog", "The dog is a domesticated descendant of the wolf."))
+
+        let result = try XCTUnwrap(try index.search("wolf").first)
+        XCTAssertEqual(result.snippet, "The dog is a domesticated descendant of the wolf.")
+        XCTAssertEqual(result.highlightedRanges.map { (result.snippet as NSString).substring(with: $0) }, ["wolf"])
+    }
+
+    func testAddingAgainReplacesDocument() throws {
+        try index.add(document("Dog", "The dog is a domesticated descendant of the wolf."))
+        try index.add(document("Dog", "Dogs were the first species to be domesticated."))
+
+        XCTAssertEqual(try index.documentCount, 1)
+        XCTAssertEqual(try index.search("wolf").count, 0)
+        XCTAssertEqual(try index.search("species").map { $0.title }, ["Dog"])
+    }
+
+    func testRemove() throws {
+        let dog = document("Dog", "The dog is a domesticated descendant of the wolf.")
+        try index.add([dog, document("Wolf", "The wolf is a large canine.")])
+        try index.remove(key: dog.key)
+
+        XCTAssertEqual(try index.documentCount, 1)
+        XCTAssertEqual(try index.search("wolf").map { $0.title }, ["Wolf"])
+    }
+
+    func testLanguageFilter() throws {
+        try index.add([
+            document("Dog", "The dog is a domesticated descendant of the wolf."),
+            document("Hund", "Der Hund ist ein Haustier, englisch dog.", languageCode: "de")
+        ])
+
+        XCTAssertEqual(try index.search("dog", languageCode: "de").map { $0.title }, ["Hund"])
+        XCTAssertEqual(try index.search("dog").count, 2)
+    }
+
+    // MARK: - Performance
+
+    private static let benchmarkVocabulary = ["history", "river", "species", "population", "century", "government", "mountain", "language", "culture", "island", "economy", "music", "church", "railway", "battle", "university", "climate", "village", "empire", "museum"]
+
+    /// 2,000 articles of about 2,000 words each, roughly the size of a saved article's text
+    private static func benchmarkDocuments() -> [WMFOfflineSearchIndex.Document] {
+        var generator = SystemRandomNumberGenerator()
+        return (0..<2000).map { number in
+            let words = (0..<2000).map { _ in benchmarkVocabulary.randomElement(using: &generator)! }
+            return WMFOfflineSearchIndex.Document(key: "https://en.wikipedia.org/wiki/Article_\(number)", languageCode: "en", title: "Article \(number)", text: words.joined(separator: " "))
+        }
+    }
+
+    func testBuildPerformance() throws {
+        let documents = Self.benchmarkDocuments()
+
+        measure {
+            do {
+                let index = try WMFOfflineSearchIndex(fileURL: Self.temporaryIndexURL())
+                try index.add(documents)
+            } catch {
+                XCTFail("Error building index: \(error)")
+            }
+        }
+    }
+
+    func testQueryPerformance() throws {
+        try index.add(Self.benchmarkDocuments())
+
+        measure {
+            for term in ["river", "mountain vill", "Article 1999", "empire museum batt"] {
+                XCTAssertNoThrow(try index.search(term))
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+import XCTest
+@testable import WMFData
+
+final class WMFTitlePrefixTrieTests: XCTestCase {
+
+    func testMatchesAreOrderedByWeight() {
+        let trie = WMFTitlePrefixTrie<String>()
+        trie.insert("Dog", forTitle: "Dog", weight: 1)
+        trie.insert("Dogecoin", forTitle: "Dogecoin", weight: 3)
+        trie.insert("Dogma", forTitle: "Dogma", weight: 2)
+        trie.insert("Cat", forTitle: "Cat", weight: 10)
+
+        XCTAssertEqual(trie.matches(forPrefix: "dog"), ["Dogecoin", "Dogma", "Dog"])
+        XCTAssertEqual(trie.matches(forPrefix: "dog", limit: 1), ["Dogecoin"])
+        XCTAssertEqual(trie.matches(forPrefix: "dogs"), [])
+        XCTAssertEqual(trie.matches(forPrefix: ""), [])
+    }
+
+    func testMatchingIgnoresCaseDiacriticsAndUnderscores() {
+        let trie = WMFTitlePrefixTrie<String>()
+        trie.insert("São Paulo", forTitle: "São_Paulo", weight: 1)
+
+        XCTAssertEqual(trie.matches(forPrefix: "SAO P"), ["São Paulo"])
+        XCTAssertEqual(trie.matches(forPrefix: "  sao"), ["São Paulo"])
+    }
+
+    func testInsertingAgainReplacesValueAndKeepsHigherWeight() {
+        let trie = WMFTitlePrefixTrie<String>()
+        trie.insert("Dog (history)", forTitle: "Dog", weight: 5)
+        trie.insert("Dogma", forTitle: "Dogma", weight: 3)
+        trie.insert("Dog (result)", forTitle: "Dog", weight: 1)
+
+        XCTAssertEqual(trie.count, 2)
+        XCTAssertEqual(trie.matches(forPrefix: "do"), ["Dog (result)", "Dogma"])
+
+        trie.insert("Dogma", forTitle: "Dogma", weight: 8)
+        XCTAssertEqual(trie.matches(forPrefix: "do"), ["Dogma", "Dog (result)"])
+    }
+
+    func testEachPrefixKeepsOnlyTheBestTitles() {
+        let trie = WMFTitlePrefixTrie<Int>(maxMatchesPerPrefix: 3)
+        for number in 0..<10 {
+            trie.insert(number, forTitle: "Title \(number)", weight: Double(number))
+        }
+
+        XCTAssertEqual(trie.matches(forPrefix: "title"), [9, 8, 7])
+        XCTAssertEqual(trie.matches(forPrefix: "title 2"), [2])
+    }
+}
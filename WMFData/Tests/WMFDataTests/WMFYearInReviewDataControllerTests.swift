@@ -264,6 +264,120 @@ final class WMFYearInReviewDataControllerTests: XCTestCase {
             XCTAssertFalse(shouldShowEntryPointRU, "RU should not show entry point for mock YiR config.")
         }
     }
+
+    func testPopulateSlideDataRunsSlidesConcurrently() async throws {
+
+        guard let dataController, let store else {
+            throw TestError.missingDataController
+        }
+
+        let slideDelay: TimeInterval = 0.3
+        let slideDataControllers = (0..<4).map { DelayedSlideDataController(id: "slide\($0)", delay: slideDelay) }
+
+        let context = try store.newBackgroundContext
+        let metrics = await dataController.populateSlideData(for: slideDataControllers, in: context)
+
+        XCTAssertTrue(slideDataControllers.allSatisfy { $0.isEvaluated })
+        XCTAssertEqual(metrics.slideDurations.count, slideDataControllers.count)
+        XCTAssertGreaterThanOrEqual(metrics.sequentialDuration, slideDelay * Double(slideDataControllers.count))
+        XCTAssertLessThan(metrics.totalDuration, slideDelay * 2, "Slides should overlap rather than run back to back.")
+    }
+
+    func testPopulateSlideDataDropsTimedOutAndFailedSlides() async throws {
+
+        guard let dataController, let store else {
+            throw TestError.missingDataController
+        }
+
+        let fast = DelayedSlideDataController(id: "fast", delay: 0)
+        let slow = DelayedSlideDataController(id: "slow", delay: 5)
+        let failing = DelayedSlideDataController(id: "failing", delay: 0, shouldFail: true)
+
+        let context = try store.newBackgroundContext
+        let metrics = await dataController.populateSlideData(for: [fast, slow, failing], in: context, slideTimeout: 0.2)
+
+        XCTAssertTrue(fast.isEvaluated)
+        XCTAssertFalse(slow.isEvaluated)
+        XCTAssertFalse(failing.isEvaluated)
+        XCTAssertLessThan(metrics.totalDuration, 5, "Timed out slide should not hold up the report.")
+    }
+
+    func testPopulateSlideDataStopsTimedOutSlideBetweenFetches() async throws {
+
+        guard let dataController, let store else {
+            throw TestError.missingDataController
+        }
+
+        // 50 fetches of 0.1s that ignore cancellation themselves, as a Core Data fetch does
+        let slow = DelayedSlideDataController(id: "slow", delay: 0.1, blockingFetchCount: 50)
+
+        let context = try store.newBackgroundContext
+        let metrics = await dataController.populateSlideData(for: [slow], in: context, slideTimeout: 0.2)
+
+        XCTAssertFalse(slow.isEvaluated)
+        XCTAssertLessThan(slow.completedFetchCount, 50)
+        XCTAssertLessThan(metrics.totalDuration, 1, "Timed out slide should stop at its next fetch rather than run all of them.")
+    }
+}
+
+/// Slide data controller that simulates a slow network or Core Data workload.
+private final class DelayedSlideDataController: YearInReviewSlideDataControllerProtocol, @unchecked Sendable {
+
+    enum TestError: Error {
+        case populateFailed
+    }
+
+    let id: String
+    let year = 2025
+    var isEvaluated = false
+    static let containsPersonalizedNetworkData = false
+    static let shouldFreeze = false
+
+    private let delay: TimeInterval
+    private let shouldFail: Bool
+    private let blockingFetchCount: Int?
+    private(set) var completedFetchCount = 0
+
+    /// With a `blockingFetchCount`, the slide runs that many fetches, each blocking for `delay` without checking for cancellation, and checks for cancellation between them.
+    init(id: String, delay: TimeInterval, shouldFail: Bool = false, blockingFetchCount: Int? = nil) {
+        self.id = id
+        self.delay = delay
+        self.shouldFail = shouldFail
+        self.blockingFetchCount = blockingFetchCount
+    }
+
+    init(year: Int, yirConfig: WMFFeatureConfigResponse.Common.YearInReview, dependencies: YearInReviewSlideDataControllerDependencies) {
+        self.id = "delayed"
+        self.delay = 0
+        self.shouldFail = false
+        self.blockingFetchCount = nil
+    }
+
+    func populateSlideData(in context: NSManagedObjectContext) async throws {
+        if let blockingFetchCount {
+            for _ in 0..<blockingFetchCount {
+                Thread.sleep(forTimeInterval: delay)
+                completedFetchCount += 1
+                try Task.checkCancellation()
+            }
+            return
+        }
+        try await Task.sleep(for: .seconds(delay))
+        if shouldFail {
+            throw TestError.populateFailed
+        }
+    }
+
+    func makeCDSlide(in context: NSManagedObjectContext) throws -> CDYearInReviewSlide {
+        let slide = CDYearInReviewSlide(context: context)
+        slide.id = id
+        slide.year = Int32(year)
+        return slide
+    }
+
+    static func shouldPopulate(from config: WMFFeatureConfigResponse.Common.YearInReview, userInfo: YearInReviewUserInfo) -> Bool {
+        return true
+    }
 }
 
 extension WMFFeatureConfigResponse.Common.YearInReview {
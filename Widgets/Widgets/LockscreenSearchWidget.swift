@@ -41,10 +41,9 @@ struct LockscreenSearchWidgetConfiguration {
     let siteURL: URL
     
     init() {
-        let sharedCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
-        let cache = sharedCache.loadCache() ?? WidgetCache(settings: .default, featuredContent: nil)
-        self.languageCode = cache.settings.languageCode
-        self.siteURL = cache.settings.siteURL
+        let settings = WidgetCache.loadSettings()
+        self.languageCode = settings.languageCode
+        self.siteURL = settings.siteURL
     }
 }
 
@@ -231,9 +231,10 @@ extension OnThisDayEntry {
             let calendar = NSCalendar.wmf_utcGregorian(),
             let previewEvents = contentGroup.contentPreview as? [WMFFeedOnThisDayEvent],
             let previewEvent = previewEvents.first,
-            let allEvents = contentGroup.fullContent?.object as? [WMFFeedOnThisDayEvent],
-            let earliestEventYear = allEvents.last?.yearString,
-            let latestEventYear = allEvents.first?.yearString,
+            // Only the first and last events are needed, so read them without decoding the rest
+            let allEvents = contentGroup.fullContent?.contentObject as? NSArray,
+            let earliestEventYear = (allEvents.lastObject as? WMFFeedOnThisDayEvent)?.yearString,
+            let latestEventYear = (allEvents.firstObject as? WMFFeedOnThisDayEvent)?.yearString,
             let article = previewEvents.first?.articlePreviews?.first,
             let year = previewEvent.year?.intValue,
             let eventsCount = contentGroup.countOfFullContent?.intValue
@@ -268,7 +269,8 @@ extension OnThisDayEntry {
         eventYearsAgo = String(format: WMFLocalizedDateFormatStrings.yearsAgo(forWikiLanguage: language), locale: locale, yearsSinceEvent)
         yearRange = CommonStrings.onThisDayHeaderDateRangeMessage(with: language, locale: locale, lastEvent: earliestEventYear, firstEvent: latestEventYear)
 
-        if let previewEventIndex = allEvents.firstIndex(of: previewEvent),
+        let previewEventIndex = allEvents.index(of: previewEvent)
+        if previewEventIndex != NSNotFound,
            let dynamicURL = URL(string: "https://en.wikipedia.org/wiki/Wikipedia:On_this_day/Today?\(previewEventIndex)") {
             contentURL = dynamicURL
         } else {
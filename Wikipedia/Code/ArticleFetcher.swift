@@ -43,6 +43,10 @@ final public class ArticleFetcher: Fetcher, CacheFetching {
     private static let acceptHeaderKey = "Accept"
     private static let acceptHTMLValue = "text/html; charset=utf-8"
 
+    // Keys of waits started through this fetcher that haven't completed, so cancelling tasks also cancels them
+    private let mobileHTMLChangeWaitLock = NSLock()
+    private var mobileHTMLChangeWaitKeys: Set<CancellationKey> = []
+
     struct MediaListItem {
         let imageURL: URL
         let imageTitle: String
@@ -378,12 +382,9 @@ final public class ArticleFetcher: Fetcher, CacheFetching {
         }
     }
     
-    /// Makes periodic HEAD requests to the mobile-html endpoint until the etag no longer matches the one provided.
-    @discardableResult public func waitForMobileHTMLChange(articleURL: URL, eTag: String, attempt: Int = 0, maxAttempts: Int, cancellationKey: CancellationKey? = nil, completion: @escaping (Result<String, Error>) -> Void) -> CancellationKey? {
-        guard attempt < maxAttempts else {
-            completion(.failure(ArticleFetcherError.updatedContentRequestTimeout))
-            return nil
-        }
+    /// Waits until the mobile-html ETag no longer matches the one provided. Polling is shared with every other pending wait through `MobileHTMLChangeWaiter`.
+    /// Like a task, the wait is cancelled with `cancel(taskFor:)` using the returned key, or with `cancelAllTasks()`. A cancelled wait never calls its completion.
+    @discardableResult public func waitForMobileHTMLChange(articleURL: URL, eTag: String, maxAttempts: Int, cancellationKey: CancellationKey? = nil, completion: @escaping (Result<String, Error>) -> Void) -> CancellationKey? {
         let requestURL: URL
         do {
             requestURL = try mobileHTMLURL(articleURL: articleURL)
@@ -392,63 +393,40 @@ final public class ArticleFetcher: Fetcher, CacheFetching {
             return nil
         }
         let key = cancellationKey ?? UUID().uuidString
-        let maybeTask = session.dataTask(with: requestURL, method: .head, headers: [URLRequest.ifNoneMatchHeaderKey: eTag], cachePolicy: .reloadIgnoringLocalCacheData) { (_, response, error) in
-            defer {
-                self.untrack(taskFor: key)
-            }
-            if let error = error {
-                completion(.failure(error))
-                return
-            }
-            let bail = {
-                completion(.failure(RequestError.unexpectedResponse))
-            }
-            guard let httpURLResponse = response as? HTTPURLResponse else {
-                bail()
-                return
-            }
-            
-            let retry = {
-                // Exponential backoff
-                let delayTime = 0.25 * pow(2, Double(attempt))
-                dispatchOnMainQueueAfterDelayInSeconds(delayTime) {
-                    self.waitForMobileHTMLChange(articleURL: articleURL, eTag: eTag, attempt: attempt + 1, maxAttempts: maxAttempts, cancellationKey: key, completion: completion)
-                }
-            }
-
-            // Check for 200. The server returns 304 when the ETag matches the value we provided for `If-None-Match` above
-            switch httpURLResponse.statusCode {
-            case 200:
-                break
-            case 304:
-                retry()
-                return
-            default:
-                bail()
-                return
-            }
-            
-            guard
-                let updatedETag = httpURLResponse.allHeaderFields[HTTPURLResponse.etagHeaderKey] as? String,
-                updatedETag != eTag // Technically redundant. With If-None-Match provided, we should only get a 200 response if the ETag has changed. Included here as an extra check against a server behaving incorrectly
-            else {
-                assert(false, "A 200 response from the server should indicate that the ETag has changed")
-                retry()
-                return
-            }
-            
-            DDLogDebug("ETag for \(requestURL) changed from \(eTag) to \(updatedETag)")
-            completion(.success(updatedETag))
-        }
-        guard let task = maybeTask else {
-            completion(.failure(RequestError.unknown))
-            return nil
+        mobileHTMLChangeWaitLock.lock()
+        mobileHTMLChangeWaitKeys.insert(key)
+        mobileHTMLChangeWaitLock.unlock()
+        MobileHTMLChangeWaiter.shared.wait(for: requestURL, eTag: eTag, maxAttempts: maxAttempts, session: session, key: key) { [weak self] result in
+            self?.removeMobileHTMLChangeWaitKey(key)
+            completion(result)
         }
-        track(task: task, for: key)
-        task.resume()
         return key
     }
     
+    @discardableResult private func removeMobileHTMLChangeWaitKey(_ key: CancellationKey) -> Bool {
+        mobileHTMLChangeWaitLock.lock()
+        defer {
+            mobileHTMLChangeWaitLock.unlock()
+        }
+        return mobileHTMLChangeWaitKeys.remove(key) != nil
+    }
+    
+    public override func cancel(taskFor key: String) {
+        super.cancel(taskFor: key)
+        if removeMobileHTMLChangeWaitKey(key) {
+            MobileHTMLChangeWaiter.shared.cancel(key: key)
+        }
+    }
+    
+    public override func cancelAllTasks() {
+        super.cancelAllTasks()
+        mobileHTMLChangeWaitLock.lock()
+        let keys = mobileHTMLChangeWaitKeys
+        mobileHTMLChangeWaitKeys.removeAll()
+        mobileHTMLChangeWaitLock.unlock()
+        keys.forEach { MobileHTMLChangeWaiter.shared.cancel(key: $0) }
+    }
+    
     public func isCached(articleURL: URL, scheme: String? = nil, completion: @escaping (Bool) -> Void) {
 
         guard let request = try? mobileHTMLRequest(articleURL: articleURL, scheme: scheme) else {
@@ -527,22 +505,291 @@ final public class ArticleFetcher: Fetcher, CacheFetching {
         }
     }
     
-    /// Fetches ArticleSummaries from the Page Content Service for the given articleKeys
+    /// Fetches ArticleSummaries for the given articleKeys.
+    /// Keys are grouped by site and language variant and fetched up to `maxTitlesPerSummaryQuery` at a time from the Action API. Keys whose batch fails, or that the batch response can't account for, fall back to individual Page Content Service requests.
+    /// The returned tasks are the initial batch and single-key tasks; continuation and fallback requests are tracked by the fetcher but not returned.
     @discardableResult public func fetchArticleSummaryResponsesForArticles(withKeys articleKeys: [WMFInMemoryURLKey], cachePolicy: URLRequest.CachePolicy? = nil, completion: @escaping ([WMFInMemoryURLKey: ArticleSummary]) -> Void) -> [URLSessionTask] {
         
         var tasks: [URLSessionTask] = []
-        articleKeys.asyncMapToDictionary(block: { (articleKey, asyncMapCompletion) in
-            let task = fetchSummaryForArticle(with: articleKey, cachePolicy: cachePolicy, completion: { (responseObject, response, error) in
-                asyncMapCompletion(articleKey, responseObject)
-            })
+        summaryBatches(for: articleKeys).asyncMap({ (batch, asyncMapCompletion: @escaping ([WMFInMemoryURLKey: ArticleSummary]) -> Void) in
+            let task = fetchSummaries(for: batch, cachePolicy: cachePolicy, completion: asyncMapCompletion)
             if let task = task {
                 tasks.append(task)
             }
-        }, completion: completion)
+        }, completion: { results in
+            var summaries: [WMFInMemoryURLKey: ArticleSummary] = [:]
+            summaries.reserveCapacity(articleKeys.count)
+            for result in results {
+                summaries.merge(result) { (current, _) in current }
+            }
+            completion(summaries)
+        })
         
         return tasks
     }
     
+    // MARK: - Batched Article Summaries from the Action API
+    
+    /// The Action API's limit on `titles` per query
+    static let maxTitlesPerSummaryQuery = 50
+    
+    /// Guards against a server that keeps returning `continue`. Extracts are limited to 20 per response, so a full batch needs 3 responses.
+    private static let maxSummaryQueryContinuations = 5
+    
+    private struct SummaryBatch {
+        let siteURL: URL?
+        let languageVariantCode: String?
+        let keysByTitle: [String: WMFInMemoryURLKey]
+    }
+    
+    private struct SummaryBatchGroup: Hashable {
+        let host: String
+        let languageVariantCode: String?
+    }
+    
+    private struct SummaryQueryResult {
+        var pagesByTitle: [String: [String: Any]] = [:]
+        /// normalized, converted and redirected titles, from -> to
+        var titleMappings: [String: String] = [:]
+    }
+    
+    private func summaryBatches(for articleKeys: [WMFInMemoryURLKey]) -> [SummaryBatch] {
+        
+        var groupedKeys: [SummaryBatchGroup: [(title: String, key: WMFInMemoryURLKey)]] = [:]
+        var siteURLs: [SummaryBatchGroup: URL] = [:]
+        var unbatchableBatches: [SummaryBatch] = []
+        
+        for articleKey in articleKeys {
+            guard let articleURL = articleKey.url,
+                  let host = articleURL.host,
+                  let siteURL = articleURL.wmf_site,
+                  let title = articleURL.wmf_title else {
+                // Let the single-key path report the problem for this key
+                unbatchableBatches.append(SummaryBatch(siteURL: nil, languageVariantCode: articleKey.languageVariantCode, keysByTitle: ["": articleKey]))
+                continue
+            }
+            let group = SummaryBatchGroup(host: host, languageVariantCode: articleKey.languageVariantCode)
+            groupedKeys[group, default: []].append((title, articleKey))
+            siteURLs[group] = siteURL
+        }
+        
+        var batches = unbatchableBatches
+        for (group, keys) in groupedKeys {
+            guard let siteURL = siteURLs[group] else {
+                continue
+            }
+            var start = keys.startIndex
+            while start < keys.endIndex {
+                let end = Swift.min(start + Self.maxTitlesPerSummaryQuery, keys.endIndex)
+                var keysByTitle: [String: WMFInMemoryURLKey] = [:]
+                for (title, key) in keys[start..<end] {
+                    keysByTitle[title] = key
+                }
+                batches.append(SummaryBatch(siteURL: siteURL, languageVariantCode: group.languageVariantCode, keysByTitle: keysByTitle))
+                start = end
+            }
+        }
+        
+        return batches
+    }
+    
+    private func fetchSummaries(for batch: SummaryBatch, cachePolicy: URLRequest.CachePolicy?, completion: @escaping ([WMFInMemoryURLKey: ArticleSummary]) -> Void) -> URLSessionTask? {
+        
+        // A batch of one gains nothing from the Action API, and the Page Content Service summary is richer
+        guard batch.keysByTitle.count > 1 else {
+            guard let articleKey = batch.keysByTitle.values.first else {
+                completion([:])
+                return nil
+            }
+            return fetchSummaryForArticle(with: articleKey, cachePolicy: cachePolicy) { (summary, _, _) in
+                guard let summary = summary else {
+                    completion([:])
+                    return
+                }
+                completion([articleKey: summary])
+            }
+        }
+        
+        guard var siteURL = batch.siteURL else {
+            completion([:])
+            return nil
+        }
+        siteURL.wmf_languageVariantCode = batch.languageVariantCode
+        
+        let parameters: [String: Any] = [
+            "action": "query",
+            "format": "json",
+            "formatversion": 2,
+            "redirects": 1,
+            "converttitles": 1,
+            "titles": batch.keysByTitle.keys.sorted().joined(separator: "|"),
+            "prop": "info|description|extracts|pageimages|pageprops|coordinates|revisions",
+            "inprop": "displaytitle",
+            "exintro": 1,
+            "explaintext": 1,
+            "exlimit": "max",
+            "piprop": "thumbnail|original",
+            "pithumbsize": 320,
+            "pilimit": Self.maxTitlesPerSummaryQuery,
+            "ppprop": "wikibase_item",
+            "coprimary": "primary",
+            "colimit": "max",
+            "rvprop": "ids|timestamp"
+        ]
+        
+        return fetchSummaryQuery(siteURL: siteURL, parameters: parameters, cachePolicy: cachePolicy, accumulated: SummaryQueryResult(), continuationCount: 0) { result in
+            switch result {
+            case .success(let queryResult):
+                self.mapSummaryQueryResult(queryResult, for: batch, cachePolicy: cachePolicy, completion: completion)
+            case .failure(let error):
+                DDLogWarn("Batched summary query failed, falling back to individual requests: \(error)")
+                self.fetchSummariesIndividually(for: Array(batch.keysByTitle.values), cachePolicy: cachePolicy, completion: completion)
+            }
+        }
+    }
+    
+    /// Runs the query, following `continue` until the server reports the batch complete, and merges pages across responses.
+    private func fetchSummaryQuery(siteURL: URL, parameters: [String: Any], cachePolicy: URLRequest.CachePolicy?, accumulated: SummaryQueryResult, continuationCount: Int, completion: @escaping (Result<SummaryQueryResult, Error>) -> Void) -> URLSessionTask? {
+        
+        guard let url = configuration.mediaWikiAPIURLForURL(siteURL, with: parameters) else {
+            completion(.failure(RequestError.invalidParameters))
+            return nil
+        }
+        
+        let request = session.request(with: url, method: .get, cachePolicy: cachePolicy)
+        return performMediaWikiAPIGET(for: request, cancellationKey: nil) { (result, _, error) in
+            if let error = error {
+                completion(.failure(error))
+                return
+            }
+            
+            guard let query = result?["query"] as? [String: Any] else {
+                completion(.failure(RequestError.unexpectedResponse))
+                return
+            }
+            
+            var merged = accumulated
+            for mappingKey in ["normalized", "converted", "redirects"] {
+                for mapping in query[mappingKey] as? [[String: Any]] ?? [] {
+                    if let from = mapping["from"] as? String, let to = mapping["to"] as? String {
+                        merged.titleMappings[from] = to
+                    }
+                }
+            }
+            for page in query["pages"] as? [[String: Any]] ?? [] {
+                guard let title = page["title"] as? String else {
+                    continue
+                }
+                merged.pagesByTitle[title] = merged.pagesByTitle[title]?.merging(page) { (current, _) in current } ?? page
+            }
+            
+            guard let continueParameters = result?["continue"] as? [String: Any],
+                  continuationCount < Self.maxSummaryQueryContinuations else {
+                completion(.success(merged))
+                return
+            }
+            
+            let nextParameters = parameters.merging(continueParameters) { (_, continued) in continued }
+            self.fetchSummaryQuery(siteURL: siteURL, parameters: nextParameters, cachePolicy: cachePolicy, accumulated: merged, continuationCount: continuationCount + 1, completion: completion)
+        }
+    }
+    
+    private func mapSummaryQueryResult(_ queryResult: SummaryQueryResult, for batch: SummaryBatch, cachePolicy: URLRequest.CachePolicy?, completion: @escaping ([WMFInMemoryURLKey: ArticleSummary]) -> Void) {
+        
+        var summaries: [WMFInMemoryURLKey: ArticleSummary] = [:]
+        var unresolvedKeys: [WMFInMemoryURLKey] = []
+        
+        for (requestedTitle, articleKey) in batch.keysByTitle {
+            var title = requestedTitle
+            // normalized -> converted -> redirected
+            for _ in 0..<3 {
+                guard let mappedTitle = queryResult.titleMappings[title] else {
+                    break
+                }
+                title = mappedTitle
+            }
+            
+            guard let page = queryResult.pagesByTitle[title] else {
+                unresolvedKeys.append(articleKey)
+                continue
+            }
+            
+            // Missing and invalid pages have no summary from either API
+            guard page["missing"] == nil,
+                  page["invalid"] == nil,
+                  let siteURL = batch.siteURL,
+                  let summary = articleSummary(fromQueryPage: page, siteURL: siteURL) else {
+                continue
+            }
+            
+            summary.languageVariantCode = articleKey.languageVariantCode
+            summaries[articleKey] = summary
+        }
+        
+        guard !unresolvedKeys.isEmpty else {
+            completion(summaries)
+            return
+        }
+        
+        fetchSummariesIndividually(for: unresolvedKeys, cachePolicy: cachePolicy) { fallbackSummaries in
+            completion(summaries.merging(fallbackSummaries) { (current, _) in current })
+        }
+    }
+    
+    private func fetchSummariesIndividually(for articleKeys: [WMFInMemoryURLKey], cachePolicy: URLRequest.CachePolicy?, completion: @escaping ([WMFInMemoryURLKey: ArticleSummary]) -> Void) {
+        articleKeys.asyncMapToDictionary(block: { (articleKey, asyncMapCompletion) in
+            fetchSummaryForArticle(with: articleKey, cachePolicy: cachePolicy, completion: { (responseObject, response, error) in
+                asyncMapCompletion(articleKey, responseObject)
+            })
+        }, completion: completion)
+    }
+    
+    private func articleSummary(fromQueryPage page: [String: Any], siteURL: URL) -> ArticleSummary? {
+        guard let title = page["title"] as? String,
+              let articleURL = siteURL.wmf_URL(withTitle: title) else {
+            return nil
+        }
+        
+        func image(_ key: String) -> ArticleSummaryImage? {
+            guard let image = page[key] as? [String: Any],
+                  let source = image["source"] as? String,
+                  let width = image["width"] as? Int,
+                  let height = image["height"] as? Int else {
+                return nil
+            }
+            return ArticleSummaryImage(source: source, width: width, height: height)
+        }
+        
+        let coordinates: ArticleSummaryCoordinates?
+        if let coordinate = (page["coordinates"] as? [[String: Any]])?.first,
+           let lat = coordinate["lat"] as? Double,
+           let lon = coordinate["lon"] as? Double {
+            coordinates = ArticleSummaryCoordinates(lat: lat, lon: lon)
+        } else {
+            coordinates = nil
+        }
+        
+        let latestRevision = (page["revisions"] as? [[String: Any]])?.first
+        let revisionID = (latestRevision?["revid"] as? NSNumber)?.stringValue
+        let pageProps = page["pageprops"] as? [String: Any]
+        
+        return ArticleSummary(
+            id: (page["pageid"] as? NSNumber)?.int64Value,
+            wikidataID: pageProps?["wikibase_item"] as? String,
+            revision: revisionID,
+            timestamp: latestRevision?["timestamp"] as? String,
+            namespace: ArticleSummary.Namespace(id: page["ns"] as? Int),
+            title: title.denormalizedPageTitle ?? title,
+            displayTitle: page["displaytitle"] as? String,
+            articleDescription: page["description"] as? String,
+            extract: page["extract"] as? String,
+            thumbnail: image("thumbnail"),
+            original: image("original"),
+            coordinates: coordinates,
+            contentURLs: ArticleSummaryContentURLs(desktop: ArticleSummaryURLs(page: articleURL.absoluteString))
+        )
+    }
+    
     /// Fetches a single ArticleSummary or the given articleKey from the Page Content Service
     @discardableResult public func fetchSummaryForArticle(with articleKey: WMFInMemoryURLKey, cachePolicy: URLRequest.CachePolicy? = nil, completion: @escaping (ArticleSummary?, URLResponse?, Error?) -> Swift.Void) -> URLSessionTask? {
         do {
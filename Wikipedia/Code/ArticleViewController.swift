@@ -1580,10 +1580,7 @@ private extension ArticleViewController {
     }
 
     var isWidgetCachedFeaturedArticle: Bool {
-        let sharedCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
-
-        let cache = sharedCache.loadCache() ?? WidgetCache(settings: .default, featuredContent: nil)
-        guard let widgetFeaturedArticleURLString = cache.featuredContent?.featuredArticle?.contentURL.desktop.page,
+        guard let widgetFeaturedArticleURLString = WidgetCache.loadFeaturedContent()?.featuredArticle?.contentURL.desktop.page,
               let widgetFeaturedArticleURL = URL(string: widgetFeaturedArticleURLString) else {
             return false
         }
@@ -467,6 +467,8 @@ private extension DiffContainerViewController {
                     nextToModel = revision
                     if let nextToModel = nextToModel {
                         self.nextModel = NextPrevModel(from: nextFromModel, to: nextToModel)
+                        // Stepping forward is likely, so have the next diff ready while this one is read
+                        self.diffController.prefetchDiff(fromRevisionId: nextFromModel.revisionID, toRevisionId: nextToModel.revisionID)
                     }
                 }
             case .failure:
@@ -504,6 +506,7 @@ private extension DiffContainerViewController {
                     prevFromModel = revision
                     if let prevFromModel = prevFromModel {
                         self.prevModel = NextPrevModel(from: prevFromModel, to: prevToModel)
+                        self.diffController.prefetchDiff(fromRevisionId: prevFromModel.revisionID, toRevisionId: prevToModel.revisionID)
                     }
                 }
             case .failure(let error):
@@ -800,6 +803,7 @@ private extension DiffContainerViewController {
         view.setNeedsLayout()
         view.layoutIfNeeded()
         let width = diffListViewController?.collectionView.frame.width
+        let fetchStartTime = CACurrentMediaTime()
 
         diffController.fetchDiff(fromRevisionId: fromModel.revisionID, toRevisionId: toModel.revisionID, theme: theme, traitCollection: traitCollection) { [weak self] (result) in
 
@@ -811,6 +815,7 @@ private extension DiffContainerViewController {
             case .success(let listViewModel):
 
                 self.updateListViewController(with: listViewModel, collectionViewWidth: width)
+                DDLogDebug("Diff \(fromModel.revisionID)-\(toModel.revisionID) ready to show in \(String(format: "%.3f", CACurrentMediaTime() - fetchStartTime))s")
 
             case .failure(let error):
                 DispatchQueue.main.async {
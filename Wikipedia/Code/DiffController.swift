@@ -249,6 +249,10 @@ class DiffController {
         }
     }
     
+    func prefetchDiff(fromRevisionId: Int, toRevisionId: Int) {
+        diffFetcher.prefetchDiff(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL)
+    }
+    
     func fetchDiff(fromRevisionId: Int, toRevisionId: Int, theme: Theme, traitCollection: UITraitCollection, completion: @escaping ((Result<[DiffListGroupViewModel], Error>) -> Void)) {
 
 //        let queue = DispatchQueue.global(qos: .userInitiated)
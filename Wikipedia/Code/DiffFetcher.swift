@@ -1,4 +1,5 @@
 import Foundation
+import CocoaLumberjackSwift
 
 enum DiffFetcherError: Error {
     case failureParsingRevisions
@@ -13,7 +14,155 @@ class DiffFetcher: Fetcher {
         case newer
     }
     
+    // MARK: - Diff cache
+    
+    /// The diff between two revisions never changes, so compare responses are kept on disk and reused when stepping back and forth through history
+    private static let diffCache = SharedContainerShardedCache(name: SharedContainerCacheCommonNames.diffCache, maxEntryCount: 200)
+    private static let memoryDiffCache: NSCache<NSString, DiffResponseBox> = {
+        let cache = NSCache<NSString, DiffResponseBox>()
+        // Enough for the diffs around the one being read; anything older comes back from disk
+        cache.countLimit = 20
+        return cache
+    }()
+    private static let diffCacheQueue = DispatchQueue(label: "org.wikimedia.wikipedia.diffCache", qos: .userInitiated)
+    
+    /// Completions waiting on a diff that is already being fetched, for example by a prefetch, keyed by cache key
+    private static var pendingDiffCompletions: [String: [(Result<DiffResponse, Error>) -> Void]] = [:]
+    private static var diffCacheHitCount = 0
+    private static var diffCacheRequestCount = 0
+    /// Bumped when the cache is cleared, so fetches already in flight don't store their responses afterwards
+    private static var diffCacheGeneration = 0
+    private static let diffCacheLock = NSLock()
+    
+    private final class DiffResponseBox {
+        let response: DiffResponse
+        
+        init(response: DiffResponse) {
+            self.response = response
+        }
+    }
+    
+    static func diffCacheKey(fromRevisionId: Int, toRevisionId: Int, siteURL: URL) -> String? {
+        guard let host = siteURL.host else {
+            return nil
+        }
+        return "\(host)-\(fromRevisionId)-\(toRevisionId)"
+    }
+    
+    private static func recordDiffCacheRequest(isHit: Bool) {
+        diffCacheLock.lock()
+        diffCacheRequestCount += 1
+        if isHit {
+            diffCacheHitCount += 1
+        }
+        let hitCount = diffCacheHitCount
+        let requestCount = diffCacheRequestCount
+        diffCacheLock.unlock()
+        DDLogDebug("Diff cache \(isHit ? "hit" : "miss"), hit rate \(hitCount)/\(requestCount)")
+    }
+    
+    /// Removes every cached diff, in memory and on disk
+    @objc static func clearDiffCache(completion: (() -> Void)? = nil) {
+        diffCacheLock.lock()
+        diffCacheGeneration += 1
+        diffCacheLock.unlock()
+        memoryDiffCache.removeAllObjects()
+        diffCacheQueue.async {
+            diffCache.removeAll()
+            completion?()
+        }
+    }
+    
+    private static func isCurrentDiffCacheGeneration(_ generation: Int) -> Bool {
+        diffCacheLock.lock()
+        defer {
+            diffCacheLock.unlock()
+        }
+        return generation == diffCacheGeneration
+    }
+    
+    /// Fetches and caches a diff the user is likely to open next, if it isn't cached already
+    func prefetchDiff(fromRevisionId: Int, toRevisionId: Int, siteURL: URL) {
+        fetchDiff(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL, isPrefetch: true) { _ in }
+    }
+    
     func fetchDiff(fromRevisionId: Int, toRevisionId: Int, siteURL: URL, completion: @escaping ((Result<DiffResponse, Error>) -> Void)) {
+        fetchDiff(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL, isPrefetch: false, completion: completion)
+    }
+    
+    private func fetchDiff(fromRevisionId: Int, toRevisionId: Int, siteURL: URL, isPrefetch: Bool, completion: @escaping ((Result<DiffResponse, Error>) -> Void)) {
+        
+        guard let key = Self.diffCacheKey(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL) else {
+            completion(.failure(DiffError.generateUrlFailure))
+            return
+        }
+        
+        if let box = Self.memoryDiffCache.object(forKey: key as NSString) {
+            if !isPrefetch {
+                Self.recordDiffCacheRequest(isHit: true)
+            }
+            // Callers transform the response in the completion, so it never runs on the calling (often main) thread
+            DispatchQueue.global(qos: .userInitiated).async {
+                completion(.success(box.response))
+            }
+            return
+        }
+        
+        // Join a fetch already in flight rather than starting another
+        Self.diffCacheLock.lock()
+        if Self.pendingDiffCompletions[key] != nil {
+            Self.pendingDiffCompletions[key]?.append(completion)
+            Self.diffCacheLock.unlock()
+            if !isPrefetch {
+                Self.recordDiffCacheRequest(isHit: true)
+            }
+            return
+        }
+        Self.pendingDiffCompletions[key] = [completion]
+        let generation = Self.diffCacheGeneration
+        Self.diffCacheLock.unlock()
+        
+        let finish: (Result<DiffResponse, Error>) -> Void = { result in
+            if case .success(let response) = result, Self.isCurrentDiffCacheGeneration(generation) {
+                Self.memoryDiffCache.setObject(DiffResponseBox(response: response), forKey: key as NSString)
+            }
+            Self.diffCacheLock.lock()
+            let completions = Self.pendingDiffCompletions.removeValue(forKey: key) ?? []
+            Self.diffCacheLock.unlock()
+            for completion in completions {
+                DispatchQueue.global(qos: .userInitiated).async {
+                    completion(result)
+                }
+            }
+        }
+        
+        Self.diffCacheQueue.async {
+            if let response: DiffResponse = Self.diffCache.value(forKey: key) {
+                if !isPrefetch {
+                    Self.recordDiffCacheRequest(isHit: true)
+                }
+                finish(.success(response))
+                return
+            }
+            
+            if !isPrefetch {
+                Self.recordDiffCacheRequest(isHit: false)
+            }
+            self.fetchUncachedDiff(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL) { result in
+                if case .success(let response) = result {
+                    Self.diffCacheQueue.async {
+                        guard Self.isCurrentDiffCacheGeneration(generation) else {
+                            return
+                        }
+                        Self.diffCache.setValue(response, forKey: key)
+                    }
+                }
+                finish(result)
+            }
+        }
+    }
+    
+    private func fetchUncachedDiff(fromRevisionId: Int, toRevisionId: Int, siteURL: URL, completion: @escaping ((Result<DiffResponse, Error>) -> Void)) {
         
         guard let url = compareURL(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL) else {
             completion(.failure(DiffError.generateUrlFailure))
@@ -3,7 +3,9 @@ import WMFNativeLocalizations
 
 final class DiffListChangeItemViewModel {
     let text: String
-    let accessibilityLabelText: String
+    
+    /// Only needed once VoiceOver reads the item, so built on first use
+    private(set) lazy var accessibilityLabelText: String = DiffListChangeItemViewModel.constructAccessibilityLabel(with: text, highlightedRanges: highlightedRanges, diffItemType: diffItemType, moveInfo: moveInfo)
     let highlightedRanges: [DiffHighlightRange]
     let type: DiffListChangeType
     let diffItemType: DiffItemType
@@ -17,17 +19,45 @@ final class DiffListChangeItemViewModel {
 
     var theme: Theme {
         didSet {
-            textAttributedString = DiffListChangeItemViewModel.calculateAttributedString(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, theme: theme, type: type, diffItemType: diffItemType, moveInfo: moveInfo, semanticContentAttribute: semanticContentAttribute)
+            // Colors don't affect layout, so only the highlighted text needs rebuilding
+            highlightedAttributedString = nil
         }
     }
     
     var traitCollection: UITraitCollection {
         didSet {
-            textAttributedString = DiffListChangeItemViewModel.calculateAttributedString(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, theme: theme, type: type, diffItemType: diffItemType, moveInfo: moveInfo, semanticContentAttribute: semanticContentAttribute)
+            layoutText = DiffListChangeItemViewModel.calculateLayoutText(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, diffItemType: diffItemType, moveInfo: moveInfo, semanticContentAttribute: semanticContentAttribute)
+            highlightedAttributedString = nil
         }
     }
     
-    private(set) var textAttributedString: NSAttributedString?
+    /// The text with fonts and paragraph style but no colors, along with the ranges to highlight in it
+    private struct LayoutText {
+        let attributedString: NSAttributedString
+        let highlightedRanges: [DiffHighlightRange]
+        let lengthOfMovePrefix: Int?
+    }
+    
+    private var layoutText: LayoutText?
+    private var highlightedAttributedString: NSAttributedString?
+    
+    /// Everything that affects the size of the text, for calculating heights without applying highlight colors
+    var layoutAttributedString: NSAttributedString? {
+        return layoutText?.attributedString
+    }
+    
+    /// The text with highlight colors applied. Built when a cell first displays it rather than for every item up front.
+    var textAttributedString: NSAttributedString? {
+        if let highlightedAttributedString = highlightedAttributedString {
+            return highlightedAttributedString
+        }
+        guard let layoutText = layoutText else {
+            return nil
+        }
+        let attributedString = DiffListChangeItemViewModel.calculateHighlightedAttributedString(from: layoutText, text: text, theme: theme, diffItemType: diffItemType)
+        highlightedAttributedString = attributedString
+        return attributedString
+    }
     
     init(firstRevisionText: String, traitCollection: UITraitCollection, theme: Theme, semanticContentAttribute: UISemanticContentAttribute) {
         let text = firstRevisionText
@@ -50,8 +80,7 @@ final class DiffListChangeItemViewModel {
         self.textPadding =  textPaddingAndInBetweenSpacing.0
         self.inBetweenSpacing = nil
         self.hasShadedBackgroundView = false
-        self.textAttributedString = DiffListChangeItemViewModel.calculateAttributedString(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, theme: theme, type: type, diffItemType: diffItemType, moveInfo: nil, semanticContentAttribute: semanticContentAttribute)
-        self.accessibilityLabelText = DiffListChangeItemViewModel.constructAccessibilityLabel(with: text, highlightedRanges: highlightedRanges, diffItemType: diffItemType, moveInfo: nil)
+        self.layoutText = DiffListChangeItemViewModel.calculateLayoutText(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, diffItemType: diffItemType, moveInfo: nil, semanticContentAttribute: semanticContentAttribute)
     }
     
     init(item: TransformDiffItem, traitCollection: UITraitCollection, theme: Theme, type: DiffListChangeType, diffItemType: DiffItemType, nextMiddleItem: TransformDiffItem?, semanticContentAttribute: UISemanticContentAttribute) {
@@ -92,8 +121,7 @@ final class DiffListChangeItemViewModel {
         
         hasShadedBackgroundView = (diffItemType == .moveSource || diffItemType == .moveDestination)
 
-        self.textAttributedString = DiffListChangeItemViewModel.calculateAttributedString(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, theme: theme, type: type, diffItemType: diffItemType, moveInfo: item.moveInfo, semanticContentAttribute: semanticContentAttribute)
-        self.accessibilityLabelText = DiffListChangeItemViewModel.constructAccessibilityLabel(with: text, highlightedRanges: highlightedRanges, diffItemType: diffItemType, moveInfo: item.moveInfo)
+        self.layoutText = DiffListChangeItemViewModel.calculateLayoutText(with: text, highlightedRanges: highlightedRanges, traitCollection: traitCollection, diffItemType: diffItemType, moveInfo: item.moveInfo, semanticContentAttribute: semanticContentAttribute)
     }
     
     private static func calculateTextPaddingAndInBetweenSpacing(type: DiffListChangeType, diffItemType: DiffItemType, nextMiddleItem: TransformDiffItem?) -> (textPadding: NSDirectionalEdgeInsets, inBetweenSpacing: CGFloat?) {
@@ -127,7 +155,7 @@ final class DiffListChangeItemViewModel {
         }
     }
     
-    private static func moveAttributedString(with text: String, diffItemType: DiffItemType, moveInfo: TransformMoveInfo, highlightedRanges: inout [DiffHighlightRange], traitCollection: UITraitCollection, theme: Theme) -> (moveAttributedString: NSAttributedString?, lengthOfPrefix: Int)? {
+    private static func moveAttributedString(with text: String, diffItemType: DiffItemType, moveInfo: TransformMoveInfo, highlightedRanges: inout [DiffHighlightRange], traitCollection: UITraitCollection) -> (moveAttributedString: NSAttributedString?, lengthOfPrefix: Int)? {
         
         guard !text.isEmpty,
             diffItemType == .moveSource || diffItemType == .moveDestination else {
@@ -299,7 +327,7 @@ final class DiffListChangeItemViewModel {
         return modifiedAccessibilityText
     }
 
-    private static func calculateAttributedString(with text: String, highlightedRanges: [DiffHighlightRange], traitCollection: UITraitCollection, theme: Theme, type: DiffListChangeType, diffItemType: DiffItemType, moveInfo: TransformMoveInfo?, semanticContentAttribute: UISemanticContentAttribute) -> NSAttributedString? {
+    private static func calculateLayoutText(with text: String, highlightedRanges: [DiffHighlightRange], traitCollection: UITraitCollection, diffItemType: DiffItemType, moveInfo: TransformMoveInfo?, semanticContentAttribute: UISemanticContentAttribute) -> LayoutText? {
         
         var modifiedText = text
         var modifiedHighlightedRanges = highlightedRanges
@@ -314,7 +342,7 @@ final class DiffListChangeItemViewModel {
         switch diffItemType {
         case .moveSource, .moveDestination:
             if let moveInfo = moveInfo {
-                let moveResult = moveAttributedString(with: text, diffItemType: diffItemType, moveInfo: moveInfo, highlightedRanges: &modifiedHighlightedRanges, traitCollection: traitCollection, theme: theme)
+                let moveResult = moveAttributedString(with: text, diffItemType: diffItemType, moveInfo: moveInfo, highlightedRanges: &modifiedHighlightedRanges, traitCollection: traitCollection)
                 moveItemAttributedString = moveResult?.0
                 lengthOfPrefix = moveResult?.1
             }
@@ -341,22 +369,42 @@ final class DiffListChangeItemViewModel {
         }
         
         let attributes = [NSAttributedString.Key.font: font,
-                          NSAttributedString.Key.foregroundColor: theme.colors.primaryText,
                           NSAttributedString.Key.paragraphStyle: paragraphStyle.copy()]
         
         let finalAttributedStringToHighlight: NSMutableAttributedString
         
         if let moveItemAttributedString = moveItemAttributedString,
-            let lengthOfPrefix = lengthOfPrefix {
-            let moveIndexAttributes = [NSAttributedString.Key.foregroundColor: theme.colors.diffCompareAccent]
+            lengthOfPrefix != nil {
             finalAttributedStringToHighlight = NSMutableAttributedString(attributedString: moveItemAttributedString)
             finalAttributedStringToHighlight.addAttributes(attributes, range: NSRange(location: 0, length: moveItemAttributedString.length))
-            finalAttributedStringToHighlight.addAttributes(moveIndexAttributes, range: NSRange(location: 0, length: lengthOfPrefix))
         } else {
             finalAttributedStringToHighlight = NSMutableAttributedString(string: modifiedText, attributes: attributes)
+            lengthOfPrefix = nil
         }
         
+        // Highlights are bold, which changes the size of the text, so the font is applied here rather than with the colors
+        let boldFont = WMFFont.for(boldFontStyle, compatibleWith: traitCollection)
         for range in modifiedHighlightedRanges {
+            finalAttributedStringToHighlight.addAttribute(NSAttributedString.Key.font, value: boldFont, range: NSRange(location: range.start, length: range.length))
+        }
+        
+        guard let attributedString = finalAttributedStringToHighlight.copy() as? NSAttributedString else {
+            return nil
+        }
+        
+        return LayoutText(attributedString: attributedString, highlightedRanges: modifiedHighlightedRanges, lengthOfMovePrefix: lengthOfPrefix)
+    }
+    
+    private static func calculateHighlightedAttributedString(from layoutText: LayoutText, text: String, theme: Theme, diffItemType: DiffItemType) -> NSAttributedString? {
+        
+        let finalAttributedStringToHighlight = NSMutableAttributedString(attributedString: layoutText.attributedString)
+        finalAttributedStringToHighlight.addAttribute(NSAttributedString.Key.foregroundColor, value: theme.colors.primaryText, range: NSRange(location: 0, length: finalAttributedStringToHighlight.length))
+        
+        if let lengthOfPrefix = layoutText.lengthOfMovePrefix {
+            finalAttributedStringToHighlight.addAttribute(NSAttributedString.Key.foregroundColor, value: theme.colors.diffCompareAccent, range: NSRange(location: 0, length: lengthOfPrefix))
+        }
+        
+        for range in layoutText.highlightedRanges {
 
             let nsRange = NSRange(location: range.start, length: range.length)
             var highlightColor: UIColor?
@@ -379,9 +427,6 @@ final class DiffListChangeItemViewModel {
                 ]
                 finalAttributedStringToHighlight.addAttributes(deletedAttributes, range: nsRange)
             }
-
-            let font = WMFFont.for(boldFontStyle, compatibleWith: traitCollection)
-            finalAttributedStringToHighlight.addAttribute(NSAttributedString.Key.font, value: font, range: nsRange)
             
             if let highlightColor = highlightColor {
                 finalAttributedStringToHighlight.addAttribute(NSAttributedString.Key.backgroundColor, value: highlightColor, range: nsRange)
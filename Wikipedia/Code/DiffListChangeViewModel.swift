@@ -209,8 +209,8 @@ final class DiffListChangeViewModel: DiffListGroupViewModel {
         var height: CGFloat = 0
         
         for item in items {
-            if let textAttributedString = item.textAttributedString {
-                let newHeight = ceil(textAttributedString.boundingRect(with: CGSize(width: availableWidth - item.textPadding.leading - item.textPadding.trailing, height: CGFloat.infinity), options: [.usesLineFragmentOrigin], context: nil).height)
+            if let layoutAttributedString = item.layoutAttributedString {
+                let newHeight = ceil(layoutAttributedString.boundingRect(with: CGSize(width: availableWidth - item.textPadding.leading - item.textPadding.trailing, height: CGFloat.infinity), options: [.usesLineFragmentOrigin], context: nil).height)
                 height += newHeight
             }
             
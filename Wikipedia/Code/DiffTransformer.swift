@@ -38,7 +38,6 @@ struct TransformSectionInfo {
 }
 
 enum DiffTransformerError: Error {
-    case failureTransformingNetworkModels
     case failureParsingFirstRevisionWikitext
 }
 
@@ -76,310 +75,218 @@ class DiffTransformer {
     
     func viewModels(from response: DiffResponse, theme: Theme, traitCollection: UITraitCollection) throws -> [DiffListGroupViewModel] {
         
-        let groupedMoveIndexes = self.groupedIndexesOfMoveItems(from: response)
-        let transformSectionInfo = self.transformSectionInfosOfItems(from: response)
-        let transformDiffItems = self.transformDiffItemsWithPopulatedLineNumbers(from: response)
-        
-        guard let populatedTransformDiffItems = self.populateAdditionalSectionAndMoveInfo(transformSectionInfo: transformSectionInfo, transformDiffItems: transformDiffItems, groupedMoveIndexes: groupedMoveIndexes) else {
-            
-            throw DiffTransformerError.failureTransformingNetworkModels
-        }
+        let transformDiffItems = self.transformDiffItems(from: response)
         
+        let groups: [TransformGroup]
         switch self.type {
         case .single:
-            let viewModels: [DiffListGroupViewModel] = self.viewModelsForSingle(from: populatedTransformDiffItems, theme: theme, traitCollection: traitCollection)
-
-            return viewModels
+            groups = self.groupsForSingle(from: transformDiffItems)
         case .compare:
-            let viewModels: [DiffListGroupViewModel] = self.viewModelsForCompare(from: populatedTransformDiffItems, theme: theme, traitCollection: traitCollection)
-            return viewModels
+            groups = self.groupsForCompare(from: transformDiffItems)
         }
+        
+        return self.makeViewModels(for: groups, theme: theme, traitCollection: traitCollection)
     }
     
-    private func populateAdditionalSectionAndMoveInfo(transformSectionInfo: [TransformSectionInfo], transformDiffItems: [TransformDiffItem], groupedMoveIndexes: [String: Int]) -> [TransformDiffItem]? {
-        
-        guard transformDiffItems.count == transformSectionInfo.count,
-            transformDiffItems.count == transformDiffItems.count else {
-            assertionFailure("Expecting section info count to equal number of diff items")
-            return nil
+    // MARK: - Structure
+    
+    /// Walks one side's sections alongside the diff items, which come in offset order
+    private struct SectionCursor {
+        let sections: [DiffSection]
+        private var nextIndex = 0
+        private(set) var isIntro = false
+        
+        init(sections: [DiffSection]) {
+            self.sections = sections
         }
         
-        var newItems: [TransformDiffItem] = []
-        let zipped = zip(transformDiffItems, transformSectionInfo)
-        
-        var correspondingMoveItems: [String: (linkItem: TransformDiffItem, linkSectionInfo: TransformSectionInfo)] = [:]
-        for zippedItem in zipped {
-            guard zippedItem.0.type == .moveDestination ||
-                zippedItem.0.type == .moveSource else {
-                continue
-            }
-            
-            if let linkId = zippedItem.0.moveInfo?.linkId {
-                correspondingMoveItems[linkId] = (zippedItem.0, zippedItem.1)
+        mutating func side(at offset: Int?) -> TransformSectionInfo.Side? {
+            guard let offset = offset else {
+                return nil
             }
-        }
-        
-        for var zippedItem in zipped {
-            
-            var isToIntro = zippedItem.1.toIsIntro
-            var isFromIntro = zippedItem.1.fromIsIntro
             
-            zippedItem.0.sectionTitle = zippedItem.1.to?.title ?? zippedItem.1.from?.title
-            
-            if let moveInfo = zippedItem.0.moveInfo {
-                
-                let groupedIndex = groupedMoveIndexes[moveInfo.id]
-                
-                var moveDistance: TransformMoveDistance? = nil
-                
-                if let correspondingMoveItem = correspondingMoveItems[moveInfo.id] {
-                    
-                    let fromSectionTitle = zippedItem.0.type == .moveSource ? zippedItem.1.from?.title : correspondingMoveItem.linkSectionInfo.from?.title
-                    let toSectionTitle = zippedItem.0.type == .moveSource ? correspondingMoveItem.linkSectionInfo.to?.title : zippedItem.1.to?.title
-                    let fromSectionOrder = zippedItem.0.type == .moveSource ? zippedItem.1.from?.order : correspondingMoveItem.linkSectionInfo.from?.order
-                    let toSectionOrder = zippedItem.0.type == .moveSource ? correspondingMoveItem.linkSectionInfo.to?.order : zippedItem.1.to?.order
-                    isToIntro = zippedItem.0.type == .moveSource ? correspondingMoveItem.linkSectionInfo.toIsIntro : zippedItem.1.toIsIntro
-                    isFromIntro = zippedItem.0.type == .moveSource ? zippedItem.1.fromIsIntro : correspondingMoveItem.linkSectionInfo.fromIsIntro
-                    
-                    if let fromSectionTitle = fromSectionTitle,
-                        let toSectionTitle = toSectionTitle,
-                        let fromSectionOrder = fromSectionOrder,
-                        let toSectionOrder = toSectionOrder {
-                            
-                        switch (fromSectionTitle == toSectionTitle, fromSectionOrder == toSectionOrder) {                            
-                        case (false, false):
-                            moveDistance = .section(amount: abs(fromSectionOrder - toSectionOrder))
-                        default:
-                            break
-                        }
-                    }
-                    
-                    if moveDistance == nil {
-                        // fallback to line numbers
-                        if let firstLineNumber = zippedItem.0.lineNumber,
-                            let nextLineNumber = correspondingMoveItem.linkItem.lineNumber {
-                            moveDistance = .line(amount: abs(firstLineNumber - nextLineNumber))
-                        }
-                    }
-                }
-                
-                let transformMoveInfo = TransformMoveInfo(id: moveInfo.id, linkId: moveInfo.linkId, linkDirection: moveInfo.linkDirection, groupedIndex: groupedIndex, moveDistance: moveDistance)
-                zippedItem.0.moveInfo = transformMoveInfo
+            while nextIndex < sections.count && sections[nextIndex].offset <= offset {
+                nextIndex += 1
             }
             
-            if zippedItem.0.sectionTitle == nil {
-                if isToIntro && isFromIntro {
-                    zippedItem.0.sectionTitle = WMFLocalizedString("diff-single-intro-title", value:"Intro", comment:"Section heading on revision changes diff screen that indicates the following highlighted changes occurred in the intro section.")
+            guard nextIndex > 0 else {
+                if let firstOffset = sections.first?.offset {
+                    isIntro = offset < firstOffset
                 }
+                return nil
             }
             
-            newItems.append(zippedItem.0)
+            return TransformSectionInfo.Side(title: sections[nextIndex - 1].heading, order: nextIndex - 1)
         }
-        
-        return newItems
     }
     
-    private func transformSectionInfosOfItems(from response: DiffResponse) -> [TransformSectionInfo] {
-        
-        var result: [TransformSectionInfo] = []
-        
-        var fromSections = response.from.sections
-        var toSections = response.to.sections
+    /// Populates line numbers, section titles and move info in a single scan of the diff. Moved items need their linked item, which may come later, so they get their move distance and intro title in a second pass over just the moved items.
+    private func transformDiffItems(from response: DiffResponse) -> [TransformDiffItem] {
         
-        let firstFrom = fromSections.first
-        let firstTo = toSections.first
-        
-        var lastFrom: DiffSection? = nil
-        var lastTo: DiffSection? = nil
+        var items: [TransformDiffItem] = []
+        items.reserveCapacity(response.diff.count)
         
-        var lastFromIndex = -1
-        var lastToIndex = -1
+        var fromCursor = SectionCursor(sections: response.from.sections)
+        var toCursor = SectionCursor(sections: response.to.sections)
+        var lastLineNumber: Int?
         
-        var currentFrom = fromSections.first
-        var currentTo = toSections.first
+        var groupedMoveIndexes: [String: Int] = [:]
+        var groupedMoveIndexCounter = 0
+        var correspondingMoveItems: [String: (linkItem: TransformDiffItem, linkSectionInfo: TransformSectionInfo)] = [:]
+        var itemsWithMoveInfo: [(index: Int, sectionInfo: TransformSectionInfo)] = []
         
-        var fromIsIntro = false
-        var toIsIntro = false
         for item in response.diff {
             
-            // from side
-            var fromSide: TransformSectionInfo.Side?
+            let fromSide = fromCursor.side(at: item.offset.from)
+            let toSide = toCursor.side(at: item.offset.to)
+            let sectionInfo = TransformSectionInfo(from: fromSide, to: toSide, fromIsIntro: fromCursor.isIntro, toIsIntro: toCursor.isIntro)
             
-            if let itemFromOffset = item.offset.from {
-                while currentFrom != nil &&
-                currentFrom!.offset <= itemFromOffset {
-                    
-                        lastFrom = fromSections.removeFirst()
-                        lastFromIndex = lastFromIndex + 1
-                        currentFrom = fromSections.first
-                }
-                
-                if let lastFrom = lastFrom {
-                    fromSide = TransformSectionInfo.Side(title: lastFrom.heading, order: lastFromIndex)
-                }
-                
-                if let firstFromOffset = firstFrom?.offset,
-                    fromSide == nil {
-                    fromIsIntro = itemFromOffset < firstFromOffset
-                }
+            if let lineNumber = item.lineNumber {
+                lastLineNumber = lineNumber
             }
             
+            var transformMoveInfo: TransformMoveInfo?
+            if let moveInfo = item.moveInfo {
+                transformMoveInfo = TransformMoveInfo(id: moveInfo.id, linkId: moveInfo.linkId, linkDirection: moveInfo.linkDirection, groupedIndex: nil, moveDistance: nil)
+            }
             
-            // to side
-            var toSide: TransformSectionInfo.Side?
+            var transformDiffItem = TransformDiffItem(type: item.type, text: item.text, highlightRanges: item.highlightRanges, offset: item.offset, sectionTitle: toSide?.title ?? fromSide?.title, lineNumber: lastLineNumber, moveInfo: transformMoveInfo)
             
-            if let itemToOffset = item.offset.to {
-                while currentTo != nil &&
-                currentTo!.offset <= itemToOffset {
-                    
-                        lastTo = toSections.removeFirst()
-                        lastToIndex = lastToIndex + 1
-                        currentTo = toSections.first
-                }
+            if let moveInfo = item.moveInfo,
+                item.type == .moveSource || item.type == .moveDestination {
                 
-                if let lastTo = lastTo {
-                    toSide = TransformSectionInfo.Side(title: lastTo.heading, order: lastToIndex)
+                if groupedMoveIndexes[moveInfo.id] == nil {
+                    if let existingIndex = groupedMoveIndexes[moveInfo.linkId] {
+                        groupedMoveIndexes[moveInfo.id] = existingIndex
+                    } else {
+                        groupedMoveIndexes[moveInfo.id] = groupedMoveIndexCounter
+                        groupedMoveIndexCounter += 1
+                    }
                 }
                 
-                if let firstToOffset = firstTo?.offset,
-                    toSide == nil {
-                    toIsIntro = itemToOffset < firstToOffset
-                }
+                correspondingMoveItems[moveInfo.linkId] = (transformDiffItem, sectionInfo)
+            }
+            
+            if transformMoveInfo != nil {
+                itemsWithMoveInfo.append((items.count, sectionInfo))
+            } else if transformDiffItem.sectionTitle == nil && sectionInfo.toIsIntro && sectionInfo.fromIsIntro {
+                transformDiffItem.sectionTitle = introSectionTitle
             }
             
-            result.append(TransformSectionInfo(from: fromSide, to: toSide, fromIsIntro: fromIsIntro, toIsIntro: toIsIntro))
+            items.append(transformDiffItem)
         }
         
-        return result
+        for (index, sectionInfo) in itemsWithMoveInfo {
+            populateMoveInfo(of: &items[index], sectionInfo: sectionInfo, groupedMoveIndexes: groupedMoveIndexes, correspondingMoveItems: correspondingMoveItems)
+        }
+        
+        return items
     }
     
-    private func groupedIndexesOfMoveItems(from response: DiffResponse) -> [String: Int] {
-        let movedItems = response.diff.filter { $0.type == .moveSource || $0.type == .moveDestination }
+    private func populateMoveInfo(of item: inout TransformDiffItem, sectionInfo: TransformSectionInfo, groupedMoveIndexes: [String: Int], correspondingMoveItems: [String: (linkItem: TransformDiffItem, linkSectionInfo: TransformSectionInfo)]) {
         
-        var indexCounter = 0
-        var result: [String: Int] = [:]
-        
-        for item in movedItems {
-            
-            if let id = item.moveInfo?.id,
-                let linkId = item.moveInfo?.linkId {
-
-                if result[id] == nil {
-                    if let existingIndex = result[linkId] {
-                        result[id] = existingIndex
-                    } else {
-                        result[id] = indexCounter
-                        indexCounter += 1
-                    }
-                }
-            }
+        guard let moveInfo = item.moveInfo else {
+            return
         }
         
-        return result
-    }
-    
-    private func transformDiffItemsWithPopulatedLineNumbers(from response: DiffResponse) -> [TransformDiffItem] {
+        var isToIntro = sectionInfo.toIsIntro
+        var isFromIntro = sectionInfo.fromIsIntro
         
-        var items: [TransformDiffItem] = []
+        var moveDistance: TransformMoveDistance? = nil
         
-        var lastLineNumber: Int?
-        for item in response.diff {
-            
-            var transformMoveInfo: TransformMoveInfo?
-            if let moveInfo = item.moveInfo {
-                transformMoveInfo = TransformMoveInfo(id: moveInfo.id, linkId: moveInfo.linkId, linkDirection: moveInfo.linkDirection, groupedIndex: nil, moveDistance: nil)
-            }
+        if let correspondingMoveItem = correspondingMoveItems[moveInfo.id] {
             
-            let transformDiffItem: TransformDiffItem
+            let isSource = item.type == .moveSource
+            let fromSectionInfo = isSource ? sectionInfo : correspondingMoveItem.linkSectionInfo
+            let toSectionInfo = isSource ? correspondingMoveItem.linkSectionInfo : sectionInfo
+            isToIntro = toSectionInfo.toIsIntro
+            isFromIntro = fromSectionInfo.fromIsIntro
             
-            if let lineNumber = item.lineNumber {
-                lastLineNumber = lineNumber
-                transformDiffItem = TransformDiffItem(type: item.type, text: item.text, highlightRanges: item.highlightRanges, offset: item.offset, sectionTitle: nil, lineNumber: lineNumber, moveInfo: transformMoveInfo)
-            } else {
-                transformDiffItem = TransformDiffItem(type: item.type, text: item.text, highlightRanges: item.highlightRanges, offset: item.offset, sectionTitle: nil, lineNumber: lastLineNumber, moveInfo: transformMoveInfo)
+            if let from = fromSectionInfo.from,
+                let to = toSectionInfo.to,
+                from.title != to.title,
+                from.order != to.order {
+                moveDistance = .section(amount: abs(from.order - to.order))
             }
             
-            items.append(transformDiffItem)
+            if moveDistance == nil {
+                // fallback to line numbers
+                if let firstLineNumber = item.lineNumber,
+                    let nextLineNumber = correspondingMoveItem.linkItem.lineNumber {
+                    moveDistance = .line(amount: abs(firstLineNumber - nextLineNumber))
+                }
+            }
         }
         
-        return items
+        item.moveInfo = TransformMoveInfo(id: moveInfo.id, linkId: moveInfo.linkId, linkDirection: moveInfo.linkDirection, groupedIndex: groupedMoveIndexes[moveInfo.id], moveDistance: moveDistance)
+        
+        if item.sectionTitle == nil && isToIntro && isFromIntro {
+            item.sectionTitle = introSectionTitle
+        }
+    }
+    
+    private var introSectionTitle: String {
+        return WMFLocalizedString("diff-single-intro-title", value:"Intro", comment:"Section heading on revision changes diff screen that indicates the following highlighted changes occurred in the intro section.")
+    }
+    
+    // MARK: - Grouping
+    
+    /// The items of one list group, split out before any view models are made so the view models can be built concurrently
+    private enum TransformGroup {
+        case change(type: DiffListChangeType, items: [TransformDiffItem])
+        case context(items: [TransformDiffItem])
+        case unedited(numberOfLines: Int)
     }
     
-    private func viewModelsForSingle(from transformDiffItems: [TransformDiffItem], theme: Theme, traitCollection: UITraitCollection) -> [DiffListGroupViewModel] {
+    private func groupsForSingle(from transformDiffItems: [TransformDiffItem]) -> [TransformGroup] {
         
-        var result: [DiffListGroupViewModel] = []
+        var result: [TransformGroup] = []
         
         var sectionItems: [TransformDiffItem] = []
         var lastItem: TransformDiffItem?
-
-        let packageUpSectionItemsIfNeeded = {
-            
+        
+        func packageUpSectionItemsIfNeeded() {
             if sectionItems.count > 0 {
-                // package contexts up into change view model, append to result
-
-                let changeViewModel = DiffListChangeViewModel(type: .singleRevison, diffItems: sectionItems, theme: theme, width: 0, traitCollection: traitCollection, semanticContentAttribute: self.semanticContentAttribute)
-
-                result.append(changeViewModel)
+                result.append(.change(type: .singleRevison, items: sectionItems))
                 sectionItems.removeAll()
             }
-            
         }
         
-        for item in transformDiffItems {
-
+        for item in transformDiffItems where item.type != .context {
             
-            if item.type == .context {
-                
-                continue
-                
-            } else {
-                
-                if item.sectionTitle != lastItem?.sectionTitle {
-                    packageUpSectionItemsIfNeeded()
-                }
-                
-                sectionItems.append(item)
+            if item.sectionTitle != lastItem?.sectionTitle {
+                packageUpSectionItemsIfNeeded()
             }
             
+            sectionItems.append(item)
             lastItem = item
-            
-            continue
         }
         
         packageUpSectionItemsIfNeeded()
         
         return result
     }
+    
+    private func groupsForCompare(from transformDiffItems: [TransformDiffItem]) -> [TransformGroup] {
         
-    private func viewModelsForCompare(from transformDiffItems: [TransformDiffItem], theme: Theme, traitCollection: UITraitCollection) -> [DiffListGroupViewModel] {
-        
-        var result: [DiffListGroupViewModel] = []
+        var result: [TransformGroup] = []
         
         var contextItems: [TransformDiffItem] = []
         var changeItems: [TransformDiffItem] = []
         var lastItem: TransformDiffItem?
         
-        let packageUpContextItemsIfNeeded = {
-            
+        func packageUpContextItemsIfNeeded() {
             if contextItems.count > 0 {
-                // package contexts up into context view model, append to result
-                let contextViewModel = DiffListContextViewModel(diffItems: contextItems, isExpanded: UIAccessibility.isVoiceOverRunning, theme: theme, width: 0, traitCollection: traitCollection, semanticContentAttribute: self.semanticContentAttribute)
-                result.append(contextViewModel)
+                result.append(.context(items: contextItems))
                 contextItems.removeAll()
             }
         }
         
-        let packageUpChangeItemsIfNeeded = {
-            
+        func packageUpChangeItemsIfNeeded() {
             if changeItems.count > 0 {
-                // package contexts up into change view model, append to result
-
-                let changeViewModel = DiffListChangeViewModel(type: .compareRevision, diffItems: changeItems, theme: theme, width: 0, traitCollection: traitCollection, semanticContentAttribute: self.semanticContentAttribute)
-
-                result.append(changeViewModel)
+                result.append(.change(type: .compareRevision, items: changeItems))
                 changeItems.removeAll()
             }
-            
         }
         
         for item in transformDiffItems {
@@ -392,28 +299,20 @@ class DiffTransformer {
                     packageUpContextItemsIfNeeded()
                     packageUpChangeItemsIfNeeded()
                     
-                    // insert unedited lines view model
-                    let uneditedViewModel = DiffListUneditedViewModel(numberOfUneditedLines: delta, theme: theme, width: 0, traitCollection: traitCollection)
-                    result.append(uneditedViewModel)
+                    // insert unedited lines
+                    result.append(.unedited(numberOfLines: delta))
                 }
             }
             
             if item.type == .context {
-                
                 packageUpChangeItemsIfNeeded()
-                
                 contextItems.append(item)
-                
             } else {
-                
                 packageUpContextItemsIfNeeded()
-                
                 changeItems.append(item)
             }
             
             lastItem = item
-            
-            continue
         }
         
         packageUpContextItemsIfNeeded()
@@ -421,4 +320,36 @@ class DiffTransformer {
         
         return result
     }
+    
+    // MARK: - View models
+    
+    /// Groups don't depend on each other, so their view models (and the attributed strings they size themselves with) are built concurrently
+    private func makeViewModels(for groups: [TransformGroup], theme: Theme, traitCollection: UITraitCollection) -> [DiffListGroupViewModel] {
+        
+        guard !groups.isEmpty else {
+            return []
+        }
+        
+        // Read once up front rather than from each concurrent iteration
+        let semanticContentAttribute = self.semanticContentAttribute
+        let isVoiceOverRunning = UIAccessibility.isVoiceOverRunning
+        
+        var viewModels = [DiffListGroupViewModel?](repeating: nil, count: groups.count)
+        viewModels.withUnsafeMutableBufferPointer { buffer in
+            // Each iteration writes only its own element
+            let results = buffer
+            DispatchQueue.concurrentPerform(iterations: groups.count) { index in
+                switch groups[index] {
+                case .change(let type, let items):
+                    results[index] = DiffListChangeViewModel(type: type, diffItems: items, theme: theme, width: 0, traitCollection: traitCollection, semanticContentAttribute: semanticContentAttribute)
+                case .context(let items):
+                    results[index] = DiffListContextViewModel(diffItems: items, isExpanded: isVoiceOverRunning, theme: theme, width: 0, traitCollection: traitCollection, semanticContentAttribute: semanticContentAttribute)
+                case .unedited(let numberOfLines):
+                    results[index] = DiffListUneditedViewModel(numberOfUneditedLines: numberOfLines, theme: theme, width: 0, traitCollection: traitCollection)
+                }
+            }
+        }
+        
+        return viewModels.compactMap { $0 }
+    }
 }
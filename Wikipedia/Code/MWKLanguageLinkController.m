@@ -93,23 +93,12 @@ static NSString *const WMFPreviousLanguagesKey = @"WMFPreviousSelectedLanguagesK
 }
 
 + (nullable NSString *)languageCodeForISOLanguageCode:(nullable NSString *)isoLanguageCode {
-    // Map altISOCodes to languageCodes once for fast lookups
-    static dispatch_once_t onceToken;
-    static NSDictionary<NSString *, NSString *> *languageCodesByAltISOCode;
-    dispatch_once(&onceToken, ^{
-        NSMutableDictionary *tempDict = [[NSMutableDictionary alloc] init];
-        for (MWKLanguageLink *language in self.allLanguages) {
-            if (language.altISOCode) {
-                tempDict[language.altISOCode] = language.languageCode;
-            }
-        }
-        languageCodesByAltISOCode = [tempDict copy];
-    });
     if (!isoLanguageCode) {
         return nil;
     }
-    
-    NSString *languageCode = languageCodesByAltISOCode[isoLanguageCode];
+
+    // Look up altISOCodes without building allLanguages
+    NSString *languageCode = WikipediaLookup.languageCodesByAltISOCode[isoLanguageCode];
     return languageCode ? : isoLanguageCode; // If no alternative ISO code, use the original value
 }
 
@@ -118,15 +107,14 @@ static NSString *const WMFPreviousLanguagesKey = @"WMFPreviousSelectedLanguagesK
 }
 
 - (NSArray<MWKLanguageLink *> *)preferredLanguages {
-    // Without caching, every call does a database fetch and lookup through allLanguages
-    // even though the array contents change only when user updates preferred language settings
+    // Without caching, every call does a database fetch and lookup by language code
+    // even though the array contents change only when user updates preferred language settings.
+    // Links are looked up by code rather than matched in allLanguages so launch doesn't build every language.
     if (!self.cachedPreferredLanguages) {
         NSArray *preferredLanguageCodes = [self readPreferredLanguageCodes];
         self.cachedPreferredLanguages = [preferredLanguageCodes wmf_mapAndRejectNil:^id(NSString *isoLanguageCode) {
             NSString *contentLanguageCode = [MWKLanguageLinkController languageCodeForISOLanguageCode:isoLanguageCode];
-            return [self.allLanguages wmf_match:^BOOL(MWKLanguageLink *languageLink) {
-                return [languageLink.contentLanguageCode isEqualToString:contentLanguageCode];
-            }];
+            return [WikipediaLookup languageLinkForContentLanguageCode:contentLanguageCode];
         }];
     }
     return self.cachedPreferredLanguages;
@@ -62,8 +62,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSInteger)savedArticleCountFor:(NSDate *)startDate endDate:(NSDate *)endDate;
 
-- (NSArray<NSString *> *)randomSavedArticleTitlesFor:(NSDate *)startDate endDate:(NSDate *)endDate;
-- (NSArray<NSString *> *)randomSavedArticleImagesFor:(NSDate *)startDate endDate:(NSDate *)endDate;
+/// Up to three random display titles of articles saved between the dates. Fetched in the background, calling `completion` on the main queue.
+- (void)randomSavedArticleTitlesFor:(NSDate *)startDate endDate:(NSDate *)endDate completion:(void (^)(NSArray<NSString *> *titles))completion;
+
+/// Up to `limit` random thumbnail URL strings of articles saved between the dates. Fetched in the background, calling `completion` on the main queue.
+- (void)randomSavedArticleImagesFor:(NSDate *)startDate endDate:(NSDate *)endDate limit:(NSUInteger)limit completion:(void (^)(NSArray<NSString *> *imageURLStrings))completion;
 - (nullable NSDate *)lastSavedArticleDate;
 
 @end
@@ -9,6 +9,8 @@
 
 @end
 
+static const NSUInteger WMFSavedPageListRandomTitleCount = 3;
+
 @implementation MWKSavedPageList
 
 #pragma mark - Setup
@@ -160,65 +162,74 @@
     return [self.dataStore.viewContext countForFetchRequest:[self savedPageListFetchRequestForStartDate:startDate endDate:endDate filterNilDisplayTitles:NO] error:nil];
 }
 
-- (NSArray<NSString *> *)randomSavedArticleTitlesFor:(NSDate *)startDate endDate:(NSDate *)endDate {
+- (void)randomSavedArticleTitlesFor:(NSDate *)startDate endDate:(NSDate *)endDate completion:(void (^)(NSArray<NSString *> *titles))completion {
     NSFetchRequest *fetchRequest = [self savedPageListFetchRequestForStartDate:startDate endDate:endDate filterNilDisplayTitles:YES];
-
-    NSError *error = nil;
-    NSArray<WMFArticle *> *allArticles = [self.dataStore.viewContext executeFetchRequest:fetchRequest error:&error];
-
-    if (error) {
-        NSLog(@"Error fetching articles: %@", error);
-        return @[];
-    }
-
-    NSUInteger count = MIN(allArticles.count, 3);
-    if (count == 0) {
-        return @[];
-    }
-
-    NSMutableArray<NSString *> *randomArticles = [NSMutableArray arrayWithCapacity:count];
-    NSMutableArray<WMFArticle *> *mutableArticles = [allArticles mutableCopy];
-
-    for (NSUInteger i = 0; i < count; i++) {
-        NSUInteger randomIndex = arc4random_uniform((uint32_t)mutableArticles.count);
-        if (mutableArticles[randomIndex].displayTitle != nil) {
-            [randomArticles addObject:mutableArticles[randomIndex].displayTitle];
-            [mutableArticles removeObjectAtIndex:randomIndex]; // so we do not repeat articles
-        } else {
-            continue;
-        }
-    }
-
-    return [randomArticles copy];
+    [self fetchRandomValuesForKey:@"displayTitle" fetchRequest:fetchRequest limit:WMFSavedPageListRandomTitleCount completion:completion];
 }
 
-- (NSArray<NSString *> *)randomSavedArticleImagesFor:(NSDate *)startDate endDate:(NSDate *)endDate {
+- (void)randomSavedArticleImagesFor:(NSDate *)startDate endDate:(NSDate *)endDate limit:(NSUInteger)limit completion:(void (^)(NSArray<NSString *> *imageURLStrings))completion {
     NSFetchRequest *fetchRequest = [self savedPageListFetchRequestForStartDate:startDate endDate:endDate filterNilDisplayTitles:YES];
+    fetchRequest.predicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[fetchRequest.predicate, [NSPredicate predicateWithFormat:@"thumbnailURLString != nil"]]];
+    [self fetchRandomValuesForKey:@"thumbnailURLString" fetchRequest:fetchRequest limit:limit completion:completion];
+}
 
-    NSError *error = nil;
-    NSArray<WMFArticle *> *allArticles = [self.dataStore.viewContext executeFetchRequest:fetchRequest error:&error];
+/// Picks up to `limit` distinct rows at random from those matching `fetchRequest` and returns their values for `key`.
+/// Rows are counted, then fetched one at a time at random offsets as dictionaries holding only `key`, so memory use doesn't grow with the number of saved articles. Runs on a private queue context and calls `completion` on the main queue.
+- (void)fetchRandomValuesForKey:(NSString *)key fetchRequest:(NSFetchRequest *)fetchRequest limit:(NSUInteger)limit completion:(void (^)(NSArray<NSString *> *values))completion {
+    NSManagedObjectContext *moc = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    moc.persistentStoreCoordinator = self.dataStore.viewContext.persistentStoreCoordinator;
+    [moc performBlock:^{
+        NSArray<NSString *> *values = [MWKSavedPageList randomValuesForKey:key fetchRequest:fetchRequest limit:limit inManagedObjectContext:moc];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(values);
+        });
+    }];
+}
 
-    if (error) {
-        NSLog(@"Error fetching articles: %@", error);
++ (NSArray<NSString *> *)randomValuesForKey:(NSString *)key fetchRequest:(NSFetchRequest *)fetchRequest limit:(NSUInteger)limit inManagedObjectContext:(NSManagedObjectContext *)moc {
+    NSError *error = nil;
+    NSUInteger count = [moc countForFetchRequest:fetchRequest error:&error];
+    if (count == NSNotFound) {
+        DDLogError(@"Error counting articles: %@", error);
         return @[];
     }
 
-    if (allArticles.count == 0) {
+    NSUInteger sampleCount = MIN(count, limit);
+    if (sampleCount == 0) {
         return @[];
     }
 
-    NSMutableArray<NSString *> *randomArticleImages = [NSMutableArray arrayWithCapacity:allArticles.count];
-    NSMutableArray<WMFArticle *> *mutableArticles = [allArticles mutableCopy];
+    // Floyd's algorithm picks distinct offsets without building a list of every offset to choose from
+    NSMutableOrderedSet<NSNumber *> *offsets = [NSMutableOrderedSet orderedSetWithCapacity:sampleCount];
+    for (NSUInteger upperBound = count - sampleCount; upperBound < count; upperBound++) {
+        NSNumber *offset = @(arc4random_uniform((uint32_t)upperBound + 1));
+        [offsets addObject:[offsets containsObject:offset] ? @(upperBound) : offset];
+    }
+
+    fetchRequest.resultType = NSDictionaryResultType;
+    fetchRequest.propertiesToFetch = @[key];
+    fetchRequest.fetchLimit = 1;
 
-    for (NSUInteger i = 0; i < allArticles.count; i++) {
-        if (mutableArticles[i].thumbnailURLString != nil) {
-            [randomArticleImages addObject:mutableArticles[i].thumbnailURLString];
-        } else {
-            continue;
+    NSMutableArray<NSString *> *values = [NSMutableArray arrayWithCapacity:sampleCount];
+    for (NSNumber *offset in offsets) {
+        fetchRequest.fetchOffset = offset.unsignedIntegerValue;
+        NSDictionary *row = [[moc executeFetchRequest:fetchRequest error:&error] firstObject];
+        if (error) {
+            DDLogError(@"Error fetching articles: %@", error);
+            return @[];
         }
+        NSString *value = row[key];
+        if ([value isKindOfClass:[NSString class]]) {
+            [values addObject:value];
+        }
+    }
+
+    // Floyd's algorithm favors later offsets for the last picks, so shuffle to keep the order random too
+    for (NSUInteger i = values.count; i > 1; i--) {
+        [values exchangeObjectAtIndex:i - 1 withObjectAtIndex:arc4random_uniform((uint32_t)i)];
     }
 
-    return [randomArticleImages copy];
+    return [values copy];
 }
 
 - (nullable NSDate *)lastSavedArticleDate {
@@ -47,4 +47,11 @@
                             titleNamespace:(nullable NSNumber *)titleNamespace
                                   location:(nullable CLLocation *)location;
 
+/**
+ *  Conversions from search API values, shared by the Mantle transformers and the decoded search response.
+ */
++ (nullable NSString *)summaryFromExtract:(nullable NSString *)extract;
++ (nullable NSNumber *)geoTypeFromCoordinatesType:(nullable NSString *)type;
++ (nullable NSNumber *)geoDimensionFromCoordinatesDimension:(nullable NSString *)dim;
+
 @end
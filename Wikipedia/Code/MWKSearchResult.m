@@ -82,20 +82,24 @@
         }];
 }
 
-+ (MTLValueTransformer *)extractJSONTransformer {
-    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSString *extract, BOOL *success, NSError *__autoreleasing *error) {
-        // Remove trailing ellipsis added by the API
-        if ([extract hasSuffix:@"..."]) {
-            if (extract.length == 3) {
-                // HAX: sometimes the api gives us "..." for the extract, which is not useful and messes up how random
-                // weights relative quality of the random titles it retrieves.
-                extract = nil;
-            } else {
-                extract = [extract substringWithRange:NSMakeRange(0, extract.length - 3)];
-            }
++ (nullable NSString *)summaryFromExtract:(nullable NSString *)extract {
+    // Remove trailing ellipsis added by the API
+    if ([extract hasSuffix:@"..."]) {
+        if (extract.length == 3) {
+            // HAX: sometimes the api gives us "..." for the extract, which is not useful and messes up how random
+            // weights relative quality of the random titles it retrieves.
+            extract = nil;
+        } else {
+            extract = [extract substringWithRange:NSMakeRange(0, extract.length - 3)];
         }
+    }
 
-        return [extract wmf_summaryFromText];
+    return [extract wmf_summaryFromText];
+}
+
++ (MTLValueTransformer *)extractJSONTransformer {
+    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSString *extract, BOOL *success, NSError *__autoreleasing *error) {
+        return [self summaryFromExtract:extract];
     }];
 }
 
@@ -148,7 +152,7 @@
     }];
 }
 
-+ (NSValueTransformer *)geoTypeJSONTransformer {
++ (nullable NSNumber *)geoTypeFromCoordinatesType:(nullable NSString *)type {
     static NSDictionary *geoTypeLookup;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
@@ -172,54 +176,59 @@
                           @"landmark": @(WMFGeoTypeLandmark)};
     });
 
-    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSArray *value,
-                                                                 BOOL *success,
-                                                                 NSError *__autoreleasing *error) {
-        NSDictionary *coords = [value firstObject];
-        NSString *type = coords[@"type"];
+    if (![type isKindOfClass:[NSString class]]) {
+        return nil;
+    }
 
-        if (![type isKindOfClass:[NSString class]]) {
-            return nil;
-        }
+    type = [type lowercaseString];
 
-        type = [type lowercaseString];
+    if ([type hasPrefix:@"city"]) {
+        type = @"city";
+    }
 
-        if ([type hasPrefix:@"city"]) {
-            type = @"city";
-        }
+    return geoTypeLookup[type];
+}
 
-        return geoTypeLookup[type];
++ (NSValueTransformer *)geoTypeJSONTransformer {
+    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSArray *value,
+                                                                 BOOL *success,
+                                                                 NSError *__autoreleasing *error) {
+        NSDictionary *coords = [value firstObject];
+        return [self geoTypeFromCoordinatesType:coords[@"type"]];
     }];
 }
 
-+ (NSValueTransformer *)geoDimensionJSONTransformer {
++ (nullable NSNumber *)geoDimensionFromCoordinatesDimension:(nullable NSString *)dim {
     static dispatch_once_t onceToken;
     static NSCharacterSet *nonNumericCharacterSet;
     dispatch_once(&onceToken, ^{
         nonNumericCharacterSet = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
     });
-    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSArray *value,
-                                                                 BOOL *success,
-                                                                 NSError *__autoreleasing *error) {
-        NSDictionary *coords = [value firstObject];
-        NSString *dim = coords[@"dim"];
 
-        if (![dim isKindOfClass:[NSString class]]) {
-            return nil;
-        }
+    if (![dim isKindOfClass:[NSString class]]) {
+        return nil;
+    }
 
-        NSString *dimToParse = [dim stringByTrimmingCharactersInSet:nonNumericCharacterSet];
-        long long dimension = [dimToParse longLongValue];
-        if (dimension == 0) {
-            return nil;
-        }
+    NSString *dimToParse = [dim stringByTrimmingCharactersInSet:nonNumericCharacterSet];
+    long long dimension = [dimToParse longLongValue];
+    if (dimension == 0) {
+        return nil;
+    }
 
-        dim = [dim lowercaseString];
-        if ([dim hasSuffix:@"km"]) {
-            dimension = dimension * 1000;
-        }
+    dim = [dim lowercaseString];
+    if ([dim hasSuffix:@"km"]) {
+        dimension = dimension * 1000;
+    }
+
+    return @(dimension);
+}
 
-        return @(dimension);
++ (NSValueTransformer *)geoDimensionJSONTransformer {
+    return [MTLValueTransformer transformerUsingForwardBlock:^id(NSArray *value,
+                                                                 BOOL *success,
+                                                                 NSError *__autoreleasing *error) {
+        NSDictionary *coords = [value firstObject];
+        return [self geoDimensionFromCoordinatesDimension:coords[@"dim"]];
     }];
 }
 
@@ -0,0 +1,237 @@
+import Foundation
+import CocoaLumberjackSwift
+
+/// Waits for mobile-html ETags to change, e.g. after an edit is saved.
+/// All pending waits share one background scheduler. Waits on the same URL are polled together with a single HEAD request that carries every ETag being waited on, polls back off exponentially with jitter, and no more than `maxConcurrentPollsPerHost` polls run against a host at once.
+/// Each wait has its own attempt budget and backoff: one that joins a poll already under way is checked straight away and only counts the polls it was part of.
+final class MobileHTMLChangeWaiter {
+
+    static let shared = MobileHTMLChangeWaiter()
+
+    typealias Completion = (Result<String, Error>) -> Void
+
+    static let baseDelay: TimeInterval = 0.25
+    static let maxConcurrentPollsPerHost = 2
+
+    private final class Waiter {
+        let key: String
+        let eTag: String
+        let maxAttempts: Int
+        let startDate = Date()
+        let completion: Completion
+        var attempts = 0
+        /// Whether the poll in flight asked about this waiter's ETag. Waiters that join while a poll is in flight wait for the next one.
+        var isInFlight = false
+
+        init(key: String, eTag: String, maxAttempts: Int, completion: @escaping Completion) {
+            self.key = key
+            self.eTag = eTag
+            self.maxAttempts = maxAttempts
+            self.completion = completion
+        }
+    }
+
+    private final class Poll {
+        let url: URL
+        let session: Session
+        var waiters: [Waiter] = []
+        var nextPollDate = Date()
+        var isInFlight = false
+
+        init(url: URL, session: Session) {
+            self.url = url
+            self.session = session
+        }
+
+        var host: String {
+            return url.host ?? ""
+        }
+    }
+
+    // All state below is only touched on queue
+    private let queue = DispatchQueue(label: "org.wikimedia.wikipedia.mobileHTMLChangeWaiter", qos: .utility)
+    private var timer: DispatchSourceTimer?
+    private var polls: [URL: Poll] = [:]
+    private var inFlightPollCountsByHost: [String: Int] = [:]
+    private var changeCount = 0
+    private var totalTimeToChange: TimeInterval = 0
+
+    /// Average time from starting a wait to seeing the new ETag, across every wait that succeeded this launch
+    var averageTimeToChange: TimeInterval? {
+        return queue.sync {
+            guard changeCount > 0 else {
+                return nil
+            }
+            return totalTimeToChange / Double(changeCount)
+        }
+    }
+
+    /// Calls completion with the new ETag once `url` stops matching `eTag`, or with an error after `maxAttempts` polls. Completion is called on a background queue.
+    func wait(for url: URL, eTag: String, maxAttempts: Int, session: Session, key: String, completion: @escaping Completion) {
+        queue.async {
+            guard maxAttempts > 0 else {
+                completion(.failure(ArticleFetcherError.updatedContentRequestTimeout))
+                return
+            }
+
+            let poll: Poll
+            if let existingPoll = self.polls[url] {
+                poll = existingPoll
+            } else {
+                poll = Poll(url: url, session: session)
+                self.polls[url] = poll
+            }
+            poll.waiters.append(Waiter(key: key, eTag: eTag, maxAttempts: maxAttempts, completion: completion))
+            // A new waiter doesn't inherit the backoff of the waiters already polling this URL
+            poll.nextPollDate = min(poll.nextPollDate, Date())
+            self.schedule()
+        }
+    }
+
+    /// Drops the wait without calling its completion. A poll already in flight for other waiters is left running.
+    func cancel(key: String) {
+        queue.async {
+            for (url, poll) in self.polls {
+                poll.waiters.removeAll { $0.key == key }
+                if poll.waiters.isEmpty && !poll.isInFlight {
+                    self.polls.removeValue(forKey: url)
+                }
+            }
+            self.schedule()
+        }
+    }
+
+    // MARK: - Scheduling
+
+    /// Starts every poll that is due and allowed by its host's cap, then sets the single timer for the next poll that isn't.
+    private func schedule() {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        let now = Date()
+        var nextPollDate: Date?
+
+        for poll in polls.values.sorted(by: { $0.nextPollDate < $1.nextPollDate }) where !poll.isInFlight && !poll.waiters.isEmpty {
+            guard poll.nextPollDate <= now else {
+                nextPollDate = min(nextPollDate ?? poll.nextPollDate, poll.nextPollDate)
+                continue
+            }
+
+            // Polls held back by the host cap are reconsidered when one of that host's polls finishes
+            guard inFlightPollCountsByHost[poll.host, default: 0] < Self.maxConcurrentPollsPerHost else {
+                continue
+            }
+
+            start(poll)
+        }
+
+        timer?.cancel()
+        timer = nil
+
+        guard let nextPollDate else {
+            return
+        }
+
+        let timer = DispatchSource.makeTimerSource(queue: queue)
+        timer.schedule(deadline: .now() + max(0, nextPollDate.timeIntervalSinceNow))
+        timer.setEventHandler { [weak self] in
+            self?.schedule()
+        }
+        timer.resume()
+        self.timer = timer
+    }
+
+    private func start(_ poll: Poll) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        // If-None-Match accepts a list, so one request answers every waiter on this URL
+        let eTags = Set(poll.waiters.map { $0.eTag }).sorted().joined(separator: ", ")
+        let maybeTask = poll.session.dataTask(with: poll.url, method: .head, headers: [URLRequest.ifNoneMatchHeaderKey: eTags], cachePolicy: .reloadIgnoringLocalCacheData) { [weak self] (_, response, error) in
+            self?.queue.async {
+                self?.finish(poll, response: response, error: error)
+            }
+        }
+
+        guard let task = maybeTask else {
+            polls.removeValue(forKey: poll.url)
+            poll.waiters.forEach { $0.completion(.failure(RequestError.unknown)) }
+            return
+        }
+
+        poll.isInFlight = true
+        poll.waiters.forEach { $0.isInFlight = true }
+        inFlightPollCountsByHost[poll.host, default: 0] += 1
+        task.resume()
+    }
+
+    private func finish(_ poll: Poll, response: URLResponse?, error: Error?) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        poll.isInFlight = false
+        inFlightPollCountsByHost[poll.host, default: 1] -= 1
+
+        defer {
+            schedule()
+        }
+
+        // Every waiter on this poll was cancelled while it was in flight, and a new poll may since have taken its place
+        guard polls[poll.url] === poll else {
+            return
+        }
+
+        if let error = error {
+            fail(poll, with: error)
+            return
+        }
+
+        guard let httpURLResponse = response as? HTTPURLResponse else {
+            fail(poll, with: RequestError.unexpectedResponse)
+            return
+        }
+
+        // The server returns 304 when the current ETag is one of the values we provided for `If-None-Match`. Either way, the ETag header names the current content, so every waiter holding a different ETag has seen a change.
+        switch httpURLResponse.statusCode {
+        case 200, 304:
+            break
+        default:
+            fail(poll, with: RequestError.unexpectedResponse)
+            return
+        }
+
+        let polledWaiters = poll.waiters.filter { $0.isInFlight }
+        polledWaiters.forEach { $0.isInFlight = false }
+
+        if let currentETag = httpURLResponse.allHeaderFields[HTTPURLResponse.etagHeaderKey] as? String {
+            let now = Date()
+            let changedWaiters = polledWaiters.filter { $0.eTag != currentETag }
+            poll.waiters.removeAll { waiter in changedWaiters.contains { $0 === waiter } }
+            for waiter in changedWaiters {
+                changeCount += 1
+                totalTimeToChange += now.timeIntervalSince(waiter.startDate)
+                DDLogDebug("ETag for \(poll.url) changed from \(waiter.eTag) to \(currentETag) after \(String(format: "%.2f", now.timeIntervalSince(waiter.startDate)))s (average \(String(format: "%.2f", totalTimeToChange / Double(changeCount)))s)")
+                waiter.completion(.success(currentETag))
+            }
+        }
+
+        for waiter in polledWaiters {
+            waiter.attempts += 1
+        }
+        let timedOutWaiters = poll.waiters.filter { $0.attempts >= $0.maxAttempts }
+        poll.waiters.removeAll { $0.attempts >= $0.maxAttempts }
+        timedOutWaiters.forEach { $0.completion(.failure(ArticleFetcherError.updatedContentRequestTimeout)) }
+
+        guard !poll.waiters.isEmpty else {
+            polls.removeValue(forKey: poll.url)
+            return
+        }
+
+        // Exponential backoff with jitter, so waits started together don't keep polling in lockstep. The backoff follows the newest waiter, so joining a long-running poll doesn't leave a wait at that poll's delay.
+        let attempts = poll.waiters.map { $0.attempts }.min() ?? 0
+        let delay = attempts == 0 ? 0 : Self.baseDelay * pow(2, Double(attempts - 1)) * Double.random(in: 0.5...1.5)
+        poll.nextPollDate = Date().addingTimeInterval(delay)
+    }
+
+    private func fail(_ poll: Poll, with error: Error) {
+        polls.removeValue(forKey: poll.url)
+        poll.waiters.forEach { $0.completion(.failure(error)) }
+    }
+}
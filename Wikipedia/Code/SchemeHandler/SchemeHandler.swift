@@ -1,4 +1,5 @@
 import WebKit
+import CocoaLumberjackSwift
 import WMFNativeLocalizations
 import WMFData
 
@@ -13,12 +14,40 @@ enum SchemeHandlerError: Error {
 }
 
 class SchemeHandler: NSObject {
+    
+    // Holds a scheme task weakly so it can be passed through background queues. Only read task on the main thread.
+    struct WeakSchemeTask {
+        weak var task: WKURLSchemeTask?
+        
+        init(_ task: WKURLSchemeTask) {
+            self.task = task
+        }
+    }
+    
+    private struct MainThreadUsage {
+        var busyTime: CFTimeInterval = 0
+        var dispatchCount = 0
+    }
+    
     let scheme: String
     open var didReceiveDataCallback: ((WKURLSchemeTask, Data) -> Void)?
     private let session: Session
-    private var activeSessionTasks: [URLRequest: URLSessionTask] = [:]
-    private var activeCacheOperations: [URLRequest: Operation] = [:]
+    
+    // Main thread only. Task state is keyed by an ID handed out when the task starts, which is far cheaper to hash than its URLRequest.
+    // Scheme task addresses can be reused by WebKit once a task is released, so they are only mapped to an ID while activeSchemeTasks holds the task.
+    private var nextTaskID = 0
+    private var taskIDsBySchemeTask: [ObjectIdentifier: Int] = [:]
+    private var activeCacheOperations: [Int: Operation] = [:]
     private var activeSchemeTasks = NSMutableSet(array: [])
+    private var activeRevalidationURLs: Set<URL> = []
+    private var pageLoadMainThreadUsage = MainThreadUsage()
+    
+    // taskQueue only
+    private let taskQueue = DispatchQueue(label: "org.wikimedia.wikipedia.schemeHandler", qos: .userInitiated)
+    private var activeSessionTasks: [Int: URLSessionTask] = [:]
+    private var pendingData: [Int: Data] = [:]
+    private static let maxPendingDataLength = 64 * 1024
+    private static let pendingDataFlushDelay: DispatchTimeInterval = .milliseconds(16)
     
     private let cacheQueue: OperationQueue = OperationQueue()
     private let pageLoadMeasurementUrlString = "page/mobile-html/"
@@ -63,20 +92,40 @@ extension SchemeHandler: WKURLSchemeHandler {
             return
         }
         
-        addSchemeTask(urlSchemeTask: urlSchemeTask)
+        let taskID = addSchemeTask(urlSchemeTask: urlSchemeTask)
+        
+        if isPageLoadMeasurementRequest(urlSchemeTask.request) {
+            SessionsFunnel.shared.setPageLoadStartTime()
+            pageLoadMainThreadUsage = MainThreadUsage()
+        }
+        
+        let canServeFromCache = canServeFromPermanentCache(request: request)
 
         // IMPORTANT: Ensure the urlSchemeTask is not strongly captured by this block operation
         // Otherwise it will sometimes be deallocated on a non-main thread, causing a crash https://phabricator.wikimedia.org/T224113
-        let op = BlockOperation { [weak urlSchemeTask] in
-            DispatchQueue.main.async {
+        let op = BlockOperation { [weak urlSchemeTask, weak self] in
+            
+            // Saved articles are read straight from the permanent cache here, off the main thread, rather than waiting on a network round trip that only falls back to the cache on error.
+            let cachedResponse = canServeFromCache ? self?.session.persistedResponseForURLRequest(request) : nil
+            
+            guard let self else {
+                return
+            }
+            
+            self.performOnMain {
+                self.activeCacheOperations.removeValue(forKey: taskID)
                 guard let urlSchemeTask = urlSchemeTask else {
                     return
                 }
-                self.activeCacheOperations.removeValue(forKey: urlSchemeTask.request)
-                self.kickOffDataTask(request: request, urlSchemeTask: urlSchemeTask)
+                
+                if let cachedResponse {
+                    self.finishFromPermanentCache(cachedResponse: cachedResponse, request: request, urlSchemeTask: urlSchemeTask)
+                } else {
+                    self.kickOffDataTask(request: request, urlSchemeTask: urlSchemeTask, taskID: taskID)
+                }
             }
         }
-        activeCacheOperations[urlSchemeTask.request] = op
+        activeCacheOperations[taskID] = op
         cacheQueue.addOperation(op)
         
     }
@@ -84,22 +133,13 @@ extension SchemeHandler: WKURLSchemeHandler {
     func webView(_ webView: WKWebView, stop urlSchemeTask: WKURLSchemeTask) {
         assert(Thread.isMainThread)
         
-        removeSchemeTask(urlSchemeTask: urlSchemeTask)
-        
-        if let task = activeSessionTasks[urlSchemeTask.request] {
-            removeSessionTask(request: urlSchemeTask.request)
-
-            switch task.state {
-            case .canceling:
-                fallthrough
-            case .completed:
-                break
-            default:
-                task.cancel()
-            }
+        guard let taskID = removeSchemeTask(urlSchemeTask: urlSchemeTask) else {
+            return
         }
         
-        if let op = activeCacheOperations.removeValue(forKey: urlSchemeTask.request) {
+        cancelSessionTask(taskID: taskID)
+        
+        if let op = activeCacheOperations.removeValue(forKey: taskID) {
             op.cancel()
         }
     }
@@ -153,102 +193,172 @@ private extension SchemeHandler {
         return type.hasPrefix("image")
     }
     
-    func kickOffDataTask(request: URLRequest, urlSchemeTask: WKURLSchemeTask) {
+    func isPageLoadMeasurementRequest(_ request: URLRequest) -> Bool {
+        return ((request.url?.absoluteString) ?? "").contains(pageLoadMeasurementUrlString)
+    }
+    
+    // Only plain GETs that are allowed to use the permanent cache qualify. Reloads (e.g. after an edit) and .noPersistentCacheOnError requests always go to the network.
+    func canServeFromPermanentCache(request: URLRequest) -> Bool {
+        guard (request.httpMethod ?? "GET") == "GET",
+              request.prefersPersistentCacheOverError,
+              request.allHTTPHeaderFields?[Header.persistentCacheItemType] != nil else {
+            return false
+        }
+        
+        switch request.cachePolicy {
+        case .reloadIgnoringLocalCacheData, .reloadIgnoringLocalAndRemoteCacheData, .reloadRevalidatingCacheData:
+            return false
+        default:
+            return true
+        }
+    }
+    
+    func finishFromPermanentCache(cachedResponse: CachedURLResponse, request: URLRequest, urlSchemeTask: WKURLSchemeTask) {
         guard schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
-             return
-         }
+            return
+        }
         
-        // IMPORTANT: Ensure the urlSchemeTask is not strongly captured by the callback blocks.
-        // Otherwise it will sometimes be deallocated on a non-main thread, causing a crash https://phabricator.wikimedia.org/T224113
+        urlSchemeTask.didReceive(cachedResponse.response)
+        urlSchemeTask.didReceive(cachedResponse.data)
+        didReceiveDataCallback?(urlSchemeTask, cachedResponse.data)
+        urlSchemeTask.didFinish()
+        removeSchemeTask(urlSchemeTask: urlSchemeTask)
         
-        if ((urlSchemeTask.request.url?.absoluteString) ?? "").contains(pageLoadMeasurementUrlString) {
-            SessionsFunnel.shared.setPageLoadStartTime()
+        if isPageLoadMeasurementRequest(urlSchemeTask.request) {
+            SessionsFunnel.shared.endPageLoadStartTime(servedFromCache: true)
+            logPageLoadMainThreadUsage()
+        }
+        
+        revalidatePermanentCacheInBackground(request: request)
+    }
+    
+    // Checks the served article against the server's ETag. A 200 updates the permanent cache through the session's URLCache, so the next load picks up the change; a 304 leaves it untouched.
+    // Images are keyed by immutable URLs and are not revalidated.
+    func revalidatePermanentCacheInBackground(request: URLRequest) {
+        assert(Thread.isMainThread)
+        
+        guard request.allHTTPHeaderFields?[Header.persistentCacheItemType] == Header.PersistItemType.article.rawValue,
+              let url = request.url,
+              !activeRevalidationURLs.contains(url) else {
+            return
         }
         
-        let callback = Session.Callback(response: {  [weak urlSchemeTask] response in
+        var revalidationRequest = request
+        revalidationRequest.cachePolicy = .reloadIgnoringLocalCacheData
+        
+        let task = session.dataTask(with: revalidationRequest) { [weak self] _, _, _ in
             DispatchQueue.main.async {
-                guard let urlSchemeTask = urlSchemeTask else {
-                    return
-                }
-                guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
-                    return
-                }
-                if let httpResponse = response as? HTTPURLResponse, !HTTPStatusCode.isSuccessful(httpResponse.statusCode) {
-                    let error = RequestError.from(code: httpResponse.statusCode)
-                    self.removeSessionTask(request: urlSchemeTask.request)
-                    urlSchemeTask.didFailWithError(error)
-                    self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
-                    
-                    if ((urlSchemeTask.request.url?.absoluteString) ?? "").contains(self.pageLoadMeasurementUrlString) {
-                        SessionsFunnel.shared.clearPageLoadStartTime()
+                self?.activeRevalidationURLs.remove(url)
+            }
+        }
+        
+        guard let task else {
+            return
+        }
+        
+        activeRevalidationURLs.insert(url)
+        task.priority = URLSessionTask.lowPriority
+        task.resume()
+    }
+    
+    func kickOffDataTask(request: URLRequest, urlSchemeTask: WKURLSchemeTask, taskID: Int) {
+        guard schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
+             return
+         }
+        
+        // IMPORTANT: Ensure the urlSchemeTask is not strongly captured by the callback blocks, and is only unwrapped on the main thread.
+        // Otherwise it will sometimes be deallocated on a non-main thread, causing a crash https://phabricator.wikimedia.org/T224113
+        let weakSchemeTask = WeakSchemeTask(urlSchemeTask)
+        
+        // Session callbacks arrive on the session delegate queue. Each one hops through taskQueue, so work reaches the main queue in the order it happened.
+        let callback = Session.Callback(response: { response in
+            self.taskQueue.async {
+                self.performOnMain {
+                    guard let urlSchemeTask = weakSchemeTask.task else {
+                        return
                     }
-                } else {
-                    
-                    // May fix potential crashes if we have already called urlSchemeTask.didFinish() or webView(_ webView: WKWebView, stop urlSchemeTask: WKURLSchemeTask) has already been called.
-                    // https://developer.apple.com/documentation/webkit/wkurlschemetask/2890839-didreceive
                     guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
                         return
                     }
-                    
-                    urlSchemeTask.didReceive(response)
+                    if let httpResponse = response as? HTTPURLResponse, !HTTPStatusCode.isSuccessful(httpResponse.statusCode) {
+                        let error = RequestError.from(code: httpResponse.statusCode)
+                        self.removeSessionTask(taskID: taskID)
+                        urlSchemeTask.didFailWithError(error)
+                        self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
+                        
+                        if self.isPageLoadMeasurementRequest(urlSchemeTask.request) {
+                            SessionsFunnel.shared.clearPageLoadStartTime()
+                            self.logPageLoadMainThreadUsage()
+                        }
+                    } else {
+                        
+                        // May fix potential crashes if we have already called urlSchemeTask.didFinish() or webView(_ webView: WKWebView, stop urlSchemeTask: WKURLSchemeTask) has already been called.
+                        // https://developer.apple.com/documentation/webkit/wkurlschemetask/2890839-didreceive
+                        guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
+                            return
+                        }
+                        
+                        urlSchemeTask.didReceive(response)
+                    }
                 }
             }
-        }, data: { [weak urlSchemeTask] data in
-            
-            DispatchQueue.main.async {
-                guard let urlSchemeTask = urlSchemeTask else {
-                    return
-                }
-                guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
-                    return
-                }
-                urlSchemeTask.didReceive(data)
-                self.didReceiveDataCallback?(urlSchemeTask, data)
+        }, data: { data in
+            self.taskQueue.async {
+                self.appendPendingData(data, taskID: taskID, schemeTask: weakSchemeTask)
             }
-        }, success: { [weak urlSchemeTask, weak self] usedPermanentCache in
+        }, success: { [weak self] usedPermanentCache in
             
             guard let self else {
                 return
             }
             
-            DispatchQueue.main.async {
-                guard let urlSchemeTask = urlSchemeTask else {
-                    return
-                }
-                guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
-                    return
-                }
-                urlSchemeTask.didFinish()
-                self.removeSessionTask(request: urlSchemeTask.request)
-                self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
+            self.taskQueue.async {
+                self.flushPendingData(taskID: taskID, schemeTask: weakSchemeTask)
+                self.activeSessionTasks.removeValue(forKey: taskID)
                 
-                if ((urlSchemeTask.request.url?.absoluteString) ?? "").contains(self.pageLoadMeasurementUrlString) {
+                self.performOnMain {
+                    guard let urlSchemeTask = weakSchemeTask.task else {
+                        return
+                    }
+                    guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
+                        return
+                    }
+                    urlSchemeTask.didFinish()
+                    self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
                     
-                    // To reduce inaccurate load times, do not consider load time if we had to lean on our local permanent cache (i.e. Saved Articles)
-                    if usedPermanentCache {
-                        SessionsFunnel.shared.clearPageLoadStartTime()
-                    } else {
-                        SessionsFunnel.shared.endPageLoadStartTime()
+                    if self.isPageLoadMeasurementRequest(urlSchemeTask.request) {
+                        
+                        // To reduce inaccurate load times, do not consider load time if we had to lean on our local permanent cache after a network error
+                        if usedPermanentCache {
+                            SessionsFunnel.shared.clearPageLoadStartTime()
+                        } else {
+                            SessionsFunnel.shared.endPageLoadStartTime()
+                        }
+                        self.logPageLoadMainThreadUsage()
                     }
                 }
             }
             
-        }, failure: { [weak urlSchemeTask] error in
+        }, failure: { error in
             
-            DispatchQueue.main.async {
+            self.taskQueue.async {
+                self.pendingData.removeValue(forKey: taskID)
+                self.activeSessionTasks.removeValue(forKey: taskID)
                 
-                guard let urlSchemeTask = urlSchemeTask else {
-                    return
-                }
-                guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
-                    return
-                }
-                self.removeSessionTask(request: urlSchemeTask.request)
-                urlSchemeTask.didFailWithError(error)
-                self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
-                
-                if ((urlSchemeTask.request.url?.absoluteString) ?? "").contains(self.pageLoadMeasurementUrlString) {
-                    SessionsFunnel.shared.clearPageLoadStartTime()
+                self.performOnMain {
+                    guard let urlSchemeTask = weakSchemeTask.task else {
+                        return
+                    }
+                    guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
+                        return
+                    }
+                    urlSchemeTask.didFailWithError(error)
+                    self.removeSchemeTask(urlSchemeTask: urlSchemeTask)
+                    
+                    if self.isPageLoadMeasurementRequest(urlSchemeTask.request) {
+                        SessionsFunnel.shared.clearPageLoadStartTime()
+                        self.logPageLoadMainThreadUsage()
+                    }
                 }
             }
             
@@ -259,33 +369,119 @@ private extension SchemeHandler {
         })
         
         if let dataTask = session.dataTask(with: request, callback: callback) {
-            addSessionTask(request: request, dataTask: dataTask)
+            addSessionTask(taskID: taskID, dataTask: dataTask)
             dataTask.resume()
         }
     }
     
+    // MARK: - Data delivery
+    
+    // Network chunks are often only a few KB. They are gathered here and handed to WebKit together once the buffer is full or has waited pendingDataFlushDelay, instead of one main queue hop per chunk.
+    func appendPendingData(_ data: Data, taskID: Int, schemeTask: WeakSchemeTask) {
+        dispatchPrecondition(condition: .onQueue(taskQueue))
+        
+        let isFirstPendingChunk = pendingData[taskID]?.isEmpty ?? true
+        pendingData[taskID, default: Data()].append(data)
+        
+        if (pendingData[taskID]?.count ?? 0) >= Self.maxPendingDataLength {
+            flushPendingData(taskID: taskID, schemeTask: schemeTask)
+        } else if isFirstPendingChunk {
+            taskQueue.asyncAfter(deadline: .now() + Self.pendingDataFlushDelay) {
+                self.flushPendingData(taskID: taskID, schemeTask: schemeTask)
+            }
+        }
+    }
+    
+    func flushPendingData(taskID: Int, schemeTask: WeakSchemeTask) {
+        dispatchPrecondition(condition: .onQueue(taskQueue))
+        
+        guard let data = pendingData.removeValue(forKey: taskID), !data.isEmpty else {
+            return
+        }
+        
+        performOnMain {
+            guard let urlSchemeTask = schemeTask.task else {
+                return
+            }
+            guard self.schemeTaskIsActive(urlSchemeTask: urlSchemeTask) else {
+                return
+            }
+            urlSchemeTask.didReceive(data)
+            self.didReceiveDataCallback?(urlSchemeTask, data)
+        }
+    }
+    
+    // Runs block on the main queue, adding the time it takes to the current page load's main thread usage.
+    func performOnMain(_ block: @escaping () -> Void) {
+        DispatchQueue.main.async {
+            let startTime = CACurrentMediaTime()
+            block()
+            self.pageLoadMainThreadUsage.busyTime += CACurrentMediaTime() - startTime
+            self.pageLoadMainThreadUsage.dispatchCount += 1
+        }
+    }
+    
+    func logPageLoadMainThreadUsage() {
+        assert(Thread.isMainThread)
+        DDLogDebug("Scheme handler page load main thread usage: \(Int(round(pageLoadMainThreadUsage.busyTime * 1000)))ms over \(pageLoadMainThreadUsage.dispatchCount) dispatches")
+    }
+    
+    // MARK: - Task bookkeeping
+    
     func schemeTaskIsActive(urlSchemeTask: WKURLSchemeTask) -> Bool {
         assert(Thread.isMainThread)
         return activeSchemeTasks.contains(urlSchemeTask)
     }
     
-    func removeSchemeTask(urlSchemeTask: WKURLSchemeTask) {
+    // Returns the task's ID, or nil if the task had already been removed.
+    @discardableResult
+    func removeSchemeTask(urlSchemeTask: WKURLSchemeTask) -> Int? {
         assert(Thread.isMainThread)
+        guard activeSchemeTasks.contains(urlSchemeTask) else {
+            return nil
+        }
         activeSchemeTasks.remove(urlSchemeTask)
+        return taskIDsBySchemeTask.removeValue(forKey: ObjectIdentifier(urlSchemeTask))
     }
     
-    func removeSessionTask(request: URLRequest) {
+    // Hands out a new ID on every start, so deferred work for a stopped task can never act on a later task.
+    func addSchemeTask(urlSchemeTask: WKURLSchemeTask) -> Int {
         assert(Thread.isMainThread)
-        activeSessionTasks.removeValue(forKey: request)
+        nextTaskID += 1
+        activeSchemeTasks.add(urlSchemeTask)
+        taskIDsBySchemeTask[ObjectIdentifier(urlSchemeTask)] = nextTaskID
+        return nextTaskID
     }
     
-    func addSchemeTask(urlSchemeTask: WKURLSchemeTask) {
-        assert(Thread.isMainThread)
-        activeSchemeTasks.add(urlSchemeTask)
+    func removeSessionTask(taskID: Int) {
+        taskQueue.async {
+            self.activeSessionTasks.removeValue(forKey: taskID)
+            self.pendingData.removeValue(forKey: taskID)
+        }
     }
     
-    func addSessionTask(request: URLRequest, dataTask: URLSessionTask) {
-        assert(Thread.isMainThread)
-        activeSessionTasks[request] = dataTask
+    func addSessionTask(taskID: Int, dataTask: URLSessionTask) {
+        taskQueue.async {
+            self.activeSessionTasks[taskID] = dataTask
+        }
+    }
+    
+    func cancelSessionTask(taskID: Int) {
+        taskQueue.async {
+            self.pendingData.removeValue(forKey: taskID)
+            
+            guard let task = self.activeSessionTasks.removeValue(forKey: taskID) else {
+                return
+            }
+            
+            switch task.state {
+            case .canceling:
+                fallthrough
+            case .completed:
+                break
+            default:
+                task.cancel()
+            }
+        }
     }
 }
@@ -0,0 +1,146 @@
+import Foundation
+import CocoaLumberjackSwift
+import WMFData
+
+/// Titles from history, saved articles and recent results for each site, keyed by host, so search suggestions can show on the first keystroke without waiting on the network.
+///
+/// Building a site's index means a Core Data fetch, so indexes are kept for the few most recently searched sites only. A site's index is dropped when an article on it is saved or unsaved, and rebuilt the next time that site is searched.
+/// Main thread only.
+final class SearchLocalSuggestionStore {
+
+    private let dataStore: MWKDataStore
+
+    private var tries: [String: WMFTitlePrefixTrie<MWKSearchResult>] = [:]
+    /// Hosts with an index, least recently used first
+    private var hostsByRecentUse: [String] = []
+    /// A token for each index being built. Invalidating a host forgets its token, so an index that started loading before then is dropped on arrival.
+    private var loadTokensByHost: [String: UUID] = [:]
+
+    private let maxHostCount: Int
+    private let maxTitleCount: Int
+    private static let articleFetchLimit = 2000
+
+    // Saved articles rank above history, which ranks above titles that only came up in a recent search
+    private static let savedArticleWeight = 3.0
+    private static let viewedArticleWeight = 2.0
+    private static let recentResultWeight = 1.0
+
+    init(dataStore: MWKDataStore, maxHostCount: Int = 3, maxTitleCount: Int = 3000) {
+        self.dataStore = dataStore
+        self.maxHostCount = maxHostCount
+        self.maxTitleCount = maxTitleCount
+        NotificationCenter.default.addObserver(self, selector: #selector(userDidSaveOrUnsaveArticle(_:)), name: WMFReadingListsController.userDidSaveOrUnsaveArticleNotification, object: nil)
+    }
+
+    deinit {
+        NotificationCenter.default.removeObserver(self)
+    }
+
+    /// The index for `siteURL`, or nil if it has not been built yet. Starts building it in the background if needed.
+    func suggestionTrie(for siteURL: URL) -> WMFTitlePrefixTrie<MWKSearchResult>? {
+        assert(Thread.isMainThread)
+        guard let host = siteURL.host else {
+            return nil
+        }
+
+        guard let trie = tries[host] else {
+            loadIfNeeded(host: host)
+            return nil
+        }
+
+        hostsByRecentUse.removeAll { $0 == host }
+        hostsByRecentUse.append(host)
+        return trie
+    }
+
+    /// Adds titles from network results to an index that is already built. Titles already there from history or saved articles keep their higher weight, but pick up the fresher result.
+    func addRecentResults(_ results: [MWKSearchResult], siteURL: URL) {
+        assert(Thread.isMainThread)
+        guard let host = siteURL.host,
+              let trie = tries[host] else {
+            return
+        }
+
+        for result in results {
+            guard trie.count < maxTitleCount else {
+                return
+            }
+            guard let title = result.title else {
+                continue
+            }
+            trie.insert(result, forTitle: title, weight: Self.recentResultWeight)
+        }
+    }
+
+    /// Drops the index for `host`, or for every site if `host` is nil. Indexes still loading are dropped when they arrive.
+    func invalidate(host: String? = nil) {
+        assert(Thread.isMainThread)
+        guard let host else {
+            tries.removeAll()
+            hostsByRecentUse.removeAll()
+            loadTokensByHost.removeAll()
+            return
+        }
+        tries.removeValue(forKey: host)
+        hostsByRecentUse.removeAll { $0 == host }
+        loadTokensByHost.removeValue(forKey: host)
+    }
+
+    // MARK: - Private
+
+    // Posted on the main thread
+    @objc private func userDidSaveOrUnsaveArticle(_ notification: Notification) {
+        // An article without a URL could be on any site
+        invalidate(host: (notification.object as? WMFArticle)?.url?.host)
+    }
+
+    private func loadIfNeeded(host: String) {
+        guard loadTokensByHost[host] == nil else {
+            return
+        }
+        let token = UUID()
+        loadTokensByHost[host] = token
+
+        dataStore.performBackgroundCoreDataOperation { moc in
+            let request = WMFArticle.fetchRequest()
+            request.predicate = NSPredicate(format: "key BEGINSWITH %@ && (viewedDate != NULL || savedDate != NULL)", "https://\(host)/")
+            request.sortDescriptors = [NSSortDescriptor(keyPath: \WMFArticle.viewedDate, ascending: false)]
+            request.fetchLimit = Self.articleFetchLimit
+
+            let trie = WMFTitlePrefixTrie<MWKSearchResult>()
+            do {
+                let articles = try moc.fetch(request)
+                // Oldest first, so more recently viewed articles get a slightly higher weight and win ties within a source
+                for (index, article) in articles.reversed().enumerated() {
+                    guard let title = article.url?.wmf_title,
+                          let result = MWKSearchResult(articleID: 0, revID: 0, title: title, displayTitle: article.displayTitle, displayTitleHTML: article.displayTitleHTML, wikidataDescription: article.wikidataDescription, extract: nil, thumbnailURL: article.thumbnailURL, index: nil, titleNamespace: NSNumber(value: 0), location: nil) else {
+                        continue
+                    }
+                    let recency = Double(index + 1) / Double(articles.count + 1)
+                    let weight = (article.savedDate != nil ? Self.savedArticleWeight : Self.viewedArticleWeight) + recency
+                    trie.insert(result, forTitle: title, weight: weight)
+                }
+            } catch let error {
+                DDLogError("Error fetching articles for local search suggestions: \(error)")
+            }
+
+            DispatchQueue.main.async {
+                guard self.loadTokensByHost[host] == token else {
+                    return
+                }
+                self.loadTokensByHost.removeValue(forKey: host)
+                self.store(trie, for: host)
+            }
+        }
+    }
+
+    private func store(_ trie: WMFTitlePrefixTrie<MWKSearchResult>, for host: String) {
+        tries[host] = trie
+        hostsByRecentUse.removeAll { $0 == host }
+        hostsByRecentUse.append(host)
+
+        while hostsByRecentUse.count > maxHostCount {
+            tries.removeValue(forKey: hostsByRecentUse.removeFirst())
+        }
+    }
+}
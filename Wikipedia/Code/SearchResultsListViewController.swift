@@ -1,6 +1,7 @@
 import UIKit
 import WMF
 import WMFComponents
+import WMFData
 import WMFNativeLocalizations
 
 class SearchResultsListViewController: ArticleCollectionViewController {
@@ -11,6 +12,8 @@ class SearchResultsListViewController: ArticleCollectionViewController {
             reload()
         }
     }
+    /// Results found in the offline index, keyed by title. Their snippets are shown in place of a description.
+    var offlineResults: [String: WMFOfflineSearchIndex.Result] = [:]
     var tappedSearchResultAction: ((URL, IndexPath) -> Void)?
     var longPressSearchResultAndCommitAction: ((URL) -> Void)?
     var longPressOpenInNewTabAction: ((URL) -> Void)?
@@ -89,6 +92,16 @@ class SearchResultsListViewController: ArticleCollectionViewController {
         return String.localizedStringWithFormat("%@\n%@", redirectMessage, description)
     }
 
+    /// The snippet with the words that matched in bold
+    private func attributedSnippet(for offlineResult: WMFOfflineSearchIndex.Result) -> NSAttributedString {
+        let attributedSnippet = NSMutableAttributedString(string: offlineResult.snippet, attributes: [.font: WMFFont.for(.subheadline, compatibleWith: traitCollection)])
+        let boldFont = WMFFont.for(.boldSubheadline, compatibleWith: traitCollection)
+        for range in offlineResult.highlightedRanges where NSMaxRange(range) <= attributedSnippet.length {
+            attributedSnippet.addAttribute(.font, value: boldFont, range: range)
+        }
+        return attributedSnippet
+    }
+
     override func configure(cell: ArticleRightAlignedImageCollectionViewCell, forItemAt indexPath: IndexPath, layoutOnly: Bool) {
         configure(cell: cell, forItemAt: indexPath, layoutOnly: layoutOnly, configureForCompact: true)
     }
@@ -111,7 +124,11 @@ class SearchResultsListViewController: ArticleCollectionViewController {
         cell.setTitleHTML(result.displayTitleHTML, boldedString: resultsInfo?.searchTerm)
         cell.articleSemanticContentAttribute = MWKLanguageLinkController.semanticContentAttribute(forContentLanguageCode: contentLanguageCode)
         cell.titleLabel.accessibilityLanguage = languageCode
-        cell.descriptionLabel.text = descriptionForSearchResult(result)
+        if let title = result.title, let offlineResult = offlineResults[title] {
+            cell.descriptionLabel.attributedText = attributedSnippet(for: offlineResult)
+        } else {
+            cell.descriptionLabel.text = descriptionForSearchResult(result)
+        }
         cell.descriptionLabel.accessibilityLanguage = languageCode
         cell.updateAccessibilityElements()
         editController.configureSwipeableCell(cell, forItemAt: indexPath, layoutOnly: layoutOnly)
@@ -60,6 +60,7 @@ class SearchResultsViewController: ThemeableViewController, WMFNavigationBarConf
 
     private let source: EventLoggingSource
     private let dataStore: MWKDataStore
+    private let localSuggestionStore: SearchLocalSuggestionStore
 
     /// Parent view controllers that need their own `UISearchControllerDelegate` callbacks should set
     /// this property. `SearchResultsViewController` will handle all iPad 26 search-UI workarounds
@@ -87,6 +88,12 @@ class SearchResultsViewController: ThemeableViewController, WMFNavigationBarConf
     private var _siteURL: URL?
     private var searchTask: Task<Void, Never>?
 
+    /// When the current search term was typed, for measuring how long results take to appear
+    private var searchTermDate: Date?
+
+    /// Whether the results showing are local suggestions standing in until the network results arrive
+    private var isShowingLocalSuggestions = false
+
     var siteURL: URL? {
         get {
             _siteURL ?? searchLanguageBarViewController?.selectedSiteURL ?? MWKDataStore.shared().primarySiteURL ?? NSURL.wmf_URLWithDefaultSiteAndCurrentLocale()
@@ -98,9 +105,11 @@ class SearchResultsViewController: ThemeableViewController, WMFNavigationBarConf
 
     // MARK: - Init
 
-    init(source: EventLoggingSource, dataStore: MWKDataStore) {
+    /// - Parameter localSuggestionStore: Indexes of local titles to suggest while the network results load. Pass one in to share it between search screens; by default each screen builds its own.
+    init(source: EventLoggingSource, dataStore: MWKDataStore, localSuggestionStore: SearchLocalSuggestionStore? = nil) {
         self.source = source
         self.dataStore = dataStore
+        self.localSuggestionStore = localSuggestionStore ?? SearchLocalSuggestionStore(dataStore: dataStore)
         super.init(nibName: nil, bundle: nil)
     }
 
@@ -297,28 +306,52 @@ class SearchResultsViewController: ThemeableViewController, WMFNavigationBarConf
 
         guard (searchTerm as NSString).character(at: 0) != NSTextAttachment.character else { return }
 
-        resetSearchResults()
+        // Results already showing for an earlier term stay up until these arrive, rather than flashing empty
+        fetcher.cancelAllFetches()
         let start = Date()
 
         let failure = { (error: Error, type: WMFSearchType) in
             DispatchQueue.main.async { [weak self] in
                 guard let self,
                       searchTerm == self.searchTerm else { return }
-                self.resultsViewController.emptyViewType = (error as NSError).wmf_isNetworkConnectionError() ? .noInternetConnection : (error as NSError).wmf_isCancelledError() ? .none : .noSearchResults
-                self.resultsViewController.results = []
-                SearchFunnel.shared.logShowSearchError(with: type, elapsedTime: Date().timeIntervalSince(start), source: self.source.stringValue)
+                let showError = {
+                    self.resultsViewController.emptyViewType = (error as NSError).wmf_isNetworkConnectionError() ? .noInternetConnection : (error as NSError).wmf_isCancelledError() ? .none : .noSearchResults
+                    self.resultsViewController.results = []
+                    SearchFunnel.shared.logShowSearchError(with: type, elapsedTime: Date().timeIntervalSince(start), source: self.source.stringValue)
+                }
+                guard (error as NSError).wmf_isNetworkConnectionError() else {
+                    showError()
+                    return
+                }
+                // Without a connection, fall back to searching the text of articles saved for offline reading
+                self.searchOfflineArticles(for: searchTerm, siteURL: siteURL) { [weak self] offlineResults in
+                    guard let self,
+                          searchTerm == self.searchTerm else { return }
+                    guard !offlineResults.isEmpty else {
+                        showError()
+                        return
+                    }
+                    self.showOfflineResults(offlineResults, siteURL: siteURL)
+                }
             }
         }
 
         let success = { (results: WMFSearchResults, type: WMFSearchType) in
             DispatchQueue.main.async { [weak self] in
-                guard let self else { return }
+                guard let self,
+                      searchTerm == self.searchTerm else { return }
                 NSUserActivity.wmf_makeActive(NSUserActivity.wmf_searchResultsActivitySearchSiteURL(siteURL, searchTerm: searchTerm))
                 let resultsArray = results.results ?? []
                 self.resultsViewController.emptyViewType = resultsArray.isEmpty ? .noSearchResults : .none
                 self.resultsViewController.resultsInfo = results
                 self.resultsViewController.searchSiteURL = siteURL
+                self.resultsViewController.offlineResults = [:]
                 self.resultsViewController.results = resultsArray
+                self.isShowingLocalSuggestions = false
+                self.localSuggestionStore.addRecentResults(resultsArray, siteURL: siteURL)
+                if let searchTermDate = self.searchTermDate {
+                    DDLogDebug("Search results for a keystroke took \(Int(Date().timeIntervalSince(searchTermDate) * 1000))ms, \(Int(Date().timeIntervalSince(start) * 1000))ms of it fetching")
+                }
                 guard !suggested else { return }
                 SearchFunnel.shared.logSearchResults(with: type, resultCount: resultsArray.count, elapsedTime: Date().timeIntervalSince(start), source: self.source.stringValue)
             }
@@ -353,10 +386,73 @@ class SearchResultsViewController: ThemeableViewController, WMFNavigationBarConf
 
     func resetSearchResults() {
         fetcher.cancelAllFetches()
+        isShowingLocalSuggestions = false
         resultsViewController.emptyViewType = .none
+        resultsViewController.offlineResults = [:]
         resultsViewController.results = []
     }
 
+    // MARK: - Local Suggestions
+
+    /// Shows titles from the local index matching `searchTerm` until the network results arrive. Results already showing are left alone, as they are usually a better match than a few local titles.
+    private func showLocalSuggestions(for searchTerm: String) {
+        guard let siteURL else {
+            return
+        }
+        let trie = localSuggestionStore.suggestionTrie(for: siteURL)
+
+        guard resultsViewController.results.isEmpty || isShowingLocalSuggestions,
+              let trie else {
+            return
+        }
+
+        let suggestions = trie.matches(forPrefix: searchTerm)
+        guard !suggestions.isEmpty || isShowingLocalSuggestions else {
+            return
+        }
+
+        isShowingLocalSuggestions = !suggestions.isEmpty
+        resultsViewController.emptyViewType = .none
+        resultsViewController.resultsInfo = suggestions.isEmpty ? nil : WMFSearchResults(searchTerm: searchTerm, results: nil, searchSuggestion: nil, redirectMappings: [])
+        resultsViewController.searchSiteURL = siteURL
+        resultsViewController.offlineResults = [:]
+        resultsViewController.results = suggestions
+    }
+
+    // MARK: - Offline Search
+
+    private func searchOfflineArticles(for searchTerm: String, siteURL: URL, completion: @escaping ([WMFOfflineSearchIndex.Result]) -> Void) {
+        guard let offlineSearchIndex = dataStore.cacheController.articleCache.offlineSearchIndex else {
+            completion([])
+            return
+        }
+
+        let languageCode = siteURL.wmf_languageCode
+        DispatchQueue.global(qos: .userInitiated).async {
+            var results: [WMFOfflineSearchIndex.Result] = []
+            do {
+                results = try offlineSearchIndex.search(searchTerm, languageCode: languageCode, limit: Int(WMFMaxSearchResultLimit))
+            } catch let error {
+                DDLogError("Error searching offline articles: \(error)")
+            }
+            DispatchQueue.main.async {
+                completion(results)
+            }
+        }
+    }
+
+    private func showOfflineResults(_ offlineResults: [WMFOfflineSearchIndex.Result], siteURL: URL) {
+        let searchResults = offlineResults.enumerated().compactMap { (index, offlineResult) in
+            MWKSearchResult(articleID: 0, revID: 0, title: offlineResult.title, displayTitle: offlineResult.title, displayTitleHTML: offlineResult.title, wikidataDescription: nil, extract: offlineResult.snippet, thumbnailURL: nil, index: NSNumber(value: index), titleNamespace: NSNumber(value: 0), location: nil)
+        }
+
+        resultsViewController.emptyViewType = .none
+        resultsViewController.resultsInfo = nil
+        resultsViewController.searchSiteURL = siteURL
+        resultsViewController.offlineResults = Dictionary(offlineResults.map { ($0.title, $0) }, uniquingKeysWith: { first, _ in first })
+        resultsViewController.results = searchResults
+    }
+
     func didCancelSearch() {
         resetSearchResults()
     }
@@ -517,6 +613,11 @@ extension SearchResultsViewController: UISearchResultsUpdating {
                 return
             }
             searchTerm = text
+            searchTermDate = Date()
+
+            // Drop the request for the previous keystroke now rather than when the debounce fires, so it can't land in between
+            fetcher.cancelAllFetches()
+            showLocalSuggestions(for: text)
 
             searchTask?.cancel()
             searchTask = Task { @MainActor [weak self] in
@@ -176,6 +176,11 @@ public class Session: NSObject {
     public var defaultURLSession: URLSession
     private let sessionDelegate: SessionDelegate
     @objc weak var authenticationDelegate: SessionAuthenticationDelegate?
+    
+    /// The serial queue this session's responses are delivered on. Results served without a request, like cache hits, can be delivered here so callers see the same threading either way.
+    @objc public var delegateQueue: OperationQueue {
+        return sessionDelegate.delegateQueue
+    }
     private let httpClientProvider: SessionHTTPClientProvider
     private var httpClient: SessionHTTPClient
     
@@ -663,6 +668,11 @@ extension Session {
         return cachedResponseForURLRequest(request)
     }
     
+    // assumes urlRequest is already populated with the proper cache headers
+    public func persistedResponseForURLRequest(_ urlRequest: URLRequest) -> CachedURLResponse? {
+        return permanentCache?.urlCache.persistedResponse(for: urlRequest)
+    }
+    
     // assumes urlRequest is already populated with the proper cache headers
     func cachedResponseForURLRequest(_ urlRequest: URLRequest) -> CachedURLResponse? {
         return permanentCache?.urlCache.cachedResponse(for: urlRequest)
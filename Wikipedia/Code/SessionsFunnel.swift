@@ -1,4 +1,5 @@
 import WMFData
+import CocoaLumberjackSwift
 
 @objc final class SessionsFunnel: NSObject {
     @objc public static let shared = SessionsFunnel()
@@ -9,6 +10,9 @@ import WMFData
     private var pageLoadMax: Double?
     private var pageLoadTimes: [Double] = []
     private var pageLoadAverage: Double?
+    
+    // Loads served straight from the permanent cache (i.e. Saved Articles) are tracked apart from network loads, so they do not skew page_load_latency_ms.
+    private var cachedPageLoadTimes: [Double] = []
 
     public struct Event: EventInterface {
         public static let schema: EventPlatformClient.Schema = .sessions
@@ -112,25 +116,33 @@ import WMFData
         pageLoadStartTime = nil
     }
     
-    func endPageLoadStartTime() {
+    func endPageLoadStartTime(servedFromCache: Bool = false) {
         assert(Thread.isMainThread)
         
         guard let pageLoadStartTime else {
             return
         }
         
+        self.pageLoadStartTime = nil
+        
         let milliseconds = (CACurrentMediaTime() - pageLoadStartTime) * 1000
         
         guard milliseconds > 0 else {
             return
         }
         
-        pageLoadTimes.append(milliseconds)
+        if servedFromCache {
+            cachedPageLoadTimes.append(milliseconds)
+        } else {
+            pageLoadTimes.append(milliseconds)
+        }
     }
     
     private func calculatePageLoadMetrics() {
         assert(Thread.isMainThread)
         
+        DDLogDebug("Page load averages - network: \(pageLoadAverageDescription(pageLoadTimes)), cache: \(pageLoadAverageDescription(cachedPageLoadTimes))")
+        
         guard !pageLoadTimes.isEmpty else {
             return
         }
@@ -150,6 +162,15 @@ import WMFData
         pageLoadMax = nil
         pageLoadTimes.removeAll()
         pageLoadAverage = nil
+        cachedPageLoadTimes.removeAll()
+    }
+    
+    private func pageLoadAverageDescription(_ times: [Double]) -> String {
+        guard !times.isEmpty else {
+            return "n/a"
+        }
+        
+        return "\(Int(round(times.reduce(0, +) / Double(times.count))))ms over \(times.count) loads"
     }
     
 }
@@ -224,6 +224,7 @@ final class SettingsCoordinator: Coordinator, SettingsCoordinatorDelegate {
             in: SharedContainerCacheCommonNames.didYouKnowCache,
             cleanupLevel: .high
         )
+        DiffFetcher.clearDiffCache()
 
         Task {
             try await Task.sleep(nanoseconds: 1_000_000_000)
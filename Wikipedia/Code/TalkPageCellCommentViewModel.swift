@@ -30,12 +30,16 @@ final class TalkPageCellCommentViewModel: Identifiable {
     }
     
     func commentAttributedString(traitCollection: UITraitCollection, theme: Theme) -> NSAttributedString {
+        return HtmlRenderCache.shared.attributedString(for: commentRenderRequest(traitCollection: traitCollection, theme: theme))
+    }
+
+    /// Used both to render the comment and to prerender it before its cell is shown
+    func commentRenderRequest(traitCollection: UITraitCollection, theme: Theme) -> HtmlRenderCache.Request {
         let styles = HtmlUtils.Styles(font: WMFFont.for(.callout, compatibleWith: traitCollection), boldFont: WMFFont.for(.boldCallout, compatibleWith: traitCollection), italicsFont: WMFFont.for(.italicCallout, compatibleWith: traitCollection), boldItalicsFont: WMFFont.for(.boldItalicCallout, compatibleWith: traitCollection), color: theme.colors.primaryText, linkColor: theme.colors.link, lineSpacing: 1)
 
-        return NSMutableAttributedString.mutableAttributedStringFromHtml(html, styles: styles).removingInitialNewlineCharacters()
+        return HtmlRenderCache.Request(html: html, styles: styles, removesInitialNewlines: true)
     }
 
-
 }
 
 extension TalkPageCellCommentViewModel: Hashable {
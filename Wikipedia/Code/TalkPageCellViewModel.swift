@@ -69,25 +69,53 @@ final class TalkPageCellViewModel: Identifiable {
     }
     
     func leadCommentAttributedString(traitCollection: UITraitCollection, theme: Theme) -> NSAttributedString? {
-        if let leadComment = leadComment {
-            let commentColor = isThreadExpanded ? theme.colors.primaryText : theme.colors.secondaryText
-            let styles = HtmlUtils.Styles(font: WMFFont.for(.callout, compatibleWith: traitCollection), boldFont: WMFFont.for(.boldCallout, compatibleWith: traitCollection), italicsFont: WMFFont.for(.italicCallout, compatibleWith: traitCollection), boldItalicsFont: WMFFont.for(.boldItalicCallout, compatibleWith: traitCollection), color: commentColor, linkColor: theme.colors.link, lineSpacing: 1)
-            let leadCommentFormatted = NSMutableAttributedString.mutableAttributedStringFromHtml(leadComment.html, styles: styles).removingInitialNewlineCharacters()
-
-            return leadCommentFormatted
+        guard let request = leadCommentRenderRequest(traitCollection: traitCollection, theme: theme) else {
+            return nil
         }
         
-        return nil
+        return HtmlRenderCache.shared.attributedString(for: request)
     }
     
     func otherContentAttributedString(traitCollection: UITraitCollection, theme: Theme) -> NSAttributedString? {
-        if let otherContentHtml = otherContentHtml {
-            let styles = HtmlUtils.Styles(font: WMFFont.for(.callout, compatibleWith: traitCollection), boldFont: WMFFont.for(.boldCallout, compatibleWith: traitCollection), italicsFont: WMFFont.for(.italicCallout, compatibleWith: traitCollection), boldItalicsFont: WMFFont.for(.boldItalicCallout, compatibleWith: traitCollection), color: theme.colors.primaryText, linkColor: theme.colors.link, lineSpacing: 1)
-            return NSMutableAttributedString.mutableAttributedStringFromHtml(otherContentHtml, styles: styles).removingInitialNewlineCharacters()
-
+        guard let request = otherContentRenderRequest(traitCollection: traitCollection, theme: theme) else {
+            return nil
         }
         
-        return nil
+        return HtmlRenderCache.shared.attributedString(for: request)
+    }
+    
+    /// Everything this cell will render given its current expanded state, for prerendering before it is shown
+    func renderRequests(traitCollection: UITraitCollection, theme: Theme) -> [HtmlRenderCache.Request] {
+        var requests: [HtmlRenderCache.Request] = []
+        if let leadCommentRequest = leadCommentRenderRequest(traitCollection: traitCollection, theme: theme) {
+            requests.append(leadCommentRequest)
+        }
+        if let otherContentRequest = otherContentRenderRequest(traitCollection: traitCollection, theme: theme) {
+            requests.append(otherContentRequest)
+        }
+        if isThreadExpanded {
+            requests.append(contentsOf: replies.map { $0.commentRenderRequest(traitCollection: traitCollection, theme: theme) })
+        }
+        return requests
+    }
+    
+    private func leadCommentRenderRequest(traitCollection: UITraitCollection, theme: Theme) -> HtmlRenderCache.Request? {
+        guard let leadComment = leadComment else {
+            return nil
+        }
+        
+        let commentColor = isThreadExpanded ? theme.colors.primaryText : theme.colors.secondaryText
+        let styles = HtmlUtils.Styles(font: WMFFont.for(.callout, compatibleWith: traitCollection), boldFont: WMFFont.for(.boldCallout, compatibleWith: traitCollection), italicsFont: WMFFont.for(.italicCallout, compatibleWith: traitCollection), boldItalicsFont: WMFFont.for(.boldItalicCallout, compatibleWith: traitCollection), color: commentColor, linkColor: theme.colors.link, lineSpacing: 1)
+        return HtmlRenderCache.Request(html: leadComment.html, styles: styles, removesInitialNewlines: true)
+    }
+    
+    private func otherContentRenderRequest(traitCollection: UITraitCollection, theme: Theme) -> HtmlRenderCache.Request? {
+        guard let otherContentHtml = otherContentHtml else {
+            return nil
+        }
+        
+        let styles = HtmlUtils.Styles(font: WMFFont.for(.callout, compatibleWith: traitCollection), boldFont: WMFFont.for(.boldCallout, compatibleWith: traitCollection), italicsFont: WMFFont.for(.italicCallout, compatibleWith: traitCollection), boldItalicsFont: WMFFont.for(.boldItalicCallout, compatibleWith: traitCollection), color: theme.colors.primaryText, linkColor: theme.colors.link, lineSpacing: 1)
+        return HtmlRenderCache.Request(html: otherContentHtml, styles: styles, removesInitialNewlines: true)
     }
 }
 
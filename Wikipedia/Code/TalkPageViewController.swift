@@ -210,6 +210,7 @@ class TalkPageViewController: ThemeableViewController, WMFNavigationBarConfiguri
 
         talkPageView.collectionView.dataSource = self
         talkPageView.collectionView.delegate = self
+        talkPageView.collectionView.prefetchDataSource = self
 
         talkPageView.emptyView.scrollView.delegate = self
 
@@ -1018,6 +1019,23 @@ extension TalkPageViewController: UICollectionViewDelegate, UICollectionViewData
     }
 }
 
+// MARK: - UICollectionViewDataSourcePrefetching
+
+extension TalkPageViewController: UICollectionViewDataSourcePrefetching {
+
+    func collectionView(_ collectionView: UICollectionView, prefetchItemsAt indexPaths: [IndexPath]) {
+        let topics = viewModel.topics
+        let requests = indexPaths
+            .filter { $0.item < topics.count }
+            .flatMap { topics[$0.item].renderRequests(traitCollection: collectionView.traitCollection, theme: theme) }
+        HtmlRenderCache.shared.prerender(requests)
+    }
+
+    func collectionView(_ collectionView: UICollectionView, cancelPrefetchingForItemsAt indexPaths: [IndexPath]) {
+        HtmlRenderCache.shared.cancelPrerendering()
+    }
+}
+
 // MARK: - TalkPageCellDelegate
 
 extension TalkPageViewController: TalkPageCellDelegate {
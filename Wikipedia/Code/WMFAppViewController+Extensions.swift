@@ -881,7 +881,9 @@ extension WMFAppViewController {
         let coreDataStore = WMFDataEnvironment.current.coreDataStore
         Task {
             do {
-                try await coreDataStore?.performDatabaseHousekeeping()
+                if let report = try await coreDataStore?.performDatabaseHousekeeping() {
+                    DDLogInfo("Pruned WMFData database: \(report)")
+                }
             } catch {
                 DDLogError("Error pruning WMFData database: \(error)")
             }
@@ -61,12 +61,12 @@ extension WMFContentGroup {
             // todo: pass in article source Explore > Nearby List
             vc = ArticleLocationCollectionViewController(articleURLs: articleURLs, dataStore: dataStore, contentGroup: self, theme: theme, needsCloseButton: true, articleSource: .undefined)
         case .news:
-            guard let stories = fullContent?.object as? [WMFFeedNewsStory] else {
+            guard let stories = fullContent.map({ Array($0.contentElements(of: WMFFeedNewsStory.self)) }) else {
                 break
             }
             vc = NewsViewController(stories: stories, dataStore: dataStore, contentGroup: self, theme: theme)
         case .onThisDay:
-            guard let date = midnightUTCDate, let events = fullContent?.object as? [WMFFeedOnThisDayEvent] else {
+            guard let date = midnightUTCDate, let events = fullContent.map({ Array($0.contentElements(of: WMFFeedOnThisDayEvent.self)) }) else {
                 break
             }
             vc = OnThisDayViewController(events: events, dataStore: dataStore, midnightUTCDate: date, contentGroup: self, theme: theme)
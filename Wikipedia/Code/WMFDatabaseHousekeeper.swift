@@ -79,12 +79,12 @@ import WMF
                 continue
             }
 
-            guard let content = fullContent.object as? [Any] else {
+            guard fullContent.contentObject is NSArray else {
                 assertionFailure("Unknown Content Type")
                 continue
             }
             
-            for obj in content {
+            for obj in fullContent.contentElements(of: AnyObject.self) {
                 
                 switch (group.contentType, obj) {
                     
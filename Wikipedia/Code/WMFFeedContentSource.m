@@ -100,10 +100,11 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
         NSNumber *value = @(feedDay.maxAge);
         [moc wmf_setValue:value forKey:key];
 
+        [self saveArticlesForFeedDay:feedDay pageViews:pageViews date:date inManagedObjectContext:moc];
         [self saveGroupForFeaturedPreview:feedDay.featuredArticle date:date inManagedObjectContext:moc];
-        [self saveGroupForTopRead:feedDay.topRead pageViews:pageViews date:date inManagedObjectContext:moc];
+        [self saveGroupForTopRead:feedDay.topRead date:date inManagedObjectContext:moc];
         [self saveGroupForPictureOfTheDay:feedDay.pictureOfTheDay date:date inManagedObjectContext:moc];
-        [self saveGroupForNews:feedDay.newsStories pageViews:pageViews date:date inManagedObjectContext:moc];
+        [self saveGroupForNews:feedDay.newsStories date:date inManagedObjectContext:moc];
 
         if (!completion) {
             return;
@@ -112,6 +113,28 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
     }];
 }
 
+// Upserts the articles for every section of the feed day with one fetch, rather than one fetch per article
+- (void)saveArticlesForFeedDay:(WMFFeedDayResponse *)feedDay pageViews:(NSDictionary<NSURL *, NSDictionary<NSDate *, NSNumber *> *> *)pageViews date:(NSDate *)date inManagedObjectContext:(NSManagedObjectContext *)moc {
+    if (!date) {
+        return;
+    }
+
+    NSMutableArray<WMFFeedArticlePreview *> *previews = [NSMutableArray array];
+    if (feedDay.featuredArticle) {
+        [previews addObject:feedDay.featuredArticle];
+    }
+    if (feedDay.topRead.articlePreviews) {
+        [previews addObjectsFromArray:feedDay.topRead.articlePreviews];
+    }
+    for (WMFFeedNewsStory *story in feedDay.newsStories) {
+        if (story.articlePreviews) {
+            [previews addObjectsFromArray:story.articlePreviews];
+        }
+    }
+
+    [moc fetchOrCreateArticlesWithFeedPreviews:previews pageViews:pageViews featuredPreview:feedDay.featuredArticle];
+}
+
 - (void)saveGroupForFeaturedPreview:(WMFFeedArticlePreview *)preview date:(NSDate *)date inManagedObjectContext:(NSManagedObjectContext *)moc {
     if (!preview || !date) {
         return;
@@ -124,8 +147,6 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
         return;
     }
 
-    [moc fetchOrCreateArticleWithURL:featuredURL updatedWithFeedPreview:preview pageViews:nil isFeatured:YES];
-
     if (featured == nil) {
         [moc createGroupOfKind:WMFContentGroupKindFeaturedArticle forDate:date withSiteURL:self.siteURL associatedContent:@[featuredURL]];
     } else if (featured.contentPreview == nil) {
@@ -133,17 +154,12 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
     }
 }
 
-- (void)saveGroupForTopRead:(WMFFeedTopReadResponse *)topRead pageViews:(NSDictionary<NSURL *, NSDictionary<NSDate *, NSNumber *> *> *)pageViews date:(NSDate *)date inManagedObjectContext:(NSManagedObjectContext *)moc {
+- (void)saveGroupForTopRead:(WMFFeedTopReadResponse *)topRead date:(NSDate *)date inManagedObjectContext:(NSManagedObjectContext *)moc {
     // Sometimes top read is nil, depends on time of day
     if ([topRead.articlePreviews count] == 0 || date == nil) {
         return;
     }
 
-    [topRead.articlePreviews enumerateObjectsUsingBlock:^(WMFFeedTopReadArticlePreview *_Nonnull obj, NSUInteger idx, BOOL *_Nonnull stop) {
-        NSURL *url = [obj articleURL];
-        [moc fetchOrCreateArticleWithURL:url updatedWithFeedPreview:obj pageViews:pageViews[url] isFeatured:NO];
-    }];
-
     WMFContentGroup *group = [self topReadForDate:date inManagedObjectContext:moc];
 
     if (group == nil) {
@@ -207,7 +223,7 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
     }
 }
 
-- (void)saveGroupForNews:(NSArray<WMFFeedNewsStory *> *)news pageViews:(NSDictionary<NSURL *, NSDictionary<NSDate *, NSNumber *> *> *)pageViews date:(NSDate *)feedDate inManagedObjectContext:(NSManagedObjectContext *)moc {
+- (void)saveGroupForNews:(NSArray<WMFFeedNewsStory *> *)news date:(NSDate *)feedDate inManagedObjectContext:(NSManagedObjectContext *)moc {
 
     // Search for a previously added news group with this date.
     // Invisible news groups are created when an older news story is loaded.
@@ -255,12 +271,6 @@ NSInteger const WMFFeedInTheNewsNotificationViewCountDays = 5;
     }
 
     [news enumerateObjectsUsingBlock:^(WMFFeedNewsStory *_Nonnull story, NSUInteger idx, BOOL *_Nonnull stop) {
-        [story.articlePreviews enumerateObjectsUsingBlock:^(WMFFeedArticlePreview *_Nonnull obj, NSUInteger idx, BOOL *_Nonnull stop) {
-            NSURL *url = [obj articleURL];
-            NSDictionary<NSDate *, NSNumber *> *pageViewsForURL = pageViews[url];
-            [moc fetchOrCreateArticleWithURL:url updatedWithFeedPreview:obj pageViews:pageViewsForURL isFeatured:NO];
-        }];
-
         NSString *featuredArticleTitleBasedOnSemanticLookup = [WMFFeedNewsStory semanticFeaturedArticleTitleFromStoryHTML:story.storyHTML siteURL:self.siteURL];
         for (WMFFeedArticlePreview *preview in story.articlePreviews) {
             if (preview.thumbnailURL == nil) {
@@ -100,7 +100,7 @@ static const CLLocationDistance WMFNearbyUpdateDistanceThresholdInMeters = 25000
                 inManagedObjectContext:moc
                 force:force
                 completion:^(WMFContentGroup *group, CLLocation *location, CLPlacemark *placemark) {
-                    id content = group.fullContent.object;
+                    id content = group.fullContent.contentObject;
                     if (group && [content isKindOfClass:[NSArray class]] && [content count] > 0) {
                         NSDate *now = [NSDate date];
                         NSDate *todayMidnightUTC = [now wmf_midnightUTCDateFromLocalDate];
@@ -207,7 +207,7 @@ static const CLLocationDistance WMFNearbyUpdateDistanceThresholdInMeters = 25000
         inManagedObjectContext:moc
         force:NO
         completion:^(WMFContentGroup *group, CLLocation *location, CLPlacemark *placemark) {
-            id content = group.fullContent.object;
+            id content = group.fullContent.contentObject;
             if (group && [content isKindOfClass:[NSArray class]] && [content count] > 0) {
                 if (self.completion) {
                     self.completion();
@@ -85,13 +85,15 @@ NS_ASSUME_NONNULL_BEGIN
                     }
 
                     [moc performBlock:^{
+                        NSMutableArray<WMFFeedArticlePreview *> *articlePreviews = [NSMutableArray array];
                         [onThisDayEvents enumerateObjectsUsingBlock:^(WMFFeedOnThisDayEvent *_Nonnull event, NSUInteger idx, BOOL *_Nonnull stop) {
-                            [event.articlePreviews enumerateObjectsUsingBlock:^(WMFFeedArticlePreview *_Nonnull articlePreview, NSUInteger idx, BOOL *_Nonnull stop) {
-                                [moc fetchOrCreateArticleWithURL:[articlePreview articleURL] updatedWithFeedPreview:articlePreview pageViews:nil isFeatured:NO];
-                            }];
+                            if (event.articlePreviews) {
+                                [articlePreviews addObjectsFromArray:event.articlePreviews];
+                            }
                             event.score = [event calculateScore];
                             event.index = @(idx);
                         }];
+                        [moc fetchOrCreateArticlesWithFeedPreviews:articlePreviews pageViews:nil featuredPreview:nil];
 
                         NSInteger featuredEventIndex = NSNotFound;
 
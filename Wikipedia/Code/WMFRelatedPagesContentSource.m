@@ -265,7 +265,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)fetchAndSaveRelatedArticlesForArticle:(WMFArticle *)article excludedArticleKeys:(NSSet *)excludedArticleKeys date:(NSDate *)date inManagedObjectContext:(NSManagedObjectContext *)moc completion:(nullable dispatch_block_t)completion {
     NSURL *groupURL = [WMFContentGroup relatedPagesContentGroupURLForArticleURL:article.URL];
     WMFContentGroup *existingGroup = [moc contentGroupForURL:groupURL];
-    NSArray<NSURL *> *related = (NSArray<NSURL *> *)existingGroup.fullContent.object;
+    NSArray<NSURL *> *related = (NSArray<NSURL *> *)existingGroup.fullContent.contentObject;
     if ([related count] > 0) {
         if (completion) {
             completion();
@@ -0,0 +1,168 @@
+import Foundation
+import CoreLocation
+import WMF
+
+/// A search API response, decoded straight from the response data rather than parsed into dictionaries and then mapped onto `WMFSearchResults` key by key with Mantle
+struct MediaWikiSearchResponse: Decodable {
+
+    struct APIError: Decodable {
+        let code: String
+    }
+
+    struct Query: Decodable {
+        struct SearchInfo: Decodable {
+            let suggestion: String?
+        }
+
+        struct Redirect: Decodable {
+            let from: String
+            let to: String
+        }
+
+        let pages: Pages?
+        let redirects: [Redirect]?
+        let searchinfo: SearchInfo?
+    }
+
+    /// Pages come keyed by page ID. They're decoded in place into an array rather than into a dictionary, then put in the order the search returned them.
+    struct Pages: Decodable {
+        let results: [MWKSearchResult]
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: PageKey.self)
+            var pages: [Page] = []
+            pages.reserveCapacity(container.allKeys.count)
+            for key in container.allKeys {
+                pages.append(try container.decode(Page.self, forKey: key))
+            }
+            // Pages without an index sort first, as they do with Mantle's sort descriptor
+            pages.sort { ($0.index ?? Int.min) < ($1.index ?? Int.min) }
+            results = pages.compactMap { $0.searchResult }
+        }
+    }
+
+    private struct PageKey: CodingKey {
+        let stringValue: String
+        let intValue: Int?
+
+        init?(stringValue: String) {
+            self.stringValue = stringValue
+            self.intValue = nil
+        }
+
+        init?(intValue: Int) {
+            self.stringValue = String(intValue)
+            self.intValue = intValue
+        }
+    }
+
+    struct Page: Decodable {
+        struct Thumbnail: Decodable {
+            let source: String?
+        }
+
+        struct PageProps: Decodable {
+            let displaytitle: String?
+        }
+
+        struct Revision: Decodable {
+            let revid: Int?
+        }
+
+        struct Coordinates: Decodable {
+            let lat: Double?
+            let lon: Double?
+            let type: String?
+            let dim: Dimension?
+        }
+
+        /// Dimensions are strings like "10km". Anything else is kept rather than failing the whole response, then ignored.
+        enum Dimension: Decodable {
+            case string(String)
+            case number(Double)
+
+            init(from decoder: Decoder) throws {
+                let container = try decoder.singleValueContainer()
+                if let number = try? container.decode(Double.self) {
+                    self = .number(number)
+                } else {
+                    self = .string(try container.decode(String.self))
+                }
+            }
+
+            var string: String? {
+                guard case .string(let string) = self else {
+                    return nil
+                }
+                return string
+            }
+        }
+
+        let pageid: Int?
+        let ns: Int?
+        let title: String?
+        let index: Int?
+        let description: String?
+        let extract: String?
+        let thumbnail: Thumbnail?
+        let pageprops: PageProps?
+        let revisions: [Revision]?
+        let coordinates: [Coordinates]?
+
+        var searchResult: MWKSearchResult? {
+            let displayTitleHTML = pageprops?.displaytitle ?? title ?? ""
+            var location: CLLocation?
+            if let lat = coordinates?.first?.lat, let lon = coordinates?.first?.lon {
+                location = CLLocation(latitude: lat, longitude: lon)
+            }
+
+            let result = MWKSearchResult(
+                articleID: pageid ?? 0,
+                revID: revisions?.first?.revid ?? 0,
+                title: title,
+                displayTitle: displayTitleHTML.wmf_stringByRemovingHTML(),
+                displayTitleHTML: displayTitleHTML,
+                wikidataDescription: description,
+                extract: MWKSearchResult.summary(fromExtract: extract),
+                thumbnailURL: thumbnail?.source.flatMap { URL(string: $0) },
+                index: index.map { NSNumber(value: $0) },
+                titleNamespace: ns.map { NSNumber(value: $0) },
+                location: location
+            )
+            result?.geoType = MWKSearchResult.geoType(fromCoordinatesType: coordinates?.first?.type)
+            result?.geoDimension = MWKSearchResult.geoDimension(fromCoordinatesDimension: coordinates?.first?.dim?.string)
+            return result
+        }
+
+    }
+
+    let error: APIError?
+    let query: Query?
+
+    func searchResults(searchTerm: String, languageVariantCode: String?) -> WMFSearchResults {
+        let redirectMappings = (query?.redirects ?? []).map { MWKSearchRedirectMapping(fromTitle: $0.from, toTitle: $0.to) }
+        let searchResults = WMFSearchResults(searchTerm: searchTerm, results: query?.pages?.results ?? [], searchSuggestion: query?.searchinfo?.suggestion, redirectMappings: redirectMappings)
+        searchResults.propagateLanguageVariantCode(languageVariantCode)
+        return searchResults
+    }
+}
+
+extension WMFSearchFetcher {
+
+    /// Fetches one page of search results, decoding them directly from the response data
+    @objc(fetchDecodedSearchResultsForSearchTerm:url:queryParameters:completion:)
+    func fetchDecodedSearchResults(for searchTerm: String, url: URL, queryParameters: [String: Any], completion: @escaping (WMFSearchResults?, Error?) -> Void) {
+        fetcher.performDecodableMediaWikiAPIGET(for: url, with: queryParameters) { (result: Result<MediaWikiSearchResponse, Error>) in
+            switch result {
+            case .success(let response):
+                if let code = response.error?.code {
+                    completion(nil, RequestError.api(code))
+                    return
+                }
+                completion(response.searchResults(searchTerm: searchTerm, languageVariantCode: url.wmf_languageVariantCode), nil)
+            case .failure(let error):
+                completion(nil, error)
+            }
+        }
+    }
+}
@@ -9,6 +9,9 @@ extern NSUInteger const WMFMaxSearchResultLimit;
 
 @interface WMFSearchFetcher : WMFLegacyFetcher
 
+/// Forgets every cached result, so the next search for any term makes a request.
+- (void)removeAllCachedResults;
+
 - (void)fetchArticlesForSearchTerm:(NSString *)searchTerm
                            siteURL:(NSURL *)siteURL
                        resultLimit:(NSUInteger)resultLimit
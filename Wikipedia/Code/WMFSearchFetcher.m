@@ -1,5 +1,6 @@
 #import "WMFSearchFetcher_Testing.h"
 #import "WMFSearchResults_Internal.h"
+#import "Wikipedia-Swift.h"
 @import WMF;
 @import WMFData;
 
@@ -7,10 +8,73 @@ NS_ASSUME_NONNULL_BEGIN
 
 NSUInteger const WMFMaxSearchResultLimit = 24;
 
+// Cached results younger than this are returned without a request. Older ones are still returned, then refreshed in the background for the next time the term is searched.
+static const NSTimeInterval WMFSearchResultsCacheFreshInterval = 10 * 60;
+static const NSUInteger WMFSearchResultsCacheCountLimit = 200;
+
+#pragma mark - Results Cache
+
+@interface WMFSearchResultsCacheEntry : NSObject
+
+@property (nonatomic, strong, readonly) WMFSearchResults *results;
+@property (nonatomic, strong, readonly) NSDate *date;
+
+@end
+
+@implementation WMFSearchResultsCacheEntry
+
+- (instancetype)initWithResults:(WMFSearchResults *)results {
+    self = [super init];
+    if (self) {
+        _results = results;
+        _date = [NSDate date];
+    }
+    return self;
+}
+
+@end
+
 #pragma mark - Fetcher Implementation
 
+@interface WMFSearchFetcher ()
+
+// Each search screen owns its fetcher, so results are cached for as long as that screen is around
+@property (nonatomic, strong, readonly) NSCache<NSString *, WMFSearchResultsCacheEntry *> *resultsCache;
+
+@end
+
 @implementation WMFSearchFetcher
 
+- (instancetype)initWithSession:(WMFSession *)session configuration:(WMFConfiguration *)configuration {
+    self = [super initWithSession:session configuration:configuration];
+    if (self) {
+        _resultsCache = [[NSCache alloc] init];
+        _resultsCache.countLimit = WMFSearchResultsCacheCountLimit;
+    }
+    return self;
+}
+
+- (void)removeAllCachedResults {
+    [self.resultsCache removeAllObjects];
+}
+
+/// Search is insensitive to case and to extra whitespace, so terms differing only in those share a cache entry
++ (NSString *)normalizedSearchTerm:(NSString *)searchTerm {
+    NSArray<NSString *> *words = [[searchTerm componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] wmf_reject:^BOOL(NSString *word) {
+        return word.length == 0;
+    }];
+    return [[words componentsJoinedByString:@" "] lowercaseString];
+}
+
++ (NSString *)cacheKeyForSearchTerm:(NSString *)searchTerm siteURL:(NSURL *)siteURL namespace:(NSNumber *)namespace resultLimit:(NSUInteger)resultLimit fullTextSearch:(BOOL)fullTextSearch {
+    return [NSString stringWithFormat:@"%@|%@|%@|%lu|%d|%@", siteURL.host ?: @"", siteURL.wmf_languageVariantCode ?: @"", namespace, (unsigned long)resultLimit, fullTextSearch, [self normalizedSearchTerm:searchTerm]];
+}
+
+/// Copies cached results so merging later results into them can't change the cache, and labels them with the term as typed
++ (WMFSearchResults *)resultsFromCachedResults:(WMFSearchResults *)cachedResults searchTerm:(NSString *)searchTerm {
+    return [[WMFSearchResults alloc] initWithSearchTerm:searchTerm results:cachedResults.results searchSuggestion:cachedResults.searchSuggestion redirectMappings:cachedResults.redirectMappings ?: @[]];
+}
+
 - (void)fetchArticlesForSearchTerm:(NSString *)searchTerm
                            siteURL:(NSURL *)siteURL
                        resultLimit:(NSUInteger)resultLimit
@@ -100,41 +164,68 @@ NSUInteger const WMFMaxSearchResultLimit = 24;
                  };
     }
 
-    [self performSearchRequestForSearchTerm:searchTerm url:siteURL queryParameters:params appendToPreviousResults:previousResults failure:failure success:success];
+    NSString *cacheKey = [WMFSearchFetcher cacheKeyForSearchTerm:searchTerm siteURL:siteURL namespace:@0 resultLimit:resultLimit fullTextSearch:fullTextSearch];
+    [self performSearchRequestForSearchTerm:searchTerm url:siteURL queryParameters:params cacheKey:cacheKey appendToPreviousResults:previousResults failure:failure success:success];
 }
 
-- (void)performSearchRequestForSearchTerm:(NSString *)searchTerm url:(NSURL *)url queryParameters:(NSDictionary *)queryParameters appendToPreviousResults:(nullable WMFSearchResults *)previousResults failure:(WMFErrorHandler)failure success:(WMFSearchResultsHandler)success {
-    [self performMediaWikiAPIGETForURL:url
-                   withQueryParameters:queryParameters
-                     completionHandler:^(NSDictionary<NSString *, id> *_Nullable result, NSHTTPURLResponse *_Nullable response, NSError *_Nullable error) {                         if (error) {
-                             failure(error);
-                             return;
-                         }
-
-                         NSDictionary *query = [result objectForKey:@"query"];
-                         if (!query) {
-                             WMFSearchResults *returnResults = previousResults == nil ? [[WMFSearchResults alloc] initWithLanguageVariantCode:url.wmf_languageVariantCode] : previousResults;
-                             success(returnResults);
-                             return;
-                         }
-
-                         NSError *mantleError = nil;
-                         WMFSearchResults *searchResults = [MTLJSONAdapter modelOfClass:[WMFSearchResults class] fromJSONDictionary:query languageVariantCode:url.wmf_languageVariantCode error:&mantleError];
-                         if (mantleError) {
-                             failure(mantleError);
-                             return;
-                         }
-                         searchResults.searchTerm = searchTerm;
-
-                         if (!previousResults) {
-                             success(searchResults);
-                             return;
-                         }
-
-                         [previousResults mergeValuesForKeysFromModel:searchResults];
-
-                         success(previousResults);
-                     }];
+- (void)performSearchRequestForSearchTerm:(NSString *)searchTerm url:(NSURL *)url queryParameters:(NSDictionary *)queryParameters cacheKey:(NSString *)cacheKey appendToPreviousResults:(nullable WMFSearchResults *)previousResults failure:(WMFErrorHandler)failure success:(WMFSearchResultsHandler)success {
+    void (^deliverResults)(WMFSearchResults *) = ^(WMFSearchResults *searchResults) {
+        if (!previousResults) {
+            success(searchResults);
+            return;
+        }
+
+        [previousResults appendResultsFromSearchResults:searchResults];
+
+        success(previousResults);
+    };
+
+    WMFSearchResultsCacheEntry *cacheEntry = [self.resultsCache objectForKey:cacheKey];
+    if (cacheEntry) {
+        // Delivered on the session's queue, like results from a request, so callers never see a synchronous callback
+        WMFSearchResults *cachedResults = [WMFSearchFetcher resultsFromCachedResults:cacheEntry.results searchTerm:searchTerm];
+        [self.session.delegateQueue addOperationWithBlock:^{
+            deliverResults(cachedResults);
+        }];
+        if (-[cacheEntry.date timeIntervalSinceNow] < WMFSearchResultsCacheFreshInterval) {
+            return;
+        }
+        // Revalidate. The caller already has its results, so this only updates the cache: success replaces the entry for the next search of this term, and failure leaves the stale entry to be revalidated then.
+        [self fetchSearchResultsForSearchTerm:searchTerm url:url queryParameters:queryParameters cacheKey:cacheKey completion:^(WMFSearchResults *_Nullable searchResults, NSError *_Nullable error) {
+            if (!searchResults) {
+                DDLogWarn(@"Failed to revalidate cached search results: %@", error);
+            }
+        }];
+        return;
+    }
+
+    [self fetchSearchResultsForSearchTerm:searchTerm
+                                      url:url
+                          queryParameters:queryParameters
+                                 cacheKey:cacheKey
+                               completion:^(WMFSearchResults *_Nullable searchResults, NSError *_Nullable error) {
+                                   if (!searchResults) {
+                                       failure(error ?: [WMFFetcher unexpectedResponseError]);
+                                       return;
+                                   }
+                                   deliverResults([WMFSearchFetcher resultsFromCachedResults:searchResults searchTerm:searchTerm]);
+                               }];
+}
+
+/// Fetches and decodes one page of results, caching them as decoded so the same term never needs decoding twice
+- (void)fetchSearchResultsForSearchTerm:(NSString *)searchTerm url:(NSURL *)url queryParameters:(NSDictionary *)queryParameters cacheKey:(NSString *)cacheKey completion:(void (^)(WMFSearchResults *_Nullable searchResults, NSError *_Nullable error))completion {
+    [self fetchDecodedSearchResultsForSearchTerm:searchTerm
+                                             url:url
+                                 queryParameters:queryParameters
+                                      completion:^(WMFSearchResults *_Nullable searchResults, NSError *_Nullable error) {
+                                          if (!searchResults) {
+                                              completion(nil, error);
+                                              return;
+                                          }
+
+                                          [self.resultsCache setObject:[[WMFSearchResultsCacheEntry alloc] initWithResults:searchResults] forKey:cacheKey];
+                                          completion(searchResults, nil);
+                                      }];
 }
 
 - (void)fetchFilesForSearchTerm:(NSString *)searchTerm
@@ -209,7 +300,8 @@ NSUInteger const WMFMaxSearchResultLimit = 24;
                    @"redirects": @1,
                    };
     }
-    [self performSearchRequestForSearchTerm:searchTerm url:url queryParameters:params appendToPreviousResults:results failure:failure success:success];
+    NSString *cacheKey = [WMFSearchFetcher cacheKeyForSearchTerm:searchTerm siteURL:siteURL namespace:namespace resultLimit:resultLimit fullTextSearch:fullTextSearch];
+    [self performSearchRequestForSearchTerm:searchTerm url:url queryParameters:params cacheKey:cacheKey appendToPreviousResults:results failure:failure success:success];
 }
 
 @end
@@ -86,6 +86,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - Merge
 
+// Calls the merge methods directly instead of through -mergeValuesForKeysFromModel:, which finds them by reflecting over every property
+- (void)appendResultsFromSearchResults:(WMFSearchResults *)searchResults {
+    [self mergeResultsFromModel:searchResults];
+    [self mergeRedirectMappingsFromModel:searchResults];
+    [self mergeSearchSuggestionFromModel:searchResults];
+}
+
 - (void)mergeRedirectMappingsFromModel:(WMFSearchResults *)searchResults {
     NSArray *newMappings = [searchResults.redirectMappings wmf_reject:^BOOL(MWKSearchRedirectMapping *mapping) {
         return [self.redirectMappings containsObject:mapping];
@@ -4,4 +4,7 @@
 
 @property (nonatomic, copy, readwrite) NSString *searchTerm;
 
+/// Appends another page of results for the same search, skipping any already present
+- (void)appendResultsFromSearchResults:(WMFSearchResults *)searchResults;
+
 @end
@@ -429,6 +429,7 @@ static NSString *const WMFSettingsURLDonation = @"https://donate.wikimedia.org/?
 
     [SharedContainerCacheHousekeeping deleteStaleCachedItemsIn:SharedContainerCacheCommonNames.talkPageCache cleanupLevel:WMFCleanupLevelHigh];
     [SharedContainerCacheHousekeeping deleteStaleCachedItemsIn:SharedContainerCacheCommonNames.didYouKnowCache cleanupLevel:WMFCleanupLevelHigh];
+    [DiffFetcher clearDiffCacheWithCompletion:nil];
 }
 
 - (void)showClearCacheInProgressBanner {
@@ -15,63 +15,125 @@ import CocoaLumberjackSwift
             return []
         }
     }()
-    
-    @objc static let allLanguageLinks: [MWKLanguageLink] = {
-        return allWikipedias.map { (wikipedia) -> MWKLanguageLink in
-            var localizedName = wikipedia.localName
-            if !wikipedia.languageCode.contains("-") {
-                // Use localeOverrideCode for Locale lookup when the MW
-                // language code conflicts with ISO 639 (e.g. "als" is
-                // Alemannic in MW but Albanian in ISO 639-3). T398296
-                let lookupCode = wikipedia.localeOverrideCode ?? wikipedia.languageCode
-                if let iOSLocalizedName = Locale.current.localizedString(forLanguageCode: lookupCode) {
-                    localizedName = iOSLocalizedName
-                }
-            } else if !Locale.current.isEnglish {
-                if let iOSLocalizedName = Locale.current.localizedString(forIdentifier: wikipedia.languageCode) {
-                    localizedName = iOSLocalizedName
-                }
-            }
-            return MWKLanguageLink(languageCode: wikipedia.languageCode, pageTitleText: "", name: wikipedia.languageName, localizedName: localizedName, languageVariantCode: nil, altISOCode: wikipedia.altISOCode)
-        }
-    }()
 
-    @objc static let allLanguageVariantsByWikipediaLanguageCode: [String:[MWKLanguageLink]] = {
+    static let allWikipediaLanguageVariantsByWikipediaLanguageCode: [String: [WikipediaLanguageVariant]] = {
         guard let languagesFileURL = Bundle.wmf.url(forResource: "wikipedia-language-variants", withExtension: "json") else {
             return [:]
         }
         do {
             let data = try Data(contentsOf: languagesFileURL)
-            let entries = try JSONDecoder().decode([String : [WikipediaLanguageVariant]].self, from: data)
-            return entries.mapValues { wikipediaLanguageVariants -> [MWKLanguageLink] in
-                wikipediaLanguageVariants.map { wikipediaLanguageVariant in
- 
-                    var localizedName = wikipediaLanguageVariant.localName
-                    if !Locale.current.isEnglish,
-                        let iOSLocalizedName = Locale.current.localizedString(forIdentifier: wikipediaLanguageVariant.languageVariantCode) {
-                        localizedName = iOSLocalizedName
-                    }
-                    
-                    return MWKLanguageLink(languageCode: wikipediaLanguageVariant.languageCode, pageTitleText: "", name: wikipediaLanguageVariant.languageName, localizedName: localizedName, languageVariantCode: wikipediaLanguageVariant.languageVariantCode, altISOCode: nil)
-                }
-            }
+            return try JSONDecoder().decode([String: [WikipediaLanguageVariant]].self, from: data)
         } catch let error {
             DDLogError("Error decoding language variant list \(error)")
             return [:]
         }
     }()
-    
-    static var allLanguageVariants: [WikipediaLanguageVariant]? {
-        guard let languagesFileURL = Bundle.wmf.url(forResource: "wikipedia-language-variants", withExtension: "json") else {
+
+    // MARK: - Lookups by code
+
+    // The tables below hold only the decoded structs. Building an MWKLanguageLink means asking Locale for a localized name,
+    // which is the expensive part, so links are only made for the codes that are actually looked up.
+
+    private static let wikipediasByLanguageCode: [String: Wikipedia] = {
+        return Dictionary(allWikipedias.map { ($0.languageCode, $0) }, uniquingKeysWith: { first, _ in first })
+    }()
+
+    private static let wikipediaLanguageVariantsByLanguageVariantCode: [String: WikipediaLanguageVariant] = {
+        let variants = allWikipediaLanguageVariantsByWikipediaLanguageCode.values.flatMap { $0 }
+        return Dictionary(variants.map { ($0.languageVariantCode, $0) }, uniquingKeysWith: { first, _ in first })
+    }()
+
+    /// Maps alternate ISO codes (like "nb" for Norwegian) to Wikipedia language codes
+    @objc static let languageCodesByAltISOCode: [String: String] = {
+        var languageCodesByAltISOCode: [String: String] = [:]
+        for wikipedia in allWikipedias where allWikipediaLanguageVariantsByWikipediaLanguageCode[wikipedia.languageCode] == nil {
+            if let altISOCode = wikipedia.altISOCode {
+                languageCodesByAltISOCode[altISOCode] = wikipedia.languageCode
+            }
+        }
+        return languageCodesByAltISOCode
+    }()
+
+    private static let languageLinksLock = NSLock()
+    private static var languageLinksByContentLanguageCode: [String: MWKLanguageLink] = [:]
+
+    /// The language link with the given content language code, matching the entry in `MWKLanguageLinkController.allLanguages`.
+    /// Sites with variants are only represented by their variants, so their site language code returns nil.
+    @objc(languageLinkForContentLanguageCode:)
+    static func languageLink(forContentLanguageCode contentLanguageCode: String) -> MWKLanguageLink? {
+        languageLinksLock.lock()
+        defer {
+            languageLinksLock.unlock()
+        }
+        if let languageLink = languageLinksByContentLanguageCode[contentLanguageCode] {
+            return languageLink
+        }
+        let languageLink: MWKLanguageLink
+        if let variant = wikipediaLanguageVariantsByLanguageVariantCode[contentLanguageCode],
+           wikipediasByLanguageCode[variant.languageCode] != nil {
+            languageLink = makeLanguageLink(for: variant)
+        } else if let wikipedia = wikipediasByLanguageCode[contentLanguageCode],
+                  allWikipediaLanguageVariantsByWikipediaLanguageCode[contentLanguageCode] == nil {
+            languageLink = makeLanguageLink(for: wikipedia)
+        } else {
             return nil
         }
-        do {
-            let data = try Data(contentsOf: languagesFileURL)
-            let entries = try JSONDecoder().decode([String : [WikipediaLanguageVariant]].self, from: data)
-            return entries.values.flatMap { $0 }
-        } catch let error {
-            DDLogError("Error decoding language variant list \(error)")
+        languageLinksByContentLanguageCode[contentLanguageCode] = languageLink
+        return languageLink
+    }
+
+    private static func makeLanguageLink(for wikipedia: Wikipedia) -> MWKLanguageLink {
+        var localizedName = wikipedia.localName
+        if !wikipedia.languageCode.contains("-") {
+            // Use localeOverrideCode for Locale lookup when the MW
+            // language code conflicts with ISO 639 (e.g. "als" is
+            // Alemannic in MW but Albanian in ISO 639-3). T398296
+            let lookupCode = wikipedia.localeOverrideCode ?? wikipedia.languageCode
+            if let iOSLocalizedName = Locale.current.localizedString(forLanguageCode: lookupCode) {
+                localizedName = iOSLocalizedName
+            }
+        } else if !Locale.current.isEnglish {
+            if let iOSLocalizedName = Locale.current.localizedString(forIdentifier: wikipedia.languageCode) {
+                localizedName = iOSLocalizedName
+            }
+        }
+        return MWKLanguageLink(languageCode: wikipedia.languageCode, pageTitleText: "", name: wikipedia.languageName, localizedName: localizedName, languageVariantCode: nil, altISOCode: wikipedia.altISOCode)
+    }
+
+    private static func makeLanguageLink(for wikipediaLanguageVariant: WikipediaLanguageVariant) -> MWKLanguageLink {
+        var localizedName = wikipediaLanguageVariant.localName
+        if !Locale.current.isEnglish,
+            let iOSLocalizedName = Locale.current.localizedString(forIdentifier: wikipediaLanguageVariant.languageVariantCode) {
+            localizedName = iOSLocalizedName
+        }
+        return MWKLanguageLink(languageCode: wikipediaLanguageVariant.languageCode, pageTitleText: "", name: wikipediaLanguageVariant.languageName, localizedName: localizedName, languageVariantCode: wikipediaLanguageVariant.languageVariantCode, altISOCode: nil)
+    }
+
+    // MARK: - All languages
+
+    /// Site language links for every Wikipedia, including sites with variants. Links already made by a lookup are reused.
+    @objc static let allLanguageLinks: [MWKLanguageLink] = {
+        return allWikipedias.map { (wikipedia) -> MWKLanguageLink in
+            if allWikipediaLanguageVariantsByWikipediaLanguageCode[wikipedia.languageCode] == nil,
+               let languageLink = languageLink(forContentLanguageCode: wikipedia.languageCode) {
+                return languageLink
+            }
+            return makeLanguageLink(for: wikipedia)
+        }
+    }()
+
+    @objc static let allLanguageVariantsByWikipediaLanguageCode: [String:[MWKLanguageLink]] = {
+        return allWikipediaLanguageVariantsByWikipediaLanguageCode.mapValues { wikipediaLanguageVariants -> [MWKLanguageLink] in
+            wikipediaLanguageVariants.map { wikipediaLanguageVariant in
+                return languageLink(forContentLanguageCode: wikipediaLanguageVariant.languageVariantCode) ?? makeLanguageLink(for: wikipediaLanguageVariant)
+            }
+        }
+    }()
+    
+    static var allLanguageVariants: [WikipediaLanguageVariant]? {
+        guard !allWikipediaLanguageVariantsByWikipediaLanguageCode.isEmpty else {
             return nil
         }
+        return allWikipediaLanguageVariantsByWikipediaLanguageCode.values.flatMap { $0 }
     }
 }
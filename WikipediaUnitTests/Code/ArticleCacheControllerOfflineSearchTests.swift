@@ -0,0 +1,146 @@
+import Foundation
+import Testing
+import WMFData
+@testable import WMF
+
+// The backfill reads article files from the shared Permanent Cache directory, so these run one at a time
+@Suite(.serialized)
+struct ArticleCacheControllerOfflineSearchTests {
+    private let groupKey = "https://en.wikipedia.org/wiki/Dog"
+    private let mobileHTMLURL = URL(string: "https://en.wikipedia.org/api/rest_v1/page/mobile-html/Dog")!
+    private let mobileHTML = "<html><head><title>Wolf</title></head><body><section><p>The dog is a domesticated descendant of the wolf.</p></section></body></html>"
+
+    @Test
+    func savedMobileHTMLIsIndexed() throws {
+        let harness = try makeHarness()
+
+        harness.controller.finishFileSave(data: Data(mobileHTML.utf8), mimeType: "text/html", uniqueKey: "Dog", url: mobileHTMLURL, groupKey: groupKey)
+        harness.controller.offlineSearchIndexingQueue.sync {}
+
+        #expect(try harness.index.search("wolf", languageCode: "en").map { $0.key } == [groupKey])
+        #expect(try harness.index.search("domesticated", languageCode: "de").isEmpty)
+    }
+
+    @Test
+    func otherResourcesAreNotIndexed() throws {
+        let harness = try makeHarness()
+        let cssURL = try #require(URL(string: "https://en.wikipedia.org/api/rest_v1/data/css/mobile/site"))
+
+        harness.controller.finishFileSave(data: Data("p { color: wolf; }".utf8), mimeType: "text/css", uniqueKey: "site", url: cssURL, groupKey: groupKey)
+        harness.controller.offlineSearchIndexingQueue.sync {}
+
+        #expect(try harness.index.search("wolf", languageCode: "en").isEmpty)
+    }
+
+    @Test
+    func removedArticleIsDroppedFromIndex() async throws {
+        let harness = try makeHarness()
+        harness.controller.finishFileSave(data: Data(mobileHTML.utf8), mimeType: "text/html", uniqueKey: "Dog", url: mobileHTMLURL, groupKey: groupKey)
+
+        // There's no cache group for the article, so the removal itself fails. The index entry is dropped either way.
+        await withCheckedContinuation { continuation in
+            harness.controller.remove(groupKey: groupKey, individualCompletion: { _ in }, groupCompletion: { _ in
+                continuation.resume()
+            })
+        }
+        harness.controller.offlineSearchIndexingQueue.sync {}
+
+        #expect(try harness.index.search("wolf", languageCode: "en").isEmpty)
+    }
+
+    @Test
+    func backfillIndexesArticlesSavedBeforeTheIndexExisted() async throws {
+        let harness = try makeHarness()
+        let fileURL = try saveMobileHTMLFile(for: harness.controller)
+        defer {
+            try? FileManager.default.removeItem(at: fileURL)
+        }
+
+        await harness.controller.backfillOfflineSearchIndex()
+
+        #expect(try harness.index.search("wolf", languageCode: "en").map { $0.key } == [groupKey])
+        let didBackfill: Bool? = try harness.userDefaultsStore.load(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue)
+        #expect(didBackfill == true)
+
+        // Once backfilled, articles missing from the index aren't looked for again
+        try harness.index.remove(key: groupKey)
+        await harness.controller.backfillOfflineSearchIndex()
+        #expect(try harness.index.search("wolf", languageCode: "en").isEmpty)
+    }
+
+    @Test
+    func newIndexFileIsBackfilledAgain() throws {
+        let userDefaultsStore = KeyValueStore()
+        try userDefaultsStore.save(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue, value: true)
+
+        _ = try makeHarness(userDefaultsStore: userDefaultsStore)
+
+        let didBackfill: Bool? = try userDefaultsStore.load(key: WMFUserDefaultsKey.didBackfillOfflineSearchIndex.rawValue)
+        #expect(didBackfill == false)
+    }
+
+    private func makeHarness(userDefaultsStore: KeyValueStore = KeyValueStore()) throws -> (controller: ArticleCacheController, index: WMFOfflineSearchIndex, userDefaultsStore: KeyValueStore) {
+        let directoryURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        let moc = try #require(CacheController.createCacheContext(cacheURL: directoryURL))
+        let session = Session(configuration: .current, httpClientProvider: SearchHTTPClientProvider(httpClient: SearchHTTPClient()))
+        let imageCache = ImageCacheController(moc: moc, session: session, configuration: .current)
+        let controller = ArticleCacheController(moc: moc, imageCacheController: imageCache, session: session, configuration: .current, preferredLanguageDelegate: PreferredLanguageInfoProvider(), offlineSearchIndexURL: directoryURL.appendingPathComponent("OfflineSearch.sqlite"), userDefaultsStore: userDefaultsStore)
+        let index = try #require(controller.offlineSearchIndex)
+        return (controller, index, userDefaultsStore)
+    }
+
+    /// Stands in for an article saved by an earlier version: downloaded, in a cache group, and on disk
+    private func saveMobileHTMLFile(for controller: ArticleCacheController) throws -> URL {
+        let itemKey = mobileHTMLURL.absoluteString
+        let fileName = try #require(controller.fileWriter.uniqueFileNameForItemKey(itemKey, variant: nil))
+        let fileURL = CacheFileWriterHelper.fileURL(for: fileName)
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try Data(mobileHTML.utf8).write(to: fileURL)
+
+        let moc = controller.dbWriter.context
+        try moc.performAndWait {
+            let item = try #require(CacheDBWriterHelper.createCacheItem(with: mobileHTMLURL, itemKey: itemKey, variant: nil, in: moc))
+            let group = try #require(CacheDBWriterHelper.createCacheGroup(with: groupKey, in: moc))
+            item.isDownloaded = true
+            item.addToCacheGroups(group)
+            try moc.save()
+        }
+        return fileURL
+    }
+}
+
+private extension ArticleCacheController {
+    func backfillOfflineSearchIndex() async {
+        await withCheckedContinuation { continuation in
+            backfillOfflineSearchIndexIfNeeded(after: .seconds(0)) {
+                continuation.resume()
+            }
+        }
+    }
+}
+
+private final class KeyValueStore: WMFKeyValueStore {
+    private var values: [String: Codable] = [:]
+
+    func load<T: Codable>(key: String...) throws -> T? {
+        values[key.joined(separator: ".")] as? T
+    }
+
+    func save<T: Codable>(key: String..., value: T) throws {
+        values[key.joined(separator: ".")] = value
+    }
+
+    func remove(key: String...) throws {
+        values.removeValue(forKey: key.joined(separator: "."))
+    }
+}
+
+private final class PreferredLanguageInfoProvider: NSObject, WMFPreferredLanguageInfoProvider {
+    func getPreferredContentLanguageCodes(_ completion: @escaping ([String]) -> Void) {
+        completion(["en"])
+    }
+
+    func getPreferredLanguageCodes(_ completion: @escaping ([String]) -> Void) {
+        completion(["en"])
+    }
+}
@@ -0,0 +1,122 @@
+import Foundation
+import Testing
+@testable import Wikipedia
+@testable import WMF
+
+struct ArticleSummaryBatchTests {
+
+    @Test
+    func normalizedConvertedAndRedirectedTitlesMapBackToRequestedKeys() async throws {
+        let obama = try articleKey("obama")
+        let colour = try articleKey("Colour")
+        let dog = try articleKey("Dog")
+        let nonexistent = try articleKey("Nonexistent_page")
+        let fixture = try fixtureData(named: "SummaryQueryTitleMappings")
+        let harness = makeHarness { _ in fixture }
+
+        let summaries = await harness.fetcher.fetchArticleSummaryResponses(forArticlesWithKeys: [obama, colour, dog, nonexistent])
+
+        #expect(summaries[obama]?.title == "Barack_Obama")
+        #expect(summaries[obama]?.wikidataID == "Q76")
+        #expect(summaries[obama]?.revision == "1180000002")
+        #expect(summaries[colour]?.extract == "Color or colour is the visual perception based on the electromagnetic spectrum.")
+        #expect(summaries[dog]?.thumbnail?.source == "https://upload.wikimedia.org/wikipedia/commons/thumb/1/15/Dog.jpg/320px-Dog.jpg")
+        #expect(summaries[dog]?.coordinates?.lat == 52.2)
+        // Missing pages are accounted for by the batch, so they don't fall back to the Page Content Service
+        #expect(summaries[nonexistent] == nil)
+        #expect(harness.httpClient.capturedRequests.count == 1)
+    }
+
+    @Test
+    func continuedResponsesAreMerged() async throws {
+        let cat = try articleKey("Cat")
+        let dog = try articleKey("Dog")
+        let continued = try fixtureData(named: "SummaryQueryContinued")
+        let continuation = try fixtureData(named: "SummaryQueryContinuation")
+        let harness = makeHarness { request in
+            request.url?.query?.contains("excontinue=1") == true ? continuation : continued
+        }
+
+        let summaries = await harness.fetcher.fetchArticleSummaryResponses(forArticlesWithKeys: [cat, dog])
+
+        #expect(summaries[cat]?.extract == "The cat is a domestic species of small carnivorous mammal.")
+        #expect(summaries[cat]?.articleDescription == "Small domesticated carnivorous mammal")
+        #expect(summaries[dog]?.extract == "The dog is a domesticated descendant of the wolf.")
+        #expect(summaries[dog]?.articleDescription == "Domestic animal")
+        #expect(harness.httpClient.capturedRequests.count == 2)
+    }
+
+    @Test
+    func titlesMissingFromTheBatchFallBackToPageContentService() async throws {
+        let cat = try articleKey("Cat")
+        let dog = try articleKey("Dog")
+        let fixture = try fixtureData(named: "SummaryQueryTitleMappings")
+        let harness = makeHarness { request in
+            (try? self.pageContentServiceSummary(for: request)) ?? fixture
+        }
+
+        let summaries = await harness.fetcher.fetchArticleSummaryResponses(forArticlesWithKeys: [cat, dog])
+
+        #expect(summaries[dog]?.extract == "The dog is a domesticated descendant of the wolf.")
+        #expect(summaries[cat]?.extract == "Cat from the Page Content Service")
+        let summaryPaths = harness.httpClient.capturedRequests.compactMap { $0.url?.path }.filter { $0.contains("/page/summary/") }
+        #expect(summaryPaths.map { ($0 as NSString).lastPathComponent } == ["Cat"])
+    }
+
+    @Test
+    func failedBatchFallsBackToPageContentService() async throws {
+        let cat = try articleKey("Cat")
+        let dog = try articleKey("Dog")
+        let error = try JSONSerialization.data(withJSONObject: ["error": ["code": "internal_api_error_DBQueryError", "info": "A database query error has occurred."]])
+        let harness = makeHarness { request in
+            (try? self.pageContentServiceSummary(for: request)) ?? error
+        }
+
+        let summaries = await harness.fetcher.fetchArticleSummaryResponses(forArticlesWithKeys: [cat, dog])
+
+        #expect(summaries[cat]?.extract == "Cat from the Page Content Service")
+        #expect(summaries[dog]?.extract == "Dog from the Page Content Service")
+        #expect(harness.httpClient.capturedRequests.count == 3)
+    }
+
+    private func makeHarness(responseDataForRequest: @escaping (URLRequest) -> Data) -> (fetcher: ArticleFetcher, httpClient: SearchHTTPClient) {
+        let httpClient = SearchHTTPClient()
+        httpClient.responseDataForRequest = responseDataForRequest
+        let session = Session(configuration: .current, httpClientProvider: SearchHTTPClientProvider(httpClient: httpClient))
+        let fetcher = ArticleFetcher(session: session, configuration: .current)
+        return (fetcher, httpClient)
+    }
+
+    private func articleKey(_ title: String) throws -> WMFInMemoryURLKey {
+        try #require(URL(string: "https://en.wikipedia.org/wiki/\(title)")?.wmf_inMemoryKey)
+    }
+
+    /// A Page Content Service summary for `/page/summary/` requests
+    private func pageContentServiceSummary(for request: URLRequest) throws -> Data {
+        guard let path = request.url?.path, path.contains("/page/summary/") else {
+            throw RequestError.unexpectedResponse
+        }
+        let title = (path as NSString).lastPathComponent
+        return try JSONSerialization.data(withJSONObject: [
+            "title": title,
+            "extract": "\(title) from the Page Content Service",
+            "content_urls": ["desktop": ["page": "https://en.wikipedia.org/wiki/\(title)"]]
+        ])
+    }
+
+    private func fixtureData(named name: String) throws -> Data {
+        try #require(Bundle(for: ArticleSummaryBatchTestBundleToken.self).wmf_data(fromContentsOfFile: name, ofType: "json"))
+    }
+}
+
+private final class ArticleSummaryBatchTestBundleToken {}
+
+private extension ArticleFetcher {
+    func fetchArticleSummaryResponses(forArticlesWithKeys articleKeys: [WMFInMemoryURLKey]) async -> [WMFInMemoryURLKey: ArticleSummary] {
+        await withCheckedContinuation { continuation in
+            fetchArticleSummaryResponsesForArticles(withKeys: articleKeys) { summaries in
+                continuation.resume(returning: summaries)
+            }
+        }
+    }
+}
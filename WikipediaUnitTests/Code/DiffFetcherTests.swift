@@ -0,0 +1,103 @@
+import Foundation
+import Testing
+@testable import Wikipedia
+@testable import WMF
+
+// The diff cache is shared by every fetcher, so these run one at a time and each uses its own revisions
+@Suite(.serialized)
+struct DiffFetcherTests {
+    private let siteURL = URL(string: "https://en.wikipedia.org")!
+
+    @Test
+    func requestForDiffInFlightJoinsIt() async throws {
+        await clearDiffCache()
+        let harness = try makeHarness(response: diffResponse(text: "Joined"))
+
+        let results: [Result<DiffResponse, Error>] = await withCheckedContinuation { continuation in
+            let lock = NSLock()
+            var results: [Result<DiffResponse, Error>] = []
+            let completion: (Result<DiffResponse, Error>) -> Void = { result in
+                lock.lock()
+                results.append(result)
+                let isDone = results.count == 2
+                lock.unlock()
+                if isDone {
+                    continuation.resume(returning: results)
+                }
+            }
+
+            // The second request comes in before the first has had a chance to finish
+            harness.fetcher.fetchDiff(fromRevisionId: 201, toRevisionId: 202, siteURL: siteURL, completion: completion)
+            harness.fetcher.fetchDiff(fromRevisionId: 201, toRevisionId: 202, siteURL: siteURL, completion: completion)
+        }
+
+        for result in results {
+            #expect((try result.get()).diff.map { $0.text } == ["Joined"])
+        }
+        #expect(harness.httpClient.capturedRequests.count == 1)
+
+        // Later requests come from memory
+        let cached = try await harness.fetcher.fetchDiff(fromRevisionId: 201, toRevisionId: 202, siteURL: siteURL)
+        #expect(cached.diff.map { $0.text } == ["Joined"])
+        #expect(harness.httpClient.capturedRequests.count == 1)
+    }
+
+    @Test
+    func diffOnDiskIsNotRefetched() async throws {
+        await clearDiffCache()
+        let harness = try makeHarness(response: diffResponse(text: "From the network"))
+
+        // A second instance over the same directory stands in for a previous launch that cached the diff
+        let key = try #require(DiffFetcher.diffCacheKey(fromRevisionId: 101, toRevisionId: 102, siteURL: siteURL))
+        SharedContainerShardedCache(name: SharedContainerCacheCommonNames.diffCache).setValue(diffResponse(text: "From disk"), forKey: key)
+
+        let response = try await harness.fetcher.fetchDiff(fromRevisionId: 101, toRevisionId: 102, siteURL: siteURL)
+
+        #expect(response.diff.map { $0.text } == ["From disk"])
+        #expect(harness.httpClient.capturedRequests.isEmpty)
+    }
+
+    @Test
+    func clearingDiffCacheRefetches() async throws {
+        await clearDiffCache()
+        let harness = try makeHarness(response: diffResponse(text: "Cleared"))
+
+        _ = try await harness.fetcher.fetchDiff(fromRevisionId: 301, toRevisionId: 302, siteURL: siteURL)
+        await clearDiffCache()
+        _ = try await harness.fetcher.fetchDiff(fromRevisionId: 301, toRevisionId: 302, siteURL: siteURL)
+
+        #expect(harness.httpClient.capturedRequests.count == 2)
+    }
+
+    private func makeHarness(response: DiffResponse) throws -> (fetcher: DiffFetcher, httpClient: SearchHTTPClient) {
+        let httpClient = SearchHTTPClient()
+        httpClient.responseData = try JSONEncoder().encode(response)
+        let session = Session(configuration: .current, httpClientProvider: SearchHTTPClientProvider(httpClient: httpClient))
+        let fetcher = DiffFetcher(session: session, configuration: .current)
+        return (fetcher, httpClient)
+    }
+
+    private func diffResponse(text: String) -> DiffResponse {
+        let item = DiffItem(type: .change, text: text, highlightRanges: nil, moveInfo: nil, offset: DiffItemOffset(from: 0, to: 0), lineNumber: 1)
+        let sides = DiffSideMetaData(sections: [])
+        return DiffResponse(diff: [item], from: sides, to: sides)
+    }
+
+    private func clearDiffCache() async {
+        await withCheckedContinuation { continuation in
+            DiffFetcher.clearDiffCache {
+                continuation.resume()
+            }
+        }
+    }
+}
+
+private extension DiffFetcher {
+    func fetchDiff(fromRevisionId: Int, toRevisionId: Int, siteURL: URL) async throws -> DiffResponse {
+        try await withCheckedThrowingContinuation { continuation in
+            fetchDiff(fromRevisionId: fromRevisionId, toRevisionId: toRevisionId, siteURL: siteURL) { result in
+                continuation.resume(with: result)
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+import XCTest
+@testable import Wikipedia
+
+class DiffTransformerTests: XCTestCase {
+
+    let siteURL = URL(string: "https://en.wikipedia.org")!
+    let traitCollection = UITraitCollection(traitsFrom: [UITraitCollection(horizontalSizeClass: .compact), UITraitCollection(verticalSizeClass: .regular)])
+
+    private func item(_ type: DiffItemType, lineNumber: Int?, from: Int?, to: Int?, moveInfo: DiffMoveInfo? = nil) -> DiffItem {
+        let highlightRanges = type == .change ? [DiffHighlightRange(start: 0, length: 4, type: .add)] : nil
+        return DiffItem(type: type, text: "Line \(lineNumber ?? 0) text", highlightRanges: highlightRanges, moveInfo: moveInfo, offset: DiffItemOffset(from: from, to: to), lineNumber: lineNumber)
+    }
+
+    /// An intro change, a paragraph moved from History to Geography, and a gap of unedited lines
+    private var response: DiffResponse {
+        let sections = DiffSideMetaData(sections: [
+            DiffSection(level: 2, heading: "History", offset: 100),
+            DiffSection(level: 2, heading: "Geography", offset: 200)
+        ])
+        let diff = [
+            item(.context, lineNumber: 1, from: 0, to: 0),
+            item(.change, lineNumber: 2, from: 10, to: 10),
+            item(.context, lineNumber: 3, from: 20, to: 20),
+            item(.moveSource, lineNumber: 4, from: 150, to: nil, moveInfo: DiffMoveInfo(id: "a", linkId: "b", linkDirection: .down)),
+            item(.context, lineNumber: 5, from: 160, to: 140),
+            item(.moveDestination, lineNumber: 6, from: nil, to: 250, moveInfo: DiffMoveInfo(id: "b", linkId: "a", linkDirection: .up)),
+            item(.context, lineNumber: 20, from: 300, to: 300)
+        ]
+        return DiffResponse(diff: diff, from: sections, to: sections)
+    }
+
+    func testCompareGroups() throws {
+        let viewModels = try DiffTransformer(type: .compare, siteURL: siteURL).viewModels(from: response, theme: .standard, traitCollection: traitCollection)
+
+        XCTAssertEqual(viewModels.count, 8)
+        XCTAssert(viewModels[0] is DiffListContextViewModel)
+        XCTAssert(viewModels[1] is DiffListChangeViewModel)
+        XCTAssert(viewModels[6] is DiffListUneditedViewModel)
+        XCTAssert(viewModels[7] is DiffListContextViewModel)
+
+        for index in [3, 5] {
+            let moveItem = try XCTUnwrap((viewModels[index] as? DiffListChangeViewModel)?.items.first)
+            XCTAssertEqual(moveItem.moveInfo?.groupedIndex, 0)
+            guard case .section(let amount) = moveItem.moveInfo?.moveDistance else {
+                XCTFail("Expected the paragraph to have moved across sections")
+                continue
+            }
+            XCTAssertEqual(amount, 1)
+        }
+    }
+
+    func testSingleGroupsBySection() throws {
+        let viewModels = try DiffTransformer(type: .single, siteURL: siteURL).viewModels(from: response, theme: .standard, traitCollection: traitCollection)
+
+        let headings = viewModels.compactMap { ($0 as? DiffListChangeViewModel)?.heading }
+        XCTAssertEqual(headings, ["Intro", "History", "Geography"])
+    }
+
+    func testHighlightsMatchLayoutText() throws {
+        let viewModels = try DiffTransformer(type: .compare, siteURL: siteURL).viewModels(from: response, theme: .standard, traitCollection: traitCollection)
+        let changeItem = try XCTUnwrap((viewModels[1] as? DiffListChangeViewModel)?.items.first)
+
+        let layoutAttributedString = try XCTUnwrap(changeItem.layoutAttributedString)
+        let textAttributedString = try XCTUnwrap(changeItem.textAttributedString)
+        XCTAssertEqual(layoutAttributedString.string, textAttributedString.string)
+        XCTAssertNil(layoutAttributedString.attribute(.backgroundColor, at: 0, effectiveRange: nil))
+        XCTAssertEqual(textAttributedString.attribute(.backgroundColor, at: 0, effectiveRange: nil) as? UIColor, Theme.standard.colors.diffHighlightAdd)
+        XCTAssertEqual(textAttributedString.attribute(.font, at: 0, effectiveRange: nil) as? UIFont, layoutAttributedString.attribute(.font, at: 0, effectiveRange: nil) as? UIFont)
+    }
+
+    // MARK: - Performance
+
+    /// 20,000 lines across 2,000 sections: mostly context and changes, with a moved paragraph every 500 lines and a gap of unedited lines every 50
+    private static func largeResponse() -> DiffResponse {
+        let types: [DiffItemType] = [.context, .context, .change, .addLine, .context, .deleteLine, .context, .change, .context, .context]
+        var diff: [DiffItem] = []
+        diff.reserveCapacity(20000)
+        var lineNumber = 1
+        for index in 0..<20000 {
+            let offset = index * 100
+            var type = types[index % types.count]
+            var moveInfo: DiffMoveInfo?
+            if index % 500 == 250 {
+                type = .moveSource
+                moveInfo = DiffMoveInfo(id: "source\(index)", linkId: "destination\(index)", linkDirection: .down)
+            } else if index % 500 == 499 {
+                type = .moveDestination
+                moveInfo = DiffMoveInfo(id: "destination\(index - 249)", linkId: "source\(index - 249)", linkDirection: .up)
+            }
+            let text = "Line \(index) of a long revision, with enough text that it wraps onto a second line on a phone."
+            let highlightRanges = type == .change ? [DiffHighlightRange(start: 5, length: 10, type: .add), DiffHighlightRange(start: 30, length: 4, type: .delete)] : nil
+            diff.append(DiffItem(type: type, text: text, highlightRanges: highlightRanges, moveInfo: moveInfo, offset: DiffItemOffset(from: offset, to: offset), lineNumber: lineNumber))
+            lineNumber += index % 50 == 49 ? 10 : 1
+        }
+        let sections = DiffSideMetaData(sections: (0..<2000).map { DiffSection(level: 2, heading: "Section \($0)", offset: $0 * 1000 + 1) })
+        return DiffResponse(diff: diff, from: sections, to: sections)
+    }
+
+    func testLargeDiffPerformance() {
+        let response = Self.largeResponse()
+        let transformer = DiffTransformer(type: .compare, siteURL: siteURL)
+
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            do {
+                let viewModels = try transformer.viewModels(from: response, theme: .standard, traitCollection: traitCollection)
+                XCTAssertFalse(viewModels.isEmpty)
+            } catch {
+                XCTFail("Error transforming diff: \(error)")
+            }
+        }
+    }
+}
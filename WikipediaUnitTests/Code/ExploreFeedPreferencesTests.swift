@@ -0,0 +1,90 @@
+import XCTest
+@testable import WMF
+
+class ExploreFeedPreferencesTests: XCTestCase {
+
+    private let preferencesKey = "WMFExploreFeedPreferencesKey"
+    private let enSiteURL = URL(string: "https://en.wikipedia.org")!
+    private let deSiteURL = URL(string: "https://de.wikipedia.org")!
+
+    var dataStore: MWKDataStore!
+
+    override func setUp(completion: @escaping (Error?) -> Void) {
+        MWKDataStore.createTemporaryDataStore(completion: { dataStore in
+            self.dataStore = dataStore
+            completion(nil)
+        })
+    }
+
+    var moc: NSManagedObjectContext {
+        return dataStore.viewContext
+    }
+
+    var controller: WMFExploreFeedContentController {
+        return dataStore.feedContentController
+    }
+
+    func testIncrementalPassMatchesFullPassAfterPreferenceToggle() throws {
+        let customizableKinds = WMFExploreFeedContentController.customizableContentGroupKindNumbers()
+        let globalKinds = WMFExploreFeedContentController.globalContentGroupKindNumbers()
+        let allGlobalCardsOn = Dictionary(uniqueKeysWithValues: globalKinds.map { ($0, NSNumber(value: true)) })
+        var deKinds = customizableKinds
+        deKinds.remove(NSNumber(value: WMFContentGroupKind.news.rawValue))
+        savePreferences(["en": customizableKinds, "de": deKinds, WMFExploreFeedPreferencesGlobalCardsKey: allGlobalCardsOn])
+
+        let today = Date(timeIntervalSince1970: 1_700_000_000)
+        let yesterday = today.addingTimeInterval(-86_400)
+        let enFeaturedArticle = try createGroup(of: .featuredArticle, on: today, siteURL: enSiteURL)
+        let enTopRead = try createGroup(of: .topRead, on: today, siteURL: enSiteURL)
+        let dismissedFeaturedArticle = try createGroup(of: .featuredArticle, on: yesterday, siteURL: enSiteURL) { $0.wasDismissed = true }
+        let collapsedFeaturedArticle = try createGroup(of: .featuredArticle, on: yesterday, siteURL: deSiteURL) { $0.undoType = .contentGroupKind }
+        let deNews = try createGroup(of: .news, on: today, siteURL: deSiteURL)
+        let deTopRead = try createGroup(of: .topRead, on: today, siteURL: deSiteURL)
+        let continueReading = try createGroup(of: .continueReading, on: today, siteURL: enSiteURL)
+        let pictureOfTheDay = try createGroup(of: .pictureOfTheDay, on: today, siteURL: enSiteURL)
+        try moc.save()
+        controller.applyExploreFeedPreferencesToAllObjects(in: moc)
+        try moc.save()
+        XCTAssertFalse(deNews.isVisible)
+        XCTAssertFalse(dismissedFeaturedArticle.isVisible)
+
+        // Hide featured articles in English and continue reading, and show news in German
+        var enKinds = customizableKinds
+        enKinds.remove(NSNumber(value: WMFContentGroupKind.featuredArticle.rawValue))
+        var globalCards = allGlobalCardsOn
+        globalCards[NSNumber(value: WMFContentGroupKind.continueReading.rawValue)] = NSNumber(value: false)
+        savePreferences(["en": enKinds, "de": customizableKinds, WMFExploreFeedPreferencesGlobalCardsKey: globalCards])
+
+        controller.applyExploreFeedPreferencesIncrementally(in: moc)
+        let incrementalVisibility = try visibilityOfContentGroups()
+        controller.applyExploreFeedPreferencesToAllObjects(in: moc)
+        let fullVisibility = try visibilityOfContentGroups()
+
+        XCTAssertEqual(incrementalVisibility, fullVisibility)
+        XCTAssertEqual(incrementalVisibility[enFeaturedArticle.objectID], false)
+        XCTAssertEqual(incrementalVisibility[enTopRead.objectID], true)
+        XCTAssertEqual(incrementalVisibility[dismissedFeaturedArticle.objectID], false)
+        XCTAssertEqual(incrementalVisibility[collapsedFeaturedArticle.objectID], true, "Collapsed cards should be left alone")
+        XCTAssertEqual(incrementalVisibility[deNews.objectID], true)
+        XCTAssertEqual(incrementalVisibility[deTopRead.objectID], true)
+        XCTAssertEqual(incrementalVisibility[continueReading.objectID], false)
+        XCTAssertEqual(incrementalVisibility[pictureOfTheDay.objectID], true)
+    }
+
+    private func savePreferences(_ preferences: [String: Any]) {
+        moc.wmf_setValue(preferences as NSDictionary, forKey: preferencesKey)
+    }
+
+    private func createGroup(of kind: WMFContentGroupKind, on date: Date, siteURL: URL, customization: ((WMFContentGroup) -> Void)? = nil) throws -> WMFContentGroup {
+        return try XCTUnwrap(moc.createGroup(of: kind, for: date, withSiteURL: siteURL, associatedContent: nil, customizationBlock: { group in
+            group.isVisible = true
+            customization?(group)
+        }))
+    }
+
+    private func visibilityOfContentGroups() throws -> [NSManagedObjectID: Bool] {
+        let request = WMFContentGroup.fetchRequest()
+        let contentGroups = try moc.fetch(request)
+        return Dictionary(uniqueKeysWithValues: contentGroups.map { ($0.objectID, $0.isVisible) })
+    }
+}
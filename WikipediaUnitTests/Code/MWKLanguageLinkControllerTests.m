@@ -195,6 +195,26 @@
     XCTAssertNil(expectingNil);
 }
 
+- (void)testPreferredLanguagesMatchAllLanguages {
+    // Preferred languages are looked up by code rather than matched in allLanguages, so check they resolve to the same links
+    NSArray<NSString *> *contentLanguageCodes = @[@"zh-Hant-TW", @"no", @"als", @"sr-Latn"];
+    for (NSString *contentLanguageCode in contentLanguageCodes) {
+        MWKLanguageLink *language = [self.controller.allLanguages wmf_match:^BOOL(MWKLanguageLink *obj) {
+            return [obj.contentLanguageCode isEqualToString:contentLanguageCode];
+        }];
+        XCTAssertNotNil(language);
+        [self.controller appendPreferredLanguage:language];
+    }
+
+    for (NSString *contentLanguageCode in contentLanguageCodes) {
+        MWKLanguageLink *preferredLanguage = [self.controller.preferredLanguages wmf_match:^BOOL(MWKLanguageLink *obj) {
+            return [obj.contentLanguageCode isEqualToString:contentLanguageCode];
+        }];
+        XCTAssertTrue([self.controller.allLanguages containsObject:preferredLanguage], @"%@ should resolve to its entry in all languages", contentLanguageCode);
+    }
+    [self verifyAllLanguageArrayProperties];
+}
+
 - (void)testAlemannicLocaleOverride {
     // T398296: Verify that Alemannisch does not display as "Albanian"
     // iOS Locale maps "als" to Albanian (ISO 639-3), but MW uses it for Alemannic German
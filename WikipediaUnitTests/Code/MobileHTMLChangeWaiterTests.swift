@@ -0,0 +1,128 @@
+import Foundation
+import Testing
+@testable import Wikipedia
+@testable import WMF
+
+struct MobileHTMLChangeWaiterTests {
+    private let url = URL(string: "https://en.wikipedia.org/api/rest_v1/page/mobile-html/Dog")!
+
+    @Test
+    func changedETagIsDelivered() async throws {
+        let harness = makeHarness { requestIndex, _ in
+            requestIndex < 2 ? "v1" : "v2"
+        }
+
+        let result = await harness.waiter.wait(for: url, eTag: "v1", maxAttempts: 5, session: harness.session, key: "a")
+
+        #expect(try result.get() == "v2")
+        #expect(harness.httpClient.capturedRequests.count == 3)
+        #expect(harness.httpClient.capturedRequests.allSatisfy { $0.httpMethod == "HEAD" && $0.value(forHTTPHeaderField: URLRequest.ifNoneMatchHeaderKey) == "v1" })
+        #expect(harness.waiter.averageTimeToChange != nil)
+    }
+
+    @Test
+    func waitsOnTheSameURLShareAPoll() async throws {
+        // The ETag changes once the server is asked about both
+        let harness = makeHarness { _, ifNoneMatch in
+            ifNoneMatch == "v1, v2" ? "v3" : "v1"
+        }
+
+        let results = await waitForAll(harness, [(key: "a", eTag: "v1", maxAttempts: 5), (key: "b", eTag: "v2", maxAttempts: 5)])
+
+        #expect(try results["a"]?.get() == "v3")
+        #expect(try results["b"]?.get() == "v3")
+        // The second wait joins while the first poll is in flight, so it's asked about from the next poll on
+        #expect(harness.httpClient.capturedRequests.map { $0.value(forHTTPHeaderField: URLRequest.ifNoneMatchHeaderKey) } == ["v1", "v1, v2"])
+    }
+
+    @Test
+    func joiningWaitHasItsOwnAttemptBudget() async throws {
+        let harness = makeHarness { _, _ in "v1" }
+
+        let results = await waitForAll(harness, [(key: "a", eTag: "v1", maxAttempts: 2), (key: "b", eTag: "v1", maxAttempts: 2)])
+
+        for result in results.values {
+            #expect(throws: ArticleFetcherError.updatedContentRequestTimeout) {
+                try result.get()
+            }
+        }
+        // "a" is polled twice, "b" twice starting from the second poll
+        #expect(harness.httpClient.capturedRequests.count == 3)
+    }
+
+    @Test
+    func cancelledWaitIsNotCalledBack() async throws {
+        let harness = makeHarness { _, _ in "v2" }
+        let cancelledWaitWasCalledBack = CallbackFlag()
+
+        let result = await withCheckedContinuation { continuation in
+            harness.waiter.wait(for: url, eTag: "v1", maxAttempts: 5, session: harness.session, key: "a") { _ in
+                cancelledWaitWasCalledBack.set()
+            }
+            harness.waiter.wait(for: url, eTag: "v1", maxAttempts: 5, session: harness.session, key: "b") { result in
+                continuation.resume(returning: result)
+            }
+            harness.waiter.cancel(key: "a")
+        }
+
+        #expect(try result.get() == "v2")
+        #expect(!cancelledWaitWasCalledBack.isSet)
+    }
+
+    /// `currentETag` is given the index of the request and its `If-None-Match` header
+    private func makeHarness(currentETag: @escaping (Int, String?) -> String) -> (waiter: MobileHTMLChangeWaiter, session: Session, httpClient: SearchHTTPClient) {
+        let httpClient = SearchHTTPClient()
+        httpClient.responseHeaderFieldsForRequest = { [unowned httpClient] request in
+            [HTTPURLResponse.etagHeaderKey: currentETag(httpClient.capturedRequests.count - 1, request.value(forHTTPHeaderField: URLRequest.ifNoneMatchHeaderKey))]
+        }
+        let session = Session(configuration: .current, httpClientProvider: SearchHTTPClientProvider(httpClient: httpClient))
+        return (MobileHTMLChangeWaiter(), session, httpClient)
+    }
+
+    private func waitForAll(_ harness: (waiter: MobileHTMLChangeWaiter, session: Session, httpClient: SearchHTTPClient), _ waits: [(key: String, eTag: String, maxAttempts: Int)]) async -> [String: Result<String, Error>] {
+        await withCheckedContinuation { continuation in
+            let lock = NSLock()
+            var results: [String: Result<String, Error>] = [:]
+            for wait in waits {
+                harness.waiter.wait(for: url, eTag: wait.eTag, maxAttempts: wait.maxAttempts, session: harness.session, key: wait.key) { result in
+                    lock.lock()
+                    results[wait.key] = result
+                    let isDone = results.count == waits.count
+                    lock.unlock()
+                    if isDone {
+                        continuation.resume(returning: results)
+                    }
+                }
+            }
+        }
+    }
+}
+
+private final class CallbackFlag {
+    private let lock = NSLock()
+    private var value = false
+
+    var isSet: Bool {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        return value
+    }
+
+    func set() {
+        lock.lock()
+        value = true
+        lock.unlock()
+    }
+}
+
+private extension MobileHTMLChangeWaiter {
+    func wait(for url: URL, eTag: String, maxAttempts: Int, session: Session, key: String) async -> Result<String, Error> {
+        await withCheckedContinuation { continuation in
+            wait(for: url, eTag: eTag, maxAttempts: maxAttempts, session: session, key: key) { result in
+                continuation.resume(returning: result)
+            }
+        }
+    }
+}
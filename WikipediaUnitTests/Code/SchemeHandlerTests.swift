@@ -0,0 +1,175 @@
+import Foundation
+import Testing
+import WebKit
+@testable import Wikipedia
+
+@MainActor
+private final class SchemeTaskEventLog {
+    var events: [Int: [String]] = [:]
+    var onTerminalEvent: ((Int) -> Void)?
+
+    func record(_ event: String, for index: Int) {
+        events[index, default: []].append(event)
+        if event == "finish" || event == "fail" {
+            onTerminalEvent?(index)
+        }
+    }
+}
+
+@MainActor
+private final class MockURLSchemeTask: NSObject, WKURLSchemeTask {
+    let request: URLRequest
+    private let index: Int
+    private let log: SchemeTaskEventLog
+
+    init(request: URLRequest, index: Int, log: SchemeTaskEventLog) {
+        self.request = request
+        self.index = index
+        self.log = log
+    }
+
+    func didReceive(_ response: URLResponse) {
+        log.record("response", for: index)
+    }
+
+    func didReceive(_ data: Data) {
+        log.record("data", for: index)
+    }
+
+    func didFinish() {
+        log.record("finish", for: index)
+    }
+
+    func didFailWithError(_ error: Error) {
+        log.record("fail", for: index)
+    }
+}
+
+// ArticleTestHelpers keeps the data store and permanent cache in static state, so these run one at a time
+@Suite(.serialized)
+struct SchemeHandlerTests {
+
+    @MainActor
+    @Test
+    func stoppedTasksDoNotAffectRestartedTasks() async throws {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            ArticleTestHelpers.setupWithNetworkFixtures {
+                continuation.resume()
+            }
+        }
+        defer {
+            ArticleTestHelpers.tearDownNetworkFixtures()
+        }
+
+        let schemeHandler = SchemeHandler(scheme: "app", session: ArticleTestHelpers.dataStore.session)
+        let webView = WKWebView()
+        let log = SchemeTaskEventLog()
+        let url = try #require(URL(string: "app://en.wikipedia.org/api/rest_v1/page/mobile-html/Dog"))
+        let request = URLRequest(url: url)
+
+        // Each stopped task is released straight away, so its address is free to be reused by the next task that starts.
+        let stoppedTaskCount = 50
+        for index in 0..<stoppedTaskCount {
+            let task = MockURLSchemeTask(request: request, index: index, log: log)
+            schemeHandler.webView(webView, start: task)
+            schemeHandler.webView(webView, stop: task)
+        }
+
+        let restartedTaskCount = 5
+        let restartedTasks = (stoppedTaskCount..<stoppedTaskCount + restartedTaskCount).map { MockURLSchemeTask(request: request, index: $0, log: log) }
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            var remaining = Set(restartedTasks.indices.map { $0 + stoppedTaskCount })
+            log.onTerminalEvent = { index in
+                remaining.remove(index)
+                if remaining.isEmpty {
+                    log.onTerminalEvent = nil
+                    continuation.resume()
+                }
+            }
+            for task in restartedTasks {
+                schemeHandler.webView(webView, start: task)
+            }
+        }
+
+        // Give any deferred data flush from a stopped task time to run.
+        try await Task.sleep(for: .milliseconds(100))
+
+        for index in 0..<stoppedTaskCount {
+            #expect(log.events[index] == nil, "Stopped task \(index) received \(log.events[index] ?? [])")
+        }
+        for index in stoppedTaskCount..<stoppedTaskCount + restartedTaskCount {
+            let events = log.events[index] ?? []
+            #expect(events.filter { $0 == "finish" || $0 == "fail" }.count == 1, "Restarted task \(index) received \(events)")
+            #expect(events.last == "finish" || events.last == "fail")
+        }
+    }
+
+    @MainActor
+    @Test
+    func savedArticleIsServedFromPermanentCache() async throws {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            ArticleTestHelpers.setupWithNetworkFixtures {
+                continuation.resume()
+            }
+        }
+        defer {
+            ArticleTestHelpers.tearDownNetworkFixtures()
+        }
+        ArticleTestHelpers.pullDataFromFixtures(inBundle: Bundle(for: ArticleTestHelpers.self))
+        ArticleTestHelpers.writeCachedPiecesToCachingSystem()
+        let cachedHTML = try #require(ArticleTestHelpers.fixtureData?.cachedHTML)
+
+        let url = try #require(URL(string: "app://en.wikipedia.org/api/rest_v1/page/mobile-html/United_States"))
+        let (events, data) = await load(url)
+
+        #expect(events == ["response", "data", "finish"])
+        #expect(data == cachedHTML)
+    }
+
+    @MainActor
+    @Test
+    func permanentCacheMissFallsBackToNetwork() async throws {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            ArticleTestHelpers.setupWithNetworkFixtures {
+                continuation.resume()
+            }
+        }
+        defer {
+            ArticleTestHelpers.tearDownNetworkFixtures()
+        }
+        // Another article is saved, so the cache is populated but has nothing for this one
+        ArticleTestHelpers.pullDataFromFixtures(inBundle: Bundle(for: ArticleTestHelpers.self))
+        ArticleTestHelpers.writeCachedPiecesToCachingSystem()
+
+        let url = try #require(URL(string: "app://en.wikipedia.org/api/rest_v1/page/mobile-html/Dog"))
+        let networkURL = try #require(URL(string: "https://en.wikipedia.org/api/rest_v1/page/mobile-html/Dog"))
+        let networkHTML = try #require(TestNetworkFixtureHTTPClient.fixtureResponse(for: URLRequest(url: networkURL))?.body)
+        let (events, data) = await load(url)
+
+        #expect(events.last == "finish")
+        #expect(data == networkHTML)
+    }
+
+    /// Runs a single scheme task to completion, returning the events it received and the data passed to `didReceiveDataCallback`
+    @MainActor
+    private func load(_ url: URL) async -> (events: [String], data: Data) {
+        let schemeHandler = SchemeHandler(scheme: "app", session: ArticleTestHelpers.dataStore.session)
+        let webView = WKWebView()
+        let log = SchemeTaskEventLog()
+        var data = Data()
+        schemeHandler.didReceiveDataCallback = { _, receivedData in
+            data.append(receivedData)
+        }
+
+        let task = MockURLSchemeTask(request: URLRequest(url: url), index: 0, log: log)
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            log.onTerminalEvent = { _ in
+                log.onTerminalEvent = nil
+                continuation.resume()
+            }
+            schemeHandler.webView(webView, start: task)
+        }
+
+        return (log.events[0] ?? [], data)
+    }
+}
@@ -0,0 +1,76 @@
+import XCTest
+@testable import WMF
+
+class SharedContainerCacheRecencyLogTests: XCTestCase {
+
+    private var directoryURL: URL!
+    private var log: SharedContainerCacheRecencyLog!
+
+    override func setUp() {
+        super.setUp()
+        directoryURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try? FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+        log = SharedContainerCacheRecencyLog(directoryURL: directoryURL)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directoryURL)
+        super.tearDown()
+    }
+
+    private var logURL: URL {
+        return directoryURL.appendingPathComponent(SharedContainerCacheRecencyLog.fileName)
+    }
+
+    private var loggedFileNames: [String] {
+        guard let contents = try? String(contentsOf: logURL, encoding: .utf8) else {
+            return []
+        }
+        return contents.split(separator: "\n").map(String.init)
+    }
+
+    /// Writes the file and records it, as `SharedContainerCache.saveCache` does
+    private func save(_ fileName: String) {
+        try? Data(fileName.utf8).write(to: directoryURL.appendingPathComponent(fileName))
+        log.recordSave(ofFileNamed: fileName)
+    }
+
+    func testRepeatedSaveMakesFileMostRecent() {
+        for fileName in ["a", "b", "c", "a", "b"] {
+            save(fileName)
+        }
+
+        XCTAssertEqual(loggedFileNames, ["a", "b", "c", "a", "b"])
+        XCTAssertEqual(log.removeStaleFileNames(keepingMostRecent: 2), ["c"])
+        XCTAssertEqual(loggedFileNames, ["a", "b"])
+    }
+
+    func testLogIsCompactedOncePastMaxUncompactedLength() throws {
+        save("a")
+
+        // Many saves of the same two files since the last cleanup
+        let repeatedSaves = String(repeating: "b\na\n", count: SharedContainerCacheRecencyLog.maxUncompactedLength / 4 + 1)
+        try Data(repeatedSaves.utf8).write(to: logURL)
+
+        save("c")
+
+        XCTAssertEqual(loggedFileNames, ["b", "a", "c"])
+        let logLength = try XCTUnwrap(FileManager.default.attributesOfItem(atPath: logURL.path)[.size] as? Int)
+        XCTAssertLessThan(logLength, SharedContainerCacheRecencyLog.maxUncompactedLength)
+    }
+
+    func testNamesLeftByCleanupAreRestoredAsLeastRecent() {
+        for fileName in ["a", "b", "c", "d"] {
+            save(fileName)
+        }
+
+        XCTAssertEqual(log.removeStaleFileNames(keepingMostRecent: 1), ["a", "b", "c"])
+
+        // While cleanup was deleting "a", "c" was saved again, then its time budget ran out
+        save("c")
+        log.restoreStaleFileNames(["b", "c"])
+
+        XCTAssertEqual(loggedFileNames, ["b", "d", "c"])
+        XCTAssertEqual(log.removeStaleFileNames(keepingMostRecent: 2), ["b"])
+    }
+}
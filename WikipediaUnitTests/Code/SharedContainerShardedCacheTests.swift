@@ -0,0 +1,85 @@
+import XCTest
+@testable import WMF
+
+class SharedContainerShardedCacheTests: XCTestCase {
+
+    private var directoryURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        directoryURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directoryURL)
+        super.tearDown()
+    }
+
+    private var indexURL: URL {
+        return directoryURL.appendingPathComponent("index.plist")
+    }
+
+    func testValueRoundTrip() {
+        let cache = SharedContainerShardedCache(directoryURL: directoryURL)
+        cache.setValue(["a", "b"], forKey: "letters")
+        cache.setValue(42, forKey: "answer")
+
+        // A second instance stands in for another process reading the same records
+        let otherCache = SharedContainerShardedCache(directoryURL: directoryURL)
+        XCTAssertEqual(otherCache.value(forKey: "letters"), ["a", "b"])
+        XCTAssertEqual(otherCache.value(forKey: "answer"), 42)
+        XCTAssertNil(otherCache.value(forKey: "missing") as Int?)
+
+        otherCache.removeValue(forKey: "answer")
+        XCTAssertNil(cache.value(forKey: "answer") as Int?)
+        XCTAssertEqual(cache.keys, ["letters"])
+    }
+
+    func testTrimRemovesLeastRecentlyUsedFirst() {
+        let cache = SharedContainerShardedCache(directoryURL: directoryURL, maxEntryCount: 2)
+        for key in ["first", "second", "third"] {
+            cache.setValue(key, forKey: key)
+            Thread.sleep(forTimeInterval: 0.01)
+        }
+
+        XCTAssertEqual(cache.keys, ["third", "second"])
+        XCTAssertNil(cache.value(forKey: "first") as String?)
+
+        cache.trim(toCount: 1)
+        XCTAssertEqual(cache.keys, ["third"])
+        XCTAssertEqual(cache.value(forKey: "third"), "third")
+        XCTAssertNil(cache.value(forKey: "second") as String?)
+    }
+
+    func testMissingIndexIsRebuiltFromRecords() throws {
+        let cache = SharedContainerShardedCache(directoryURL: directoryURL)
+        cache.setValue("older", forKey: "older")
+        Thread.sleep(forTimeInterval: 0.01)
+        cache.setValue("newer", forKey: "newer")
+
+        try FileManager.default.removeItem(at: indexURL)
+
+        XCTAssertEqual(cache.keys, ["newer", "older"])
+        XCTAssertEqual(cache.value(forKey: "older"), "older")
+
+        // The next change writes the rebuilt index back
+        cache.setValue("another", forKey: "another")
+        XCTAssertTrue(FileManager.default.fileExists(atPath: indexURL.path))
+        XCTAssertEqual(Set(cache.keys), ["older", "newer", "another"])
+    }
+
+    func testRecentReadDoesNotRewriteIndex() throws {
+        let cache = SharedContainerShardedCache(directoryURL: directoryURL)
+        cache.setValue("value", forKey: "key")
+        let indexData = try Data(contentsOf: indexURL)
+        let modificationDate = try FileManager.default.attributesOfItem(atPath: indexURL.path)[.modificationDate] as? Date
+
+        // A fresh instance has no in-memory access dates, so it has to check the index itself
+        let otherCache = SharedContainerShardedCache(directoryURL: directoryURL)
+        XCTAssertEqual(otherCache.value(forKey: "key"), "value")
+        otherCache.removeValue(forKey: "missing")
+
+        XCTAssertEqual(try Data(contentsOf: indexURL), indexData)
+        XCTAssertEqual(try FileManager.default.attributesOfItem(atPath: indexURL.path)[.modificationDate] as? Date, modificationDate)
+    }
+}
@@ -7,9 +7,17 @@ final class SearchHTTPClient: SessionHTTPClient {
     /// Data returned to the fetcher for every supported request path.
     var responseData = Data()
 
+    /// Chooses the data for each request, for tests that make more than one
+    /// kind of request. Falls back to `responseData` when unset.
+    var responseDataForRequest: ((URLRequest) -> Data)?
+
+    /// Extra response header fields for each request, e.g. an `ETag`.
+    var responseHeaderFieldsForRequest: ((URLRequest) -> [String: String])?
+
     /// Requests issued by `WMFSearchFetcher`, used to verify the expected API
     /// query was made.
     var capturedRequests: [URLRequest] = []
+    private let capturedRequestsLock = NSLock()
     private lazy var urlSession = URLSession(configuration: SearchURLProtocol.configuration)
 
     func dataTask(with request: URLRequest, callback: Session.Callback) -> URLSessionTask {
@@ -17,9 +25,9 @@ final class SearchHTTPClient: SessionHTTPClient {
     }
 
     func dataTask(with request: URLRequest, completionHandler: @escaping (Data?, URLResponse?, Error?) -> Void) -> URLSessionDataTask {
-        capturedRequests.append(request)
+        capture(request)
 
-        let fixtureRequest = SearchURLProtocol.request(request, withResponseData: responseData)
+        let fixtureRequest = SearchURLProtocol.request(request, withResponseData: responseData(for: request), headerFields: responseHeaderFieldsForRequest?(request) ?? [:])
         return urlSession.dataTask(with: fixtureRequest, completionHandler: completionHandler)
     }
 
@@ -32,18 +40,29 @@ final class SearchHTTPClient: SessionHTTPClient {
     }
 
     func data(for request: URLRequest) async throws -> (Data, URLResponse) {
-        capturedRequests.append(request)
+        capture(request)
         guard let url = request.url,
               let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: nil, headerFields: ["Content-Type": "application/json"]) else {
             throw URLError(.badURL)
         }
 
-        return (responseData, response)
+        return (responseData(for: request), response)
     }
 
     func invalidateAndCancel() {
         urlSession.invalidateAndCancel()
     }
+
+    /// Follow-up requests can be made from URL session callbacks, off the test's thread
+    private func capture(_ request: URLRequest) {
+        capturedRequestsLock.lock()
+        capturedRequests.append(request)
+        capturedRequestsLock.unlock()
+    }
+
+    private func responseData(for request: URLRequest) -> Data {
+        responseDataForRequest?(request) ?? responseData
+    }
 }
 
 /// Supplies the same `SearchHTTPClient` instance to the legacy `Session`
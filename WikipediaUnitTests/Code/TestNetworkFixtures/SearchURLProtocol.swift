@@ -4,6 +4,7 @@ import Foundation
 /// data tasks from in-memory response data.
 final class SearchURLProtocol: URLProtocol, @unchecked Sendable {
     private static let responseDataKey = "SearchURLProtocol.responseData"
+    private static let responseHeaderFieldsKey = "SearchURLProtocol.responseHeaderFields"
 
     /// Ephemeral configuration that routes only requests tagged by
     /// `request(_:withResponseData:)` through this protocol.
@@ -14,13 +15,15 @@ final class SearchURLProtocol: URLProtocol, @unchecked Sendable {
     }
 
     /// Tags a request with response data so `canInit(with:)` accepts it and
-    /// `startLoading()` can replay the bytes back to the client.
-    static func request(_ request: URLRequest, withResponseData data: Data) -> URLRequest {
+    /// `startLoading()` can replay the bytes back to the client. Header fields
+    /// are added to the JSON content type.
+    static func request(_ request: URLRequest, withResponseData data: Data, headerFields: [String: String] = [:]) -> URLRequest {
         guard let mutableRequest = (request as NSURLRequest).mutableCopy() as? NSMutableURLRequest else {
             preconditionFailure("URLRequest should bridge to NSMutableURLRequest")
         }
 
         URLProtocol.setProperty(data, forKey: responseDataKey, in: mutableRequest)
+        URLProtocol.setProperty(headerFields, forKey: responseHeaderFieldsKey, in: mutableRequest)
         return mutableRequest as URLRequest
     }
 
@@ -33,8 +36,9 @@ final class SearchURLProtocol: URLProtocol, @unchecked Sendable {
     }
 
     override func startLoading() {
+        let headerFields = URLProtocol.property(forKey: Self.responseHeaderFieldsKey, in: request) as? [String: String] ?? [:]
         guard let url = request.url,
-              let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: nil, headerFields: ["Content-Type": "application/json"]) else {
+              let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: nil, headerFields: headerFields.merging(["Content-Type": "application/json"]) { (field, _) in field }) else {
             client?.urlProtocol(self, didFailWithError: URLError(.badURL))
             return
         }
@@ -41,6 +41,51 @@ struct WMFSearchFetcherTests {
         #expect(harness.httpClient.capturedRequests.containsPrefixSearchRequest)
     }
 
+    @Test
+    func decodedResultsMatchMantle() throws {
+        let json = try jsonFixture(named: "BarackSearch")
+        let data = try JSONSerialization.data(withJSONObject: json)
+        let query = try #require(json["query"] as? [String: Any])
+
+        let decoded = try JSONDecoder().decode(MediaWikiSearchResponse.self, from: data).searchResults(searchTerm: "foo", languageVariantCode: nil)
+        let mapped = try #require(try MTLJSONAdapter.model(of: WMFSearchResults.self, fromJSONDictionary: query) as? WMFSearchResults)
+
+        let decodedResults = decoded.results ?? []
+        let mappedResults = mapped.results ?? []
+        #expect(!decodedResults.isEmpty)
+        #expect(decodedResults.map { $0.title } == mappedResults.map { $0.title })
+        #expect(decodedResults.map { $0.displayTitleHTML } == mappedResults.map { $0.displayTitleHTML })
+        #expect(decodedResults.map { $0.articleID } == mappedResults.map { $0.articleID })
+        #expect(decodedResults.map { $0.thumbnailURL } == mappedResults.map { $0.thumbnailURL })
+        #expect(decodedResults.map { $0.wikidataDescription } == mappedResults.map { $0.wikidataDescription })
+        #expect(decoded.redirectMappings == mapped.redirectMappings)
+        #expect(decoded.searchSuggestion == mapped.searchSuggestion)
+    }
+
+    @Test
+    func decodedCoordinatesAndExtractsMatchMantle() throws {
+        let json = try jsonFixture(named: "PlacesSearch")
+        let data = try JSONSerialization.data(withJSONObject: json)
+        let query = try #require(json["query"] as? [String: Any])
+
+        let decoded = try JSONDecoder().decode(MediaWikiSearchResponse.self, from: data).searchResults(searchTerm: "cambridge", languageVariantCode: nil)
+        let mapped = try #require(try MTLJSONAdapter.model(of: WMFSearchResults.self, fromJSONDictionary: query) as? WMFSearchResults)
+
+        let decodedResults = decoded.results ?? []
+        let mappedResults = mapped.results ?? []
+        #expect(decodedResults.count == 7)
+        #expect(decodedResults.map { $0.title } == mappedResults.map { $0.title })
+        #expect(decodedResults.map { $0.extract } == mappedResults.map { $0.extract })
+        #expect(decodedResults.map { $0.geoType } == mappedResults.map { $0.geoType })
+        #expect(decodedResults.map { $0.geoDimension } == mappedResults.map { $0.geoDimension })
+        #expect(decodedResults.map { $0.location?.coordinate.latitude } == mappedResults.map { $0.location?.coordinate.latitude })
+
+        // Fractional dimensions are truncated, as Mantle always has
+        let meadows = try #require(decodedResults.first { $0.title == "Grantchester Meadows" })
+        #expect(meadows.geoDimension == 1000)
+        #expect(meadows.extract == nil)
+    }
+
     private func makeHarness() -> (fetcher: WMFSearchFetcher, httpClient: SearchHTTPClient) {
         let httpClient = SearchHTTPClient()
         let session = Session(configuration: .current, httpClientProvider: SearchHTTPClientProvider(httpClient: httpClient))
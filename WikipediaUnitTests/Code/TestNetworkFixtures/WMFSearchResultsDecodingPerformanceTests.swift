@@ -0,0 +1,46 @@
+import XCTest
+@testable import Wikipedia
+@testable import WMF
+
+/// Compares decoding a large page of results directly with parsing it into dictionaries and mapping it with Mantle, as the fetcher used to
+final class WMFSearchResultsDecodingPerformanceTests: XCTestCase {
+
+    /// The fixture's pages repeated to 500, far more than a search returns, so per page costs dominate
+    private func largeResponseData() throws -> Data {
+        let data = try XCTUnwrap(Bundle(for: WMFSearchResultsDecodingPerformanceTests.self).wmf_data(fromContentsOfFile: "BarackSearch", ofType: "json"))
+        var json = try XCTUnwrap(try JSONSerialization.jsonObject(with: data) as? [String: Any])
+        var query = try XCTUnwrap(json["query"] as? [String: Any])
+        let pages = try XCTUnwrap((query["pages"] as? [String: [String: Any]])?.values.map { $0 })
+
+        var largePages: [String: Any] = [:]
+        for index in 0..<500 {
+            var page = pages[index % pages.count]
+            page["pageid"] = index
+            page["index"] = index
+            largePages[String(index)] = page
+        }
+        query["pages"] = largePages
+        json["query"] = query
+        return try JSONSerialization.data(withJSONObject: json)
+    }
+
+    func testDecodingPerformance() throws {
+        let data = try largeResponseData()
+
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            let response = try? JSONDecoder().decode(MediaWikiSearchResponse.self, from: data)
+            XCTAssertEqual(response?.searchResults(searchTerm: "foo", languageVariantCode: nil).results?.count, 500)
+        }
+    }
+
+    func testMantlePerformance() throws {
+        let data = try largeResponseData()
+
+        measure(metrics: [XCTMemoryMetric(), XCTClockMetric()]) {
+            let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any]
+            let query = json?["query"] as? [String: Any] ?? [:]
+            let results = try? MTLJSONAdapter.model(of: WMFSearchResults.self, fromJSONDictionary: query) as? WMFSearchResults
+            XCTAssertEqual(results?.results?.count, 500)
+        }
+    }
+}
@@ -152,4 +152,41 @@ class WMFArticleTests: XCTestCase {
         noVariantValue = articleCache.object(forKey:noVariantKey)
         XCTAssertEqual(noVariantValue, noVariantString)
     }
+
+    func testFetchOrCreateArticlesWithFeedPreviewsReusesExistingArticlesAndMergesPageViews() throws {
+        let dogURL = try XCTUnwrap(URL(string: "https://en.wikipedia.org/wiki/Dog"))
+        let catURL = try XCTUnwrap(URL(string: "https://en.wikipedia.org/wiki/Cat"))
+        let dogKey = try XCTUnwrap(dogURL.wmf_inMemoryKey)
+        let catKey = try XCTUnwrap(catURL.wmf_inMemoryKey)
+        let yesterday = Date(timeIntervalSince1970: 1_700_000_000)
+        let today = yesterday.addingTimeInterval(86_400)
+
+        let existingDog = try XCTUnwrap(moc.createArticle(withKey: dogKey.databaseKey, variant: nil))
+        existingDog.pageViews = [yesterday: NSNumber(value: 10)]
+        // Same key, different variant, so it shouldn't be picked up for the Dog preview
+        let dogVariant = try XCTUnwrap(moc.createArticle(withKey: dogKey.databaseKey, variant: "en-x-variant"))
+
+        // Dog is in two sections of the day, e.g. top read and the featured article
+        let previews = [feedPreview(articleURL: dogURL, snippet: "Dog"), feedPreview(articleURL: catURL, snippet: "Cat"), feedPreview(articleURL: dogURL, snippet: "Dog again")]
+        let pageViews = [dogURL: [today: NSNumber(value: 20)], catURL: [today: NSNumber(value: 5)]]
+
+        let articles = moc.fetchOrCreateArticles(withFeedPreviews: previews, pageViews: pageViews, featuredPreview: nil)
+
+        XCTAssertEqual(Set(articles.keys), [dogKey, catKey])
+        XCTAssert(articles[dogKey] === existingDog, "The existing article should be updated rather than a new one created")
+        XCTAssertEqual(try moc.fetchArticles(withKey: dogKey.databaseKey, variant: nil).count, 1)
+        XCTAssertEqual(try moc.fetchArticles(withKey: catKey.databaseKey, variant: nil).count, 1)
+        XCTAssertEqual(existingDog.snippet, "Dog again", "Previews should be applied in order")
+        XCTAssertEqual(existingDog.pageViews as? [Date: NSNumber], [yesterday: NSNumber(value: 10), today: NSNumber(value: 20)])
+        XCTAssertEqual(articles[catKey]?.pageViews as? [Date: NSNumber], [today: NSNumber(value: 5)])
+        XCTAssertNil(dogVariant.snippet)
+        XCTAssertNil(dogVariant.pageViews)
+    }
+
+    private func feedPreview(articleURL: URL, snippet: String) -> WMFFeedArticlePreview {
+        let preview = WMFFeedArticlePreview()
+        preview.articleURL = articleURL
+        preview.snippet = snippet
+        return preview
+    }
 }
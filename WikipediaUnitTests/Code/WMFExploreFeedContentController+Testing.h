@@ -0,0 +1,13 @@
+#import "WMFExploreFeedContentController.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface WMFExploreFeedContentController (Testing)
+
+- (void)applyExploreFeedPreferencesToAllObjectsInManagedObjectContext:(NSManagedObjectContext *)moc;
+
+- (void)applyExploreFeedPreferencesIncrementallyInManagedObjectContext:(NSManagedObjectContext *)moc;
+
+@end
+
+NS_ASSUME_NONNULL_END
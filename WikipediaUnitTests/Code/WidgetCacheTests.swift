@@ -0,0 +1,47 @@
+import XCTest
+@testable import WMF
+
+class WidgetCacheTests: XCTestCase {
+
+	private let legacyCache = SharedContainerCache(fileName: SharedContainerCacheCommonNames.widgetCache)
+	private let shardedCache = SharedContainerShardedCache(name: SharedContainerCacheCommonNames.widgetCache)
+
+	private let legacySettings = WidgetSettings(siteURL: URL(string: "https://de.wikipedia.org")!, languageCode: "de", languageVariantCode: nil, preferredLanguageCodes: ["de"])
+	private let savedSettings = WidgetSettings(siteURL: URL(string: "https://fr.wikipedia.org")!, languageCode: "fr", languageVariantCode: nil, preferredLanguageCodes: ["fr", "de"])
+
+	override func setUp() {
+		super.setUp()
+		shardedCache.removeAll()
+		try? legacyCache.removeCache()
+	}
+
+	override func tearDown() {
+		shardedCache.removeAll()
+		try? legacyCache.removeCache()
+		super.tearDown()
+	}
+
+	func testSaveWithLegacyCachePresentIsNotOverwrittenByMigration() throws {
+		let featuredContent = try XCTUnwrap(WidgetFeaturedContent.previewContent())
+		legacyCache.saveCache(WidgetCache(settings: legacySettings, featuredContent: featuredContent))
+
+		WidgetCache.saveSettings(savedSettings)
+		let cache = WidgetCache.load()
+
+		XCTAssertEqual(cache.settings.siteURL, savedSettings.siteURL)
+		XCTAssertEqual(cache.settings.preferredLanguageCodes, savedSettings.preferredLanguageCodes)
+		XCTAssertEqual(cache.featuredContent?.featuredArticle?.displayTitle, featuredContent.featuredArticle?.displayTitle, "Featured content only in the legacy cache should be migrated")
+		XCTAssertNil(legacyCache.loadCache() as WidgetCache?, "The legacy cache should be removed once migrated")
+	}
+
+	func testMigrationKeepsExistingRecords() {
+		// Saved by this version before a legacy file turned up, e.g. from an extension that hadn't updated yet
+		shardedCache.setValue(savedSettings, forKey: "settings")
+		legacyCache.saveCache(WidgetCache(settings: legacySettings, featuredContent: nil))
+
+		let settings = WidgetCache.loadSettings()
+
+		XCTAssertEqual(settings.siteURL, savedSettings.siteURL)
+		XCTAssertNil(legacyCache.loadCache() as WidgetCache?)
+	}
+}
@@ -1,6 +1,7 @@
 #import "WMFAsyncTestCase.h"
 #import "WMFTestFixtureUtilities.h"
 #import "MWKDataStore+TemporaryDataStore.h"
+#import "WMFExploreFeedContentController+Testing.h"
 #import "WMFRandomFileUtilities.h"
 #import "WMFHTTPHangingProtocol.h"
 #import "UIViewController+WMFStoryboardUtilities.h"